@@ -8,6 +8,18 @@
  *   /proc/Lian_li_SL_INFINITY/Port_X/fan_speed      (write 0–100, read current setting)
  *   /proc/Lian_li_SL_INFINITY/Port_X/fan_connected  (read 0/1 - is fan configured)
  *   /proc/Lian_li_SL_INFINITY/Port_X/fan_config     (write 0/1 - configure fan presence)
+ *   /proc/Lian_li_SL_INFINITY/fan_speeds            (write "p1 p2 p3 p4" 0-100, read all four)
+ *
+ * The same controls are registered as a hwmon chip named "sl_infinity":
+ *   /sys/class/hwmon/hwmonN/pwmX         (0-255, scaled to the hub's 0-100%)
+ *   /sys/class/hwmon/hwmonN/pwmX_enable  (1 = manual, 0 = full speed)
+ * There are no fanX_input attributes: the hub accepts duty commands but
+ * this driver has no tach report to read RPM back from.
+ *
+ * Speed writes only record the requested duty and return; a per-hub work
+ * item sends the latest requested value for each port to the hub, so
+ * writers never wait on USB and bursts of writes collapse into one
+ * transfer per port.
  *
  * Author: AI + Joey
  */
@@ -15,9 +27,12 @@
 #include <linux/module.h>
 #include <linux/kernel.h>
 #include <linux/hid.h>
+#include <linux/hwmon.h>
 #include <linux/proc_fs.h>
 #include <linux/uaccess.h>
 #include <linux/slab.h>
+#include <linux/mutex.h>
+#include <linux/workqueue.h>
 
 #define VENDOR_ID  0x0CF2
 #define PRODUCT_ID 0xA102
@@ -25,14 +40,21 @@
 struct sli_port {
 	int index;  /* 0..3 */
 	struct sli_hub *hub;
-	u8 fan_speed;  /* Current fan speed (0-100) */
+	u8 fan_speed;  /* Current fan speed (0-100) as last sent to the hub */
+	bool fan_speed_valid;  /* fan_speed has been sent to the hub at least once */
+	u8 target_speed;  /* Latest requested speed, protected by hub->lock */
+	bool target_pending;  /* target_speed not yet handled by speed_work */
+	bool manual;  /* hwmon pwmX_enable: true = manual, false = full speed */
 	bool fan_connected;  /* Is a fan connected to this port? (user configured) */
 };
 
 struct sli_hub {
 	struct hid_device *hdev;
 	struct proc_dir_entry *procdir;
+	struct device *hwmon_dev;
 	struct sli_port ports[4];  /* 4 ports */
+	struct mutex lock;  /* Protects target_speed/target_pending */
+	struct work_struct speed_work;  /* Sends pending speeds to the hub */
 };
 
 static struct sli_hub *g_hub = NULL;
@@ -82,6 +104,7 @@ static int sli_set_fan_speed(struct sli_port *p, u8 speed_percent)
 	/* hid_hw_raw_request returns number of bytes transferred on success (7), not 0 */
 	if (rc >= 0) {
 		p->fan_speed = speed_percent;
+		p->fan_speed_valid = true;
 		SLI_LOG("Port %d set to %d%%\n", port_num, speed_percent);
 		return 0;  /* Return 0 for success */
 	} else {
@@ -90,6 +113,50 @@ static int sli_set_fan_speed(struct sli_port *p, u8 speed_percent)
 	}
 }
 
+/* Deferred transmission: send the latest requested speed of every port */
+static void sli_speed_work(struct work_struct *work)
+{
+	struct sli_hub *hub = container_of(work, struct sli_hub, speed_work);
+	bool pending[4];
+	u8 speeds[4];
+	int i;
+
+	mutex_lock(&hub->lock);
+	for (i = 0; i < 4; i++) {
+		pending[i] = hub->ports[i].target_pending;
+		speeds[i] = hub->ports[i].target_speed;
+		hub->ports[i].target_pending = false;
+	}
+	mutex_unlock(&hub->lock);
+
+	for (i = 0; i < 4; i++) {
+		struct sli_port *p = &hub->ports[i];
+
+		if (!pending[i])
+			continue;
+		/* Skip ports whose duty is unchanged since the last transfer */
+		if (p->fan_speed_valid && p->fan_speed == speeds[i])
+			continue;
+
+		sli_set_fan_speed(p, speeds[i]);
+	}
+}
+
+/*
+ * Record a requested speed; the caller schedules speed_work. An explicit
+ * duty puts the port under manual control, the full-speed fallback of
+ * pwmN_enable=0 does not.
+ */
+static void sli_queue_fan_speed(struct sli_port *p, u8 speed_percent, bool manual)
+{
+	mutex_lock(&p->hub->lock);
+	p->target_speed = speed_percent;
+	p->target_pending = true;
+	if (manual)
+		p->manual = true;
+	mutex_unlock(&p->hub->lock);
+}
+
 /* Read handler for fan speed */
 static ssize_t sli_read_fan_speed(struct file *file, char __user *ubuf,
 								  size_t count, loff_t *ppos)
@@ -101,7 +168,7 @@ static ssize_t sli_read_fan_speed(struct file *file, char __user *ubuf,
 	if (*ppos > 0)
 		return 0;
 
-	len = snprintf(buf, sizeof(buf), "%d\n", p->fan_speed);
+	len = snprintf(buf, sizeof(buf), "%d\n", p->target_speed);
 	if (len > count)
 		len = count;
 
@@ -119,7 +186,6 @@ static ssize_t sli_write_fan_speed(struct file *file, const char __user *ubuf,
 	struct sli_port *p = pde_data(file_inode(file));
 	char buf[16];
 	int speed_percent;
-	int rc;
 
 	if (count >= sizeof(buf))
 		return -EINVAL;
@@ -133,9 +199,8 @@ static ssize_t sli_write_fan_speed(struct file *file, const char __user *ubuf,
 	if (speed_percent < 0 || speed_percent > 100)
 		return -EINVAL;
 
-	rc = sli_set_fan_speed(p, speed_percent);
-	if (rc < 0)
-		return rc;
+	sli_queue_fan_speed(p, speed_percent, true);
+	schedule_work(&p->hub->speed_work);
 
 	return count;
 }
@@ -145,6 +210,78 @@ static const struct proc_ops sli_fan_speed_ops = {
 	.proc_write = sli_write_fan_speed,
 };
 
+/* Read handler for all fan speeds */
+static ssize_t sli_read_fan_speeds(struct file *file, char __user *ubuf,
+								   size_t count, loff_t *ppos)
+{
+	struct sli_hub *hub = pde_data(file_inode(file));
+	char buf[32];
+	int len;
+
+	if (*ppos > 0)
+		return 0;
+
+	len = snprintf(buf, sizeof(buf), "%d %d %d %d\n",
+		       hub->ports[0].target_speed, hub->ports[1].target_speed,
+		       hub->ports[2].target_speed, hub->ports[3].target_speed);
+	if (len > count)
+		len = count;
+
+	if (copy_to_user(ubuf, buf, len))
+		return -EFAULT;
+
+	*ppos += len;
+	return len;
+}
+
+/*
+ * Write handler for all fan speeds: "p1 p2 p3 p4" (0-100 each).
+ * Ports whose duty is unchanged since the last successful transfer are
+ * skipped by speed_work, so a control loop can write every tick without
+ * USB traffic.
+ */
+static ssize_t sli_write_fan_speeds(struct file *file, const char __user *ubuf,
+									size_t count, loff_t *ppos)
+{
+	struct sli_hub *hub = pde_data(file_inode(file));
+	char buf[32];
+	int speeds[4];
+	int i;
+
+	if (count >= sizeof(buf))
+		return -EINVAL;
+	if (copy_from_user(buf, ubuf, count))
+		return -EFAULT;
+	buf[count] = '\0';
+
+	if (sscanf(buf, "%d %d %d %d", &speeds[0], &speeds[1], &speeds[2], &speeds[3]) != 4)
+		return -EINVAL;
+
+	for (i = 0; i < 4; i++) {
+		if (speeds[i] < 0 || speeds[i] > 100)
+			return -EINVAL;
+	}
+
+	/* Only a port that gets a new duty switches to manual control */
+	mutex_lock(&hub->lock);
+	for (i = 0; i < 4; i++) {
+		if (hub->ports[i].target_speed != speeds[i])
+			hub->ports[i].manual = true;
+		hub->ports[i].target_speed = speeds[i];
+		hub->ports[i].target_pending = true;
+	}
+	mutex_unlock(&hub->lock);
+
+	schedule_work(&hub->speed_work);
+
+	return count;
+}
+
+static const struct proc_ops sli_fan_speeds_ops = {
+	.proc_read = sli_read_fan_speeds,
+	.proc_write = sli_write_fan_speeds,
+};
+
 /* Read handler for fan connection status */
 static ssize_t sli_read_fan_connected(struct file *file, char __user *ubuf,
 									  size_t count, loff_t *ppos)
@@ -271,6 +408,99 @@ static const struct proc_ops sli_logging_enabled_ops = {
 	.proc_write = sli_write_logging_enabled,
 };
 
+/* hwmon interface */
+static umode_t sli_hwmon_is_visible(const void *data, enum hwmon_sensor_types type,
+									u32 attr, int channel)
+{
+	if (type != hwmon_pwm)
+		return 0;
+
+	switch (attr) {
+	case hwmon_pwm_input:
+	case hwmon_pwm_enable:
+		return 0644;
+	default:
+		return 0;
+	}
+}
+
+static int sli_hwmon_read(struct device *dev, enum hwmon_sensor_types type,
+						  u32 attr, int channel, long *val)
+{
+	struct sli_hub *hub = dev_get_drvdata(dev);
+	struct sli_port *p = &hub->ports[channel];
+
+	if (type != hwmon_pwm)
+		return -EOPNOTSUPP;
+
+	switch (attr) {
+	case hwmon_pwm_input:
+		mutex_lock(&hub->lock);
+		*val = DIV_ROUND_CLOSEST(p->target_speed * 255, 100);
+		mutex_unlock(&hub->lock);
+		return 0;
+	case hwmon_pwm_enable:
+		*val = p->manual ? 1 : 0;
+		return 0;
+	default:
+		return -EOPNOTSUPP;
+	}
+}
+
+static int sli_hwmon_write(struct device *dev, enum hwmon_sensor_types type,
+						   u32 attr, int channel, long val)
+{
+	struct sli_hub *hub = dev_get_drvdata(dev);
+	struct sli_port *p = &hub->ports[channel];
+
+	if (type != hwmon_pwm)
+		return -EOPNOTSUPP;
+
+	switch (attr) {
+	case hwmon_pwm_input:
+		if (val < 0 || val > 255)
+			return -EINVAL;
+		if (!p->manual)
+			return -EBUSY;
+		sli_queue_fan_speed(p, DIV_ROUND_CLOSEST(val * 100, 255), true);
+		schedule_work(&hub->speed_work);
+		return 0;
+	case hwmon_pwm_enable:
+		if (val != 0 && val != 1)
+			return -EINVAL;
+		mutex_lock(&hub->lock);
+		p->manual = (val == 1);
+		mutex_unlock(&hub->lock);
+		if (!p->manual) {
+			sli_queue_fan_speed(p, 100, false);
+			schedule_work(&hub->speed_work);
+		}
+		return 0;
+	default:
+		return -EOPNOTSUPP;
+	}
+}
+
+static const struct hwmon_ops sli_hwmon_ops = {
+	.is_visible = sli_hwmon_is_visible,
+	.read = sli_hwmon_read,
+	.write = sli_hwmon_write,
+};
+
+static const struct hwmon_channel_info *const sli_hwmon_info[] = {
+	HWMON_CHANNEL_INFO(pwm,
+			   HWMON_PWM_INPUT | HWMON_PWM_ENABLE,
+			   HWMON_PWM_INPUT | HWMON_PWM_ENABLE,
+			   HWMON_PWM_INPUT | HWMON_PWM_ENABLE,
+			   HWMON_PWM_INPUT | HWMON_PWM_ENABLE),
+	NULL
+};
+
+static const struct hwmon_chip_info sli_hwmon_chip_info = {
+	.ops = &sli_hwmon_ops,
+	.info = sli_hwmon_info,
+};
+
 /* Probe function */
 static int sli_probe(struct hid_device *hdev, const struct hid_device_id *id)
 {
@@ -307,6 +537,8 @@ static int sli_probe(struct hid_device *hdev, const struct hid_device_id *id)
 	}
 
 	hub->hdev = hdev;
+	mutex_init(&hub->lock);
+	INIT_WORK(&hub->speed_work, sli_speed_work);
 	hid_set_drvdata(hdev, hub);
 
 	/* Initialize ports */
@@ -314,6 +546,10 @@ static int sli_probe(struct hid_device *hdev, const struct hid_device_id *id)
 		hub->ports[i].index = i;
 		hub->ports[i].hub = hub;
 		hub->ports[i].fan_speed = 0;
+		hub->ports[i].fan_speed_valid = false;
+		hub->ports[i].target_speed = 0;
+		hub->ports[i].target_pending = false;
+		hub->ports[i].manual = true;  /* Userspace sets the duty */
 		hub->ports[i].fan_connected = true;  /* Default to connected */
 	}
 
@@ -330,6 +566,9 @@ static int sli_probe(struct hid_device *hdev, const struct hid_device_id *id)
 	/* Global logging control */
 	proc_create("logging_enabled", 0666, hub->procdir, &sli_logging_enabled_ops);
 
+	/* All four fan speeds in a single write */
+	proc_create_data("fan_speeds", 0666, hub->procdir, &sli_fan_speeds_ops, hub);
+
 	/* Create proc files for each port */
 	for (i = 0; i < 4; i++) {
 		char port_name[16];
@@ -353,6 +592,14 @@ static int sli_probe(struct hid_device *hdev, const struct hid_device_id *id)
 		proc_create_data("fan_config", 0666, port_dir, &sli_fan_config_ops, p);
 	}
 
+	/* Standard hwmon interface; the proc tree keeps working without it */
+	hub->hwmon_dev = hwmon_device_register_with_info(&hdev->dev, "sl_infinity",
+							 hub, &sli_hwmon_chip_info, NULL);
+	if (IS_ERR(hub->hwmon_dev)) {
+		pr_err("SLI: Failed to register hwmon device: %ld\n", PTR_ERR(hub->hwmon_dev));
+		hub->hwmon_dev = NULL;
+	}
+
 	g_hub = hub;
 	SLI_LOG("HID device initialized\n");
 
@@ -367,9 +614,17 @@ static void sli_remove(struct hid_device *hdev)
 	SLI_LOG("Removing device\n");
 
 	if (hub) {
+		/*
+		 * No new writes after this; then drop a transfer that has not
+		 * started (the hub is going away) and wait for a running one
+		 */
+		if (hub->hwmon_dev) {
+			hwmon_device_unregister(hub->hwmon_dev);
+		}
 		if (hub->procdir) {
 			proc_remove(hub->procdir);
 		}
+		cancel_work_sync(&hub->speed_work);
 		g_hub = NULL;
 		kfree(hub);
 	}
@@ -0,0 +1,54 @@
+#include "dutyoutputstage.h"
+
+DutyOutputStage::DutyOutputStage()
+    : m_committed(-1)
+    , m_pending(-1)
+    , m_sinceCommit(0.0)
+    , m_sent(0)
+    , m_suppressed(0)
+{
+}
+
+bool DutyOutputStage::offer(int duty, double dt, bool requested)
+{
+    m_sinceCommit += dt;
+
+    bool send;
+    if (m_committed < 0) {
+        send = true;
+    } else if (duty > m_committed) {
+        send = true;
+    } else if (duty < m_committed) {
+        send = m_committed - duty >= m_parameters.hysteresis && m_sinceCommit >= m_parameters.minDwell;
+    } else {
+        send = false;
+    }
+
+    if (!send) {
+        if (requested) {
+            ++m_suppressed;
+        }
+        m_pending = m_committed;
+        return false;
+    }
+
+    m_pending = duty;
+    return true;
+}
+
+void DutyOutputStage::commit()
+{
+    if (m_pending == m_committed) {
+        return;
+    }
+    m_committed = m_pending;
+    m_sinceCommit = 0.0;
+    ++m_sent;
+}
+
+void DutyOutputStage::reset()
+{
+    m_committed = -1;
+    m_pending = -1;
+    m_sinceCommit = 0.0;
+}
@@ -0,0 +1,63 @@
+#ifndef DUTYOUTPUTSTAGE_H
+#define DUTYOUTPUTSTAGE_H
+
+#include <QtGlobal>
+
+// Last stage before the driver for one port. The hub only knows whole duty
+// percent (RPM / 21), so most RPM changes the loop asks for don't change
+// what the fan does; this decides which requests are worth a procfs write
+// or USB transfer:
+//
+//   - nothing is sent unless the duty byte changes
+//   - rises go out at once, so cooling is never delayed
+//   - falls have to be at least `hysteresis` percent and come no sooner
+//     than `minDwell` seconds after the previous command, so a fan
+//     hovering at a curve boundary doesn't step down and back up
+//
+// A duty offer() lets through is only pending until the caller reports a
+// successful write with commit(); until then the last committed duty stays
+// the reference, so a failed write is offered again on the next tick.
+//
+// Time is the sum of the dt handed to offer(), so it runs the same on the
+// live loop and in the simulator.
+class DutyOutputStage
+{
+public:
+    struct Parameters
+    {
+        int hysteresis = 2;       // smallest fall that is sent (percent)
+        double minDwell = 2.0;    // s after any command before a fall is sent
+    };
+
+    DutyOutputStage();
+
+    void setParameters(const Parameters &parameters) { m_parameters = parameters; }
+    const Parameters &parameters() const { return m_parameters; }
+
+    // Called every tick with the duty the port should run at; `requested`
+    // is whether the loop would have written before this stage existed and
+    // only feeds the counters. Returns true if the duty must be sent now;
+    // it becomes pending().
+    bool offer(int duty, double dt, bool requested);
+    // The pending duty reached the driver
+    void commit();
+
+    // Forces the next offer() out, e.g. after the driver lost its state
+    void reset();
+
+    int committed() const { return m_committed; }
+    // Duty to write: the one the last offer() let through, else committed()
+    int pending() const { return m_pending; }
+    quint64 sent() const { return m_sent; }
+    quint64 suppressed() const { return m_suppressed; }
+
+private:
+    Parameters m_parameters;
+    int m_committed;        // duty last sent; -1 before the first command
+    int m_pending;          // duty waiting for commit(), else m_committed
+    double m_sinceCommit;   // s since that command
+    quint64 m_sent;
+    quint64 m_suppressed;
+};
+
+#endif // DUTYOUTPUTSTAGE_H
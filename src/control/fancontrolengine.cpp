@@ -0,0 +1,379 @@
+#include "fancontrolengine.h"
+#include "usb/kernel_port_interface.h"
+#include "sensors/sensorservice.h"
+#include "sensors/hwmonsensors.h"
+#include "utils/qtdebugutil.h"
+#include "utils/trace.h"
+#include <QTimer>
+#include <QSettings>
+#include <QDebug>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+FanControlEngine::FanControlEngine(QObject *parent, int historyCapacity)
+    : QObject(parent)
+    , m_tickTimer(nullptr)
+    , m_temperatureTimer(nullptr)
+    , m_portTimer(nullptr)
+    , m_publishTimer(nullptr)
+    , m_tickInterval(kDefaultTickInterval)
+    , m_publishInterval(0)
+    , m_temperature(39)
+    , m_simulationCounter(0)
+    , m_simulated(false)
+    , m_connected(4, false)
+    , m_ring(historyCapacity)
+    , m_publishedOnce(false)
+    , m_sensorService(nullptr)
+{
+    m_sensorText.fill("cpu");
+    m_values[SensorValues::Cpu] = m_temperature;
+}
+
+FanControlEngine::~FanControlEngine()
+{
+    stop();
+}
+
+void FanControlEngine::start()
+{
+    if (m_tickTimer) {
+        return;
+    }
+
+    Trace::setThreadName("fan-control");
+    loadCurves();
+    m_clock.start();
+
+    m_tickTimer = new QTimer(this);
+    m_tickTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_tickTimer, &QTimer::timeout, this, &FanControlEngine::tick);
+
+    m_temperatureTimer = new QTimer(this);
+    connect(m_temperatureTimer, &QTimer::timeout, this, &FanControlEngine::sampleTemperature);
+
+    m_portTimer = new QTimer(this);
+    connect(m_portTimer, &QTimer::timeout, this, &FanControlEngine::samplePorts);
+
+    m_publishTimer = new QTimer(this);
+    connect(m_publishTimer, &QTimer::timeout, this, &FanControlEngine::publish);
+
+    // Prime sensor state so the first tick acts on real data
+    sampleTemperature();
+    samplePorts();
+    tick();
+
+    m_tickTimer->start(m_tickInterval);
+    m_temperatureTimer->start(kTemperatureInterval);
+    m_portTimer->start(kPortStatusInterval);
+    if (m_publishInterval > 0) {
+        m_publishTimer->start(m_publishInterval);
+    }
+
+    qDebug() << "Fan control engine started, tick interval" << m_tickInterval << "ms";
+}
+
+void FanControlEngine::stop()
+{
+    if (!m_tickTimer) {
+        return;
+    }
+
+    m_tickTimer->stop();
+    m_temperatureTimer->stop();
+    m_portTimer->stop();
+    m_publishTimer->stop();
+}
+
+void FanControlEngine::setTickInterval(int ms)
+{
+    m_tickInterval = qMax(10, ms);
+    if (m_tickTimer && m_tickTimer->isActive()) {
+        m_tickTimer->start(m_tickInterval);
+    }
+}
+
+void FanControlEngine::setPublishInterval(int ms)
+{
+    m_publishInterval = qMax(0, ms);
+    if (!m_publishTimer) {
+        return;
+    }
+
+    if (m_publishInterval == 0) {
+        m_publishTimer->stop();
+        return;
+    }
+
+    // Push current state right away so a re-shown page is never stale
+    m_publishedOnce = false;
+    publish();
+    m_publishTimer->start(m_publishInterval);
+}
+
+void FanControlEngine::setPortCurve(int port, const FanCurve &curve)
+{
+    if (port < 1 || port > 4 || !curve.isValid()) {
+        return;
+    }
+    m_loop.setCurve(port, curve);
+    DEBUG_LOG_CATEGORY("FanSpeeds", "Fan control engine: new curve for Port", port, "with", curve.points().size(), "points");
+}
+
+void FanControlEngine::setPortStrategy(int port, FanControlStrategy::Kind kind)
+{
+    if (port < 1 || port > 4 || m_loop.strategy(port) == kind) {
+        return;
+    }
+    m_loop.setStrategy(port, kind);
+    DEBUG_LOG_CATEGORY("FanSpeeds", "Fan control engine: Port", port, "now uses the", FanControlStrategy::kindName(kind), "strategy");
+}
+
+void FanControlEngine::setPortSensor(int port, const QString &expression)
+{
+    if (port < 1 || port > 4) {
+        return;
+    }
+
+    // Recompile every port so the channel slots stay dense
+    std::array<QString, 4> texts = m_sensorText;
+    texts[port - 1] = expression.trimmed().isEmpty() ? QString("cpu") : expression.trimmed();
+
+    QStringList channels;
+    std::array<SensorExpression, 4> compiled;
+    for (int i = 0; i < 4; ++i) {
+        QString error;
+        compiled[i] = SensorExpression::compile(texts[i], &channels, &error);
+        if (!compiled[i].isValid()) {
+            qWarning() << "Fan control engine: bad sensor expression for Port" << i + 1 << ":" << texts[i] << "-" << error;
+            return;
+        }
+    }
+
+    m_sensorText = texts;
+    for (int i = 0; i < 4; ++i) {
+        m_loop.setSensor(i + 1, compiled[i]);
+    }
+
+    if (channels != m_channelNames) {
+        m_channelNames = channels;
+        m_channels.clear();
+        for (const QString &name : channels) {
+            int slash = name.indexOf('/');
+            m_channels.push_back(std::make_unique<HwmonChannel>(name.left(slash), name.mid(slash + 1)));
+        }
+        for (int i = 0; i < SensorValues::kMaxChannels; ++i) {
+            m_values[SensorValues::FirstChannel + i] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    DEBUG_LOG_CATEGORY("FanSpeeds", "Fan control engine: Port", port, "follows", texts[port - 1]);
+}
+
+void FanControlEngine::setOutputParameters(const DutyOutputStage::Parameters &parameters)
+{
+    DutyOutputStage::Parameters output;
+    output.hysteresis = qBound(0, parameters.hysteresis, 20);
+    output.minDwell = qBound(0.0, parameters.minDwell, 30.0);
+    m_loop.setOutputParameters(output);
+    DEBUG_LOG_CATEGORY("FanSpeeds", "Fan control engine: output hysteresis", output.hysteresis, "% dwell", output.minDwell, "s");
+}
+
+void FanControlEngine::setSensorService(SensorService *service)
+{
+    m_sensorService = service;
+}
+
+void FanControlEngine::loadCurves()
+{
+    QSettings curveSettings("LConnect3", "FanCurves");
+    QSettings portSettings("LConnect3", "PortProfiles");
+    QSettings customSettings("LConnect3", "CustomProfiles");
+
+    auto readCurve = [](QSettings &settings, const QString &key) {
+        QVector<QPointF> curve;
+        int size = settings.beginReadArray(key);
+        for (int i = 0; i < size; ++i) {
+            settings.setArrayIndex(i);
+            curve.append(QPointF(settings.value("temp").toDouble(), settings.value("rpm").toDouble()));
+        }
+        settings.endArray();
+        return curve;
+    };
+
+    for (int port = 1; port <= 4; ++port) {
+        // A saved per-port curve always wins
+        QVector<QPointF> curve = readCurve(curveSettings, QString("Port%1").arg(port));
+
+        // Otherwise fall back to the curve of the profile assigned to the port
+        if (curve.size() < 2) {
+            QString profile = portSettings.value(QString("Port%1").arg(port), "Quiet").toString();
+            for (int i = 1; i <= 3 && curve.size() < 2; ++i) {
+                QString name = customSettings.value(QString("Profile%1Name").arg(i), "Cust" + QString::number(i)).toString();
+                if (name == profile) {
+                    curve = readCurve(customSettings, QString("Profile%1Curve").arg(i));
+                }
+            }
+            if (curve.size() < 2) {
+                if (profile == "StdSP") profile = "Standard";
+                else if (profile == "HighSP") profile = "High Speed";
+                else if (profile == "FullSP") profile = "Full Speed";
+                curve = FanCurve::defaultPointsForProfile(profile);
+            }
+        }
+
+        const QString interpolation = curveSettings.value(QString("Port%1Interpolation").arg(port), "linear").toString();
+        m_loop.setCurve(port, FanCurve(curve, FanCurve::interpolationFromName(interpolation)));
+
+        QString strategy = portSettings.value(QString("Port%1Strategy").arg(port), "heuristic").toString();
+        setPortStrategy(port, FanControlStrategy::kindFromName(strategy));
+
+        setPortSensor(port, portSettings.value(QString("Port%1Sensor").arg(port), "cpu").toString());
+    }
+
+    // Output stage: how small a duty drop is worth a write, and how often
+    DutyOutputStage::Parameters output;
+    output.hysteresis = portSettings.value("DutyHysteresis", output.hysteresis).toInt();
+    output.minDwell = portSettings.value("DutyMinDwell", output.minDwell).toDouble();
+    setOutputParameters(output);
+}
+
+void FanControlEngine::sampleTemperature()
+{
+    auto celsius = [](double value) {
+        return value > 0 ? value : std::numeric_limits<double>::quiet_NaN();
+    };
+
+    // Real CPU temperature from the shared sensor service, else simulation
+    int realTemp = -1;
+    if (m_sensorService) {
+        SensorSnapshot sensors = m_sensorService->latestSnapshot();
+        if (sensors.sequence == 0) {
+            return; // Service hasn't sampled yet; keep the last value
+        }
+        realTemp = sensors.cpuTemperature;
+        m_values[SensorValues::Gpu] = celsius(sensors.gpu.temperature);
+        m_values[SensorValues::Nvme] = celsius(sensors.nvmeTemperature);
+        m_values[SensorValues::Liquid] = celsius(sensors.liquidTemperature);
+    }
+
+    if (realTemp > 0) {
+        m_temperature = realTemp;
+        m_simulated = false;
+    } else {
+        // Use simulation with smooth variation
+        m_simulationCounter++;
+        int baseTemp = 39;
+        int tempVariation = (m_simulationCounter % 120) - 60; // -60 to +60 variation
+        m_temperature = qMax(25, qMin(85, baseTemp + tempVariation));
+        m_simulated = true;
+    }
+    m_values[SensorValues::Cpu] = m_temperature;
+
+    // Channels a port expression names explicitly: one pread each
+    for (size_t i = 0; i < m_channels.size(); ++i) {
+        m_values[SensorValues::FirstChannel + int(i)] = celsius(m_channels[i]->readCelsius());
+    }
+
+    if (Trace::isEnabled()) {
+        TRACE_EVENT(Trace::EventType::SensorSample, 0, m_simulated ? Trace::FlagSimulated : 0, 0,
+                    float(m_values[SensorValues::Cpu]), float(m_values[SensorValues::Gpu]),
+                    float(m_values[SensorValues::Nvme]), float(m_values[SensorValues::Liquid]));
+        for (size_t i = 0; i < m_channels.size(); ++i) {
+            const int source = SensorValues::FirstChannel + int(i);
+            TRACE_EVENT(Trace::EventType::SensorSample, uint8_t(source), 0, 0, float(m_values[source]));
+        }
+    }
+}
+
+void FanControlEngine::samplePorts()
+{
+    bool plugged = false;
+    for (int port = 1; port <= 4; ++port) {
+        bool connected = readPortConnected(port);
+        plugged |= connected && !m_connected[port - 1];
+        m_connected[port - 1] = connected;
+    }
+
+    // A newly connected fan has to be told its duty even if it didn't change
+    if (plugged) {
+        m_loop.resendOutputs();
+    }
+}
+
+void FanControlEngine::tick()
+{
+    double dt = m_stepTimer.isValid() ? m_stepTimer.restart() / 1000.0 : 0.1;
+    if (dt <= 0) dt = 0.1;
+
+    // One write for all ports; the driver skips the ports that didn't change.
+    // A failed write leaves the duties pending, so the next tick retries.
+    if (m_loop.step(m_values, dt, m_ring) && writeFanSpeeds()) {
+        m_loop.commitOutputs();
+    }
+
+    SensorSample sample;
+    sample.timestamp = m_clock.isValid() ? m_clock.elapsed() : 0;
+    sample.temperature = m_temperature;
+    sample.filteredTemperature = static_cast<float>(m_loop.filteredTemperature());
+    sample.simulatedTemperature = m_simulated;
+    for (int i = 0; i < 4; ++i) {
+        sample.rpm[i] = static_cast<qint16>(m_loop.rpm(i + 1));
+        sample.duty[i] = static_cast<quint8>(m_loop.duty(i + 1));
+        sample.portTemperature[i] = static_cast<float>(m_loop.portTemperature(i + 1));
+        if (m_connected[i]) {
+            sample.connectedMask |= 1 << i;
+        }
+    }
+    m_ring.push(sample);
+
+    sample.sequence = m_ring.head();
+    emit stepped(sample);
+}
+
+void FanControlEngine::publish()
+{
+    SensorSample sample;
+    if (!m_ring.latest(sample)) {
+        return;
+    }
+
+    // Nothing the UI shows has changed - don't wake it up
+    if (m_publishedOnce && sample.sameReadingAs(m_lastPublished)) {
+        return;
+    }
+
+    m_lastPublished = sample;
+    m_publishedOnce = true;
+    emit samplesPublished(sample.sequence);
+}
+
+bool FanControlEngine::readPortConnected(int port)
+{
+    // Cached by KernelPortInterface; unreadable status counts as not connected
+    return KernelPortInterface::Instance().IsFanConnected(port);
+}
+
+bool FanControlEngine::writeFanSpeeds()
+{
+    std::array<int, KernelPortInterface::kPortCount> duties;
+    for (int i = 0; i < KernelPortInterface::kPortCount; ++i) {
+        duties[i] = m_loop.pendingDuty(i + 1);
+    }
+
+    DEBUG_LOG_CATEGORY("FanSpeeds", "T=", m_loop.portTemperature(1), m_loop.portTemperature(2),
+                       m_loop.portTemperature(3), m_loop.portTemperature(4), "°C -> RPM",
+                       m_loop.rpm(1), m_loop.rpm(2), m_loop.rpm(3), m_loop.rpm(4),
+                       "expected dBA", FanControlStrategy::expectedDBA(m_loop.rpm(1)),
+                       "writes sent", m_loop.output(1).sent(), "suppressed", m_loop.output(1).suppressed());
+
+    // The driver decides between the batched node and per-port writes
+    if (!KernelPortInterface::Instance().SetFanSpeeds(duties)) {
+        DEBUG_LOG_CATEGORY("FanSpeeds", "Fan speed write failed - retried on the next tick");
+        return false;
+    }
+    DEBUG_LOG_CATEGORY("FanSpeeds", "Set fan speeds", duties[0], duties[1], duties[2], duties[3], "% via kernel driver");
+    return true;
+}
@@ -0,0 +1,110 @@
+#ifndef FANCONTROLENGINE_H
+#define FANCONTROLENGINE_H
+
+#include <QObject>
+#include <QVector>
+#include <QPointF>
+#include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+#include "control/sensorring.h"
+#include "control/fancontrolloop.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+class QTimer;
+class SensorService;
+class HwmonChannel;
+
+// Fan control loop. Lives on its own thread (see MainWindow) so sensor reads
+// and /proc writes never stall the GUI, and keeps running at its own tick
+// rate whether or not any page is visible. Every tick is pushed to a
+// lock-free SensorRing that the UI and anything else may read from any
+// thread; the UI is only told to look, at most once per publish interval
+// and only while publishing is enabled.
+class FanControlEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kDefaultTickInterval = 50;          // control loop (ms)
+    static constexpr int kTemperatureInterval = 500;         // sensor snapshot polling (ms)
+    static constexpr int kPortStatusInterval = 1000;         // fan_connected polling (ms)
+    static constexpr int kDefaultHistoryCapacity = 2048;     // samples kept (~100 s at 50 ms)
+
+    explicit FanControlEngine(QObject *parent = nullptr, int historyCapacity = kDefaultHistoryCapacity);
+    ~FanControlEngine();
+
+    // Temperature source; must be set before start() and outlive the engine
+    void setSensorService(SensorService *service);
+
+    // Every control step, newest last; safe to read from any thread
+    const SensorRing &sensorRing() const { return m_ring; }
+
+public slots:
+    // Must run on the engine thread; creates timers and loads saved curves
+    void start();
+    void stop();
+    void setTickInterval(int ms);
+    // 0 disables publishing entirely (window hidden, page not shown)
+    void setPublishInterval(int ms);
+    void setPortCurve(int port, const FanCurve &curve);
+    void setPortStrategy(int port, FanControlStrategy::Kind kind);
+    // Sensor expression the port's curve follows ("cpu", "max(cpu, gpu - 10)", ...)
+    void setPortSensor(int port, const QString &expression);
+    // Hysteresis and dwell of every port's output stage
+    void setOutputParameters(const DutyOutputStage::Parameters &parameters);
+
+signals:
+    // Something the UI shows changed; read it from sensorRing()
+    void samplesPublished(quint64 sequence);
+    // Every control step, on the engine thread; for llconnectd's telemetry page
+    void stepped(const SensorSample &sample);
+
+private slots:
+    void tick();
+    void sampleTemperature();
+    void samplePorts();
+    void publish();
+
+private:
+    void loadCurves();
+    bool readPortConnected(int port);
+    // False if the driver didn't take them; the duties stay pending
+    bool writeFanSpeeds();
+
+    QTimer *m_tickTimer;
+    QTimer *m_temperatureTimer;
+    QTimer *m_portTimer;
+    QTimer *m_publishTimer;
+    int m_tickInterval;
+    int m_publishInterval;
+
+    // Curves, strategies and per-port output state
+    FanControlLoop m_loop;
+
+    // Sensor state
+    SensorValues m_values;
+    std::array<QString, 4> m_sensorText;
+    QStringList m_channelNames;                          // "chip/label" per channel slot
+    std::vector<std::unique_ptr<HwmonChannel>> m_channels;
+    int m_temperature;
+    int m_simulationCounter;
+    bool m_simulated;
+    QVector<bool> m_connected;
+
+    // Loop timing
+    QElapsedTimer m_stepTimer;
+    QElapsedTimer m_clock;
+
+    // History shared with the UI (and used for the loop's own derivative)
+    SensorRing m_ring;
+    SensorSample m_lastPublished;
+    bool m_publishedOnce;
+
+    // Sampled on the sensor thread; read through its thread-safe snapshot
+    SensorService *m_sensorService;
+};
+
+#endif // FANCONTROLENGINE_H
@@ -0,0 +1,142 @@
+#include "fancontrolloop.h"
+#include "utils/trace.h"
+#include <algorithm>
+#include <cmath>
+
+FanControlLoop::FanControlLoop()
+    : m_filteredTemp(0.0)
+{
+    m_portFiltered.fill(0.0);
+    m_portRate.fill(0.0);
+    m_rpmOut.fill(0);
+    for (int i = 0; i < kPortCount; ++i) {
+        m_curves[i] = FanCurve(FanCurve::defaultPointsForProfile("Quiet"));
+        m_strategies[i] = FanControlStrategy::create(FanControlStrategy::Kind::Heuristic);
+    }
+}
+
+void FanControlLoop::setCurve(int port, const FanCurve &curve)
+{
+    if (port < 1 || port > kPortCount || !curve.isValid()) {
+        return;
+    }
+    m_curves[port - 1] = curve;
+    m_strategies[port - 1]->reset();
+}
+
+void FanControlLoop::setStrategy(int port, FanControlStrategy::Kind kind)
+{
+    if (port < 1 || port > kPortCount || m_strategies[port - 1]->kind() == kind) {
+        return;
+    }
+    m_strategies[port - 1] = FanControlStrategy::create(kind);
+}
+
+void FanControlLoop::setSensor(int port, const SensorExpression &expression)
+{
+    if (port < 1 || port > kPortCount || !expression.isValid()) {
+        return;
+    }
+    m_sensors[port - 1] = expression;
+    m_strategies[port - 1]->reset();
+}
+
+void FanControlLoop::setOutputParameters(const DutyOutputStage::Parameters &parameters)
+{
+    for (DutyOutputStage &output : m_outputs) {
+        output.setParameters(parameters);
+    }
+}
+
+void FanControlLoop::resendOutputs()
+{
+    for (DutyOutputStage &output : m_outputs) {
+        output.reset();
+    }
+}
+
+// Very fast asymmetric filter - almost instant response when heating
+static double filterTemperature(double filtered, double raw)
+{
+    double alpha = (raw >= filtered) ? FanControlLoop::kHeatingAlpha : FanControlLoop::kCoolingAlpha;
+    return filtered + alpha * (raw - filtered);
+}
+
+bool FanControlLoop::step(const SensorValues &values, double dt, const SensorRing &history)
+{
+    const double cpu = values[SensorValues::Cpu];
+    if (!std::isnan(cpu)) {
+        m_filteredTemp = filterTemperature(m_filteredTemp, cpu);
+    }
+
+    // Short history for the derivative: this step plus the newest ones in the ring
+    constexpr int kMaxHistory = 32;
+    int histMax = std::clamp(int(std::round(kDerivativeWindow / dt)), 2, kMaxHistory);
+    SensorSample samples[kMaxHistory];
+    int previous = history.recent(samples, histMax - 1);
+
+    // Each port follows its own sensor, curve and strategy
+    bool dutyChanged = false;
+    for (int i = 0; i < kPortCount; ++i) {
+        // A port whose sources are all missing falls back to the CPU
+        double raw = m_sensors[i].evaluate(values);
+        if (std::isnan(raw)) {
+            raw = cpu;
+        }
+        if (!std::isnan(raw)) {
+            m_portFiltered[i] = filterTemperature(m_portFiltered[i], raw);
+        }
+
+        m_portRate[i] = 0.0;
+        if (previous > 0) {
+            m_portRate[i] = (m_portFiltered[i] - samples[previous - 1].portTemperature[i]) / std::max(0.1, dt * previous);
+        }
+
+        FanControlInput input;
+        input.dt = dt;
+        input.temperature = std::isnan(raw) ? m_portFiltered[i] : raw;
+        input.filteredTemperature = m_portFiltered[i];
+        input.rate = m_portRate[i];
+
+        int &rpmOut = m_rpmOut[i];
+        int target = m_strategies[i]->step(input, m_curves[i], rpmOut);
+
+        // Only meaningful changes move the target; the output stage then
+        // decides whether the duty it maps to is worth a write
+        bool requested = std::abs(target - rpmOut) >= kWriteThreshold || rpmOut == 0;
+        if (requested) {
+            rpmOut = target;
+        }
+        bool written = m_outputs[i].offer(dutyForRPM(rpmOut), dt, requested);
+        if (written) {
+            dutyChanged = true;
+        }
+
+        TRACE_EVENT(Trace::EventType::ControlTick, uint8_t(i + 1),
+                    (requested ? Trace::FlagRequested : 0) | (written ? Trace::FlagWritten : 0),
+                    uint32_t(pendingDuty(i + 1)),
+                    float(m_portFiltered[i]), float(m_portRate[i]), float(target), float(rpmOut));
+    }
+    return dutyChanged;
+}
+
+void FanControlLoop::commitOutputs()
+{
+    for (DutyOutputStage &output : m_outputs) {
+        output.commit();
+    }
+}
+
+int FanControlLoop::dutyForRPM(int targetRPM)
+{
+    // Minimum 840 RPM to prevent fan shutdown (allow 120 RPM for idle)
+    if (targetRPM > 120 && targetRPM < 840) {
+        targetRPM = 840;
+    }
+    targetRPM = qBound(0, targetRPM, 2100);
+
+    // Convert RPM to percentage for kernel driver
+    // Based on calibration: Percentage = RPM / 21
+    // 840 RPM = 40%, 1260 RPM = 60%, 1680 RPM = 80%, 2100 RPM = 100%
+    return qBound(0, targetRPM / 21, 100);
+}
@@ -0,0 +1,75 @@
+#ifndef FANCONTROLLOOP_H
+#define FANCONTROLLOOP_H
+
+#include <QtGlobal>
+#include <array>
+#include <memory>
+#include "control/fancurve.h"
+#include "control/fancontrolstrategy.h"
+#include "control/sensorring.h"
+#include "control/sensorexpression.h"
+#include "control/dutyoutputstage.h"
+
+// One control step for all four ports, with no timers, devices or I/O:
+// evaluate each port's sensor expression, filter it, derive its heating
+// rate from the history ring, let the port's strategy pick an RPM and let
+// the port's DutyOutputStage decide whether that is worth a driver write.
+// FanControlEngine runs it on
+// live sensors; the offline simulator (fansim) runs the very same code on a
+// thermal model.
+class FanControlLoop
+{
+public:
+    static constexpr int kPortCount = 4;
+    static constexpr double kHeatingAlpha = 0.95;    // filter weight of a rising reading
+    static constexpr double kCoolingAlpha = 0.60;    // filter weight of a falling reading
+    static constexpr double kDerivativeWindow = 0.3; // s of history for the heating rate
+    static constexpr int kWriteThreshold = 10;       // RPM change the strategy acts on
+
+    FanControlLoop();
+
+    // Ports are 1-4; out-of-range ports and invalid curves are ignored
+    void setCurve(int port, const FanCurve &curve);
+    void setStrategy(int port, FanControlStrategy::Kind kind);
+    FanControlStrategy::Kind strategy(int port) const { return m_strategies[port - 1]->kind(); }
+    // What the port's curve follows; CPU temperature by default
+    void setSensor(int port, const SensorExpression &expression);
+    const SensorExpression &sensor(int port) const { return m_sensors[port - 1]; }
+    // Hysteresis and dwell of every port's output stage
+    void setOutputParameters(const DutyOutputStage::Parameters &parameters);
+    // Next step sends every port's duty again
+    void resendOutputs();
+
+    // Runs one step on the latest sensor values; history holds the previous
+    // steps (newest first, as pushed by the caller, with filteredTemperature
+    // and portTemperature taken from this loop). Returns true if any port's
+    // duty changed and the driver should be written with pendingDuty();
+    // call commitOutputs() once that write succeeded.
+    bool step(const SensorValues &values, double dt, const SensorRing &history);
+    void commitOutputs();
+
+    double filteredTemperature() const { return m_filteredTemp; }
+    double portTemperature(int port) const { return m_portFiltered[port - 1]; }
+    double rate(int port) const { return m_portRate[port - 1]; }
+    int rpm(int port) const { return m_rpmOut[port - 1]; }
+    // Percent last handed to the driver
+    int duty(int port) const { return qMax(0, m_outputs[port - 1].committed()); }
+    // Percent the next driver write carries
+    int pendingDuty(int port) const { return qMax(0, m_outputs[port - 1].pending()); }
+    const DutyOutputStage &output(int port) const { return m_outputs[port - 1]; }
+
+    // Percent for the kernel driver, with the minimum-RPM floor applied
+    static int dutyForRPM(int targetRPM);
+
+private:
+    std::array<FanCurve, kPortCount> m_curves;
+    std::array<std::unique_ptr<FanControlStrategy>, kPortCount> m_strategies;
+    std::array<SensorExpression, kPortCount> m_sensors;
+    std::array<double, kPortCount> m_portFiltered;
+    std::array<double, kPortCount> m_portRate;
+    std::array<int, kPortCount> m_rpmOut;
+    std::array<DutyOutputStage, kPortCount> m_outputs;
+    double m_filteredTemp;                 // CPU, for the history and the UI
+};
+
+#endif // FANCONTROLLOOP_H
@@ -0,0 +1,163 @@
+#include "fancontrolstrategy.h"
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+std::unique_ptr<FanControlStrategy> FanControlStrategy::create(Kind kind)
+{
+    switch (kind) {
+    case Kind::Pid:
+        return std::make_unique<PidFanStrategy>();
+    case Kind::Predictive:
+        return std::make_unique<PredictiveFanStrategy>();
+    case Kind::Heuristic:
+    default:
+        return std::make_unique<HeuristicFanStrategy>();
+    }
+}
+
+QString FanControlStrategy::kindName(Kind kind)
+{
+    switch (kind) {
+    case Kind::Pid:
+        return "pid";
+    case Kind::Predictive:
+        return "mpc";
+    case Kind::Heuristic:
+    default:
+        return "heuristic";
+    }
+}
+
+FanControlStrategy::Kind FanControlStrategy::kindFromName(const QString &name)
+{
+    if (name == "pid") return Kind::Pid;
+    if (name == "mpc") return Kind::Predictive;
+    return Kind::Heuristic;
+}
+
+double FanControlStrategy::expectedDBA(int rpm)
+{
+    // 840 RPM = 34 dBA, 1040 RPM = 39 dBA, 1260 RPM = 45 dBA,
+    // 1480 RPM = 49 dBA, 1680 RPM = 52 dBA, 1880 RPM = 56 dBA, 2100 RPM = 60 dBA
+    if (rpm <= 840) {
+        return 34.0 + (rpm - 840) * (34.0 - 0.0) / (840 - 0);
+    } else if (rpm <= 1040) {
+        return 34.0 + (rpm - 840) * (39.0 - 34.0) / (1040 - 840);
+    } else if (rpm <= 1260) {
+        return 39.0 + (rpm - 1040) * (45.0 - 39.0) / (1260 - 1040);
+    } else if (rpm <= 1480) {
+        return 45.0 + (rpm - 1260) * (49.0 - 45.0) / (1480 - 1260);
+    } else if (rpm <= 1680) {
+        return 49.0 + (rpm - 1480) * (52.0 - 49.0) / (1680 - 1480);
+    } else if (rpm <= 1880) {
+        return 52.0 + (rpm - 1680) * (56.0 - 52.0) / (1880 - 1680);
+    }
+    return 56.0 + (rpm - 1880) * (60.0 - 56.0) / (2100 - 1880);
+}
+
+int HeuristicFanStrategy::step(const FanControlInput &input, const FanCurve &curve, int lastRPM)
+{
+    const Parameters &p = m_parameters;
+
+    // Only heating matters here
+    double rate = qBound(0.0, input.rate, p.maxRate);
+    const bool heating = rate > p.heatingThreshold;
+
+    int base_now  = curve.rpmAt(input.filteredTemperature);
+    int base_pred = curve.rpmAt(input.filteredTemperature + rate * p.lookAhead);
+    int base_rpm  = heating ? std::max(base_now, base_pred) : base_now;
+
+    // Aggressive feedforward proportional to heating rate, plus a boost when heating rapidly
+    int ff_rpm = heating ? int(std::round(rate * p.feedforwardGain)) : 0;
+    int boostRPM = (heating && rate > p.boostRate) ? p.boostRPM : 0;
+
+    int target = std::clamp(base_rpm + ff_rpm + boostRPM, 0, kMaxRPM);
+
+    // Slew rate control - fast up, moderate down, faster still when hot
+    const bool hot = input.filteredTemperature > p.hotTemperature;
+    double up_slew = hot ? p.hotUpSlew : p.upSlew;
+    double down_slew = hot ? p.hotDownSlew : p.downSlew;
+
+    int maxStepUp = std::max(1, int(std::round(up_slew * input.dt)));
+    int maxStepDown = std::max(1, int(std::round(down_slew * input.dt)));
+
+    if (target > lastRPM) {
+        return std::min(target, lastRPM + maxStepUp);
+    } else if (target < lastRPM) {
+        return std::max(target, lastRPM - maxStepDown);
+    }
+    return target;
+}
+
+int PidFanStrategy::step(const FanControlInput &input, const FanCurve &curve, int lastRPM)
+{
+    Q_UNUSED(lastRPM)
+    const Parameters &p = m_parameters;
+
+    const double error = input.filteredTemperature - p.targetTemperature;
+    m_rate += p.derivativeFilter * (input.rate - m_rate);
+
+    // The curve is the floor; the PID only ever adds cooling on top of it
+    const double feedforward = curve.rpmAt(input.filteredTemperature);
+    const double correction = p.kp * error + p.ki * m_integral + p.kd * m_rate;
+
+    // Conditional integration: don't push further into a saturated output
+    const bool saturatedHigh = feedforward + correction >= kMaxRPM && error > 0.0;
+    const bool saturatedLow = correction <= 0.0 && error < 0.0;
+    if (!saturatedHigh && !saturatedLow && p.ki > 0.0) {
+        const double limit = p.integralLimit / p.ki;
+        m_integral = qBound(-limit, m_integral + error * input.dt, limit);
+    }
+
+    const double output = feedforward + std::max(0.0, p.kp * error + p.ki * m_integral + p.kd * m_rate);
+    return std::clamp(int(std::round(output)), 0, kMaxRPM);
+}
+
+void PidFanStrategy::reset()
+{
+    m_integral = 0.0;
+    m_rate = 0.0;
+}
+
+int PredictiveFanStrategy::step(const FanControlInput &input, const FanCurve &curve, int lastRPM)
+{
+    const Parameters &p = m_parameters;
+
+    const int floor = std::clamp(curve.rpmAt(input.filteredTemperature), 0, kMaxRPM);
+    const int steps = std::max(1, p.horizonSteps);
+    const double h = p.horizon / steps;
+    const int stride = std::max(1, p.candidateStep);
+
+    int best = floor;
+    double bestCost = 0.0;
+    bool first = true;
+    for (int candidate = floor; ; candidate = std::min(candidate + stride, kMaxRPM)) {
+        // The observed rate already includes the cooling at lastRPM
+        const double rate = input.rate - p.coolingGain * (candidate - lastRPM) / 1000.0;
+
+        double overshoot = 0.0;
+        double temperature = input.filteredTemperature;
+        for (int k = 0; k < steps; ++k) {
+            temperature += rate * h;
+            double over = std::max(0.0, temperature - p.targetTemperature);
+            overshoot += over * over;
+        }
+
+        const double move = (candidate - lastRPM) / 100.0;
+        const double cost = p.temperatureWeight * overshoot
+                          + p.noiseWeight * expectedDBA(candidate)
+                          + p.moveWeight * move * move;
+        if (first || cost < bestCost) {
+            best = candidate;
+            bestCost = cost;
+            first = false;
+        }
+
+        if (candidate >= kMaxRPM) {
+            break;
+        }
+    }
+
+    return best;
+}
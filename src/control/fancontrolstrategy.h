@@ -0,0 +1,141 @@
+#ifndef FANCONTROLSTRATEGY_H
+#define FANCONTROLSTRATEGY_H
+
+#include <QString>
+#include <memory>
+#include "control/fancurve.h"
+
+// What a strategy sees each control step. Every port follows its own sensor
+// expression, evaluated and filtered separately, so each port gets its own
+// input.
+struct FanControlInput
+{
+    double dt = 0.05;                  // seconds since the previous step
+    double temperature = 0.0;          // port's sensor expression, unfiltered (°C)
+    double filteredTemperature = 0.0;  // temperature the loop acts on (°C)
+    double rate = 0.0;                 // d(filteredTemperature)/dt (°C/s)
+};
+
+// Turns a port's curve and the current temperature into a target RPM.
+// One instance per port: everything a strategy remembers between steps
+// (integrator, last output, ...) lives in the instance, so ports never
+// influence each other and a strategy can be driven without the engine.
+class FanControlStrategy
+{
+public:
+    enum class Kind {
+        Heuristic,  // curve + look-ahead + feedforward + slew limits
+        Pid,        // curve as the floor, PID adds cooling above a target temperature
+        Predictive  // picks the quietest RPM that keeps the predicted temperature in bounds
+    };
+
+    static constexpr int kMaxRPM = 2100;
+
+    virtual ~FanControlStrategy() = default;
+
+    virtual Kind kind() const = 0;
+
+    // Target RPM for this step; lastRPM is what the port currently runs at
+    virtual int step(const FanControlInput &input, const FanCurve &curve, int lastRPM) = 0;
+
+    // Forget accumulated state (curve or strategy changed)
+    virtual void reset() {}
+
+    static std::unique_ptr<FanControlStrategy> create(Kind kind);
+
+    // Settings names ("heuristic", "pid", "mpc"); unknown names are Heuristic
+    static QString kindName(Kind kind);
+    static Kind kindFromName(const QString &name);
+
+    // Expected noise of an SL120 at the given RPM, from the calibration table
+    static double expectedDBA(int rpm);
+};
+
+// The original control loop: follow the curve, look ahead on the heating
+// rate, add a feedforward term and a boost when heating fast, then slew.
+class HeuristicFanStrategy : public FanControlStrategy
+{
+public:
+    struct Parameters {
+        double heatingThreshold = 0.02;  // °C/s considered heating
+        double maxRate = 10.0;           // °C/s clamp on the derivative
+        double lookAhead = 10.0;         // s of heating to anticipate
+        double feedforwardGain = 800.0;  // RPM per °C/s
+        double boostRate = 0.3;          // °C/s above which boostRPM is added
+        int boostRPM = 400;
+        double upSlew = 1500.0;          // RPM/s
+        double downSlew = 200.0;         // RPM/s
+        double hotTemperature = 65.0;    // °C above which the hot slews apply
+        double hotUpSlew = 2000.0;
+        double hotDownSlew = 300.0;
+    };
+
+    HeuristicFanStrategy() = default;
+    explicit HeuristicFanStrategy(const Parameters &parameters) : m_parameters(parameters) {}
+
+    Kind kind() const override { return Kind::Heuristic; }
+    int step(const FanControlInput &input, const FanCurve &curve, int lastRPM) override;
+
+private:
+    Parameters m_parameters;
+};
+
+// PID on the temperature error above a target, added on top of the curve.
+// The integral only accumulates while the output isn't saturated in the
+// direction it would push (conditional integration), and is bounded
+// besides, so a long stretch on the curve or at full speed doesn't wind it up.
+class PidFanStrategy : public FanControlStrategy
+{
+public:
+    struct Parameters {
+        double targetTemperature = 60.0; // °C
+        double kp = 60.0;                // RPM per °C
+        double ki = 4.0;                 // RPM per °C·s
+        double kd = 150.0;               // RPM per °C/s
+        double integralLimit = 600.0;    // |ki * integral| bound (RPM)
+        double derivativeFilter = 0.5;   // 0-1, weight of the newest rate
+    };
+
+    PidFanStrategy() = default;
+    explicit PidFanStrategy(const Parameters &parameters) : m_parameters(parameters) {}
+
+    Kind kind() const override { return Kind::Pid; }
+    int step(const FanControlInput &input, const FanCurve &curve, int lastRPM) override;
+    void reset() override;
+
+private:
+    Parameters m_parameters;
+    double m_integral = 0.0;
+    double m_rate = 0.0;
+};
+
+// Small model-predictive controller. The curve is the floor; above it the
+// controller tries a range of constant RPMs over a short horizon, predicts
+// the temperature with a first-order model (observed heating rate, minus
+// extra cooling per extra RPM) and keeps the RPM with the lowest cost of
+// predicted overshoot, expected noise and change from the current RPM.
+class PredictiveFanStrategy : public FanControlStrategy
+{
+public:
+    struct Parameters {
+        double targetTemperature = 70.0; // °C the prediction should stay under
+        double horizon = 10.0;           // s
+        int horizonSteps = 10;
+        int candidateStep = 105;         // RPM between candidates (5% duty)
+        double coolingGain = 0.6;        // °C/s of cooling per 1000 RPM added
+        double temperatureWeight = 4.0;  // per (°C over target)² per step
+        double noiseWeight = 1.0;        // per dBA
+        double moveWeight = 0.5;         // per (100 RPM change)²
+    };
+
+    PredictiveFanStrategy() = default;
+    explicit PredictiveFanStrategy(const Parameters &parameters) : m_parameters(parameters) {}
+
+    Kind kind() const override { return Kind::Predictive; }
+    int step(const FanControlInput &input, const FanCurve &curve, int lastRPM) override;
+
+private:
+    Parameters m_parameters;
+};
+
+#endif // FANCONTROLSTRATEGY_H
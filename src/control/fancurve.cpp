@@ -0,0 +1,161 @@
+#include "fancurve.h"
+#include <algorithm>
+#include <cmath>
+
+// Fritsch-Carlson tangents: a cubic Hermite through the points with these
+// slopes is monotone on every segment where the points are
+static QVector<double> monotoneTangents(const QVector<QPointF> &points)
+{
+    const int n = points.size();
+    QVector<double> secants(n - 1);
+    for (int k = 0; k < n - 1; ++k) {
+        secants[k] = (points[k + 1].y() - points[k].y()) / (points[k + 1].x() - points[k].x());
+    }
+
+    QVector<double> tangents(n);
+    tangents[0] = secants[0];
+    tangents[n - 1] = secants[n - 2];
+    for (int k = 1; k < n - 1; ++k) {
+        // Local extremum or flat spot: keep it flat so the curve can't overshoot
+        tangents[k] = (secants[k - 1] * secants[k] <= 0.0) ? 0.0 : (secants[k - 1] + secants[k]) / 2.0;
+    }
+
+    for (int k = 0; k < n - 1; ++k) {
+        if (secants[k] == 0.0) {
+            tangents[k] = 0.0;
+            tangents[k + 1] = 0.0;
+            continue;
+        }
+        double a = tangents[k] / secants[k];
+        double b = tangents[k + 1] / secants[k];
+        double length = a * a + b * b;
+        if (length > 9.0) {
+            double tau = 3.0 / std::sqrt(length);
+            tangents[k] = tau * a * secants[k];
+            tangents[k + 1] = tau * b * secants[k];
+        }
+    }
+    return tangents;
+}
+
+QString FanCurve::interpolationName(Interpolation interpolation)
+{
+    switch (interpolation) {
+    case Interpolation::MonotoneCubic:
+        return "cubic";
+    case Interpolation::Step:
+        return "step";
+    case Interpolation::Linear:
+    default:
+        return "linear";
+    }
+}
+
+FanCurve::Interpolation FanCurve::interpolationFromName(const QString &name)
+{
+    if (name == "cubic") return Interpolation::MonotoneCubic;
+    if (name == "step") return Interpolation::Step;
+    return Interpolation::Linear;
+}
+
+QVector<QPointF> FanCurve::defaultPointsForProfile(const QString &profile)
+{
+    QVector<QPointF> curvePoints;
+
+    if (profile == "Standard") {
+        curvePoints << QPointF(0, 120) << QPointF(25, 420) << QPointF(40, 1050) << QPointF(55, 1260)
+                   << QPointF(70, 1680) << QPointF(90, 2100) << QPointF(100, 2100);
+    } else if (profile == "High Speed") {
+        curvePoints << QPointF(0, 120) << QPointF(25, 910) << QPointF(35, 1140) << QPointF(50, 1470)
+                   << QPointF(70, 1800) << QPointF(85, 2100) << QPointF(100, 2100);
+    } else if (profile == "Full Speed") {
+        curvePoints << QPointF(0, 120) << QPointF(25, 2100) << QPointF(40, 2100) << QPointF(55, 2100)
+                   << QPointF(70, 2100) << QPointF(90, 2100) << QPointF(100, 2100);
+    } else {
+        // Quiet, and the default for anything unknown
+        curvePoints << QPointF(0, 120) << QPointF(25, 420) << QPointF(45, 840)
+                   << QPointF(65, 1050) << QPointF(80, 1680) << QPointF(90, 2100) << QPointF(100, 2100);
+    }
+
+    return curvePoints;
+}
+
+FanCurve::FanCurve(const QVector<QPointF> &points, Interpolation interpolation)
+    : m_points(points)
+    , m_interpolation(interpolation)
+{
+    compile();
+}
+
+void FanCurve::compile()
+{
+    m_table.clear();
+    if (m_points.size() < 2) {
+        return;
+    }
+
+    // Dragging can move a point past its neighbour; evaluate in temperature
+    // order, and let the later point win where two share a temperature
+    QVector<QPointF> sorted = m_points;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const QPointF &a, const QPointF &b) {
+        return a.x() < b.x();
+    });
+    QVector<QPointF> knots;
+    knots.reserve(sorted.size());
+    for (const QPointF &point : sorted) {
+        if (!knots.isEmpty() && knots.last().x() == point.x()) {
+            knots.last() = point;
+        } else {
+            knots.append(point);
+        }
+    }
+
+    QVector<double> tangents;
+    if (m_interpolation == Interpolation::MonotoneCubic && knots.size() >= 2) {
+        tangents = monotoneTangents(knots);
+    }
+
+    m_table.resize(kTableSize);
+    int segment = 0;
+    for (int i = 0; i < kTableSize; ++i) {
+        const double temperature = kMinTemperature + double(i) / kStepsPerDegree;
+
+        // Outside the points the curve is flat at the nearest end point
+        double rpm;
+        if (knots.size() < 2 || temperature <= knots.first().x()) {
+            rpm = knots.first().y();
+        } else if (temperature >= knots.last().x()) {
+            rpm = knots.last().y();
+        } else {
+            // Table entries ascend, so the segment only ever moves forward
+            while (temperature > knots[segment + 1].x()) {
+                ++segment;
+            }
+            const QPointF &p0 = knots[segment];
+            const QPointF &p1 = knots[segment + 1];
+            const double span = p1.x() - p0.x();
+            const double t = (temperature - p0.x()) / span;
+
+            switch (m_interpolation) {
+            case Interpolation::Step:
+                rpm = (temperature < p1.x()) ? p0.y() : p1.y();
+                break;
+            case Interpolation::MonotoneCubic: {
+                const double t2 = t * t;
+                const double t3 = t2 * t;
+                rpm = (2 * t3 - 3 * t2 + 1) * p0.y()
+                    + (t3 - 2 * t2 + t) * span * tangents[segment]
+                    + (-2 * t3 + 3 * t2) * p1.y()
+                    + (t3 - t2) * span * tangents[segment + 1];
+                break;
+            }
+            case Interpolation::Linear:
+            default:
+                rpm = p0.y() + t * (p1.y() - p0.y());
+                break;
+            }
+        }
+
+        m_table[i] = qRound(rpm);
+    }
+}
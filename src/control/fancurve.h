@@ -0,0 +1,64 @@
+#ifndef FANCURVE_H
+#define FANCURVE_H
+
+#include <QVector>
+#include <QPointF>
+#include <QString>
+#include <QtGlobal>
+
+// A temperature -> RPM fan curve, compiled once into a lookup table.
+//
+// The control points are what the user edits and what gets saved; every
+// evaluation (the control loop, the curve widget) is a single table read at
+// 0.1 °C resolution over 0-100 °C. Copies are cheap: the points and the
+// table are implicitly shared, so a compiled curve can be handed to the
+// engine thread by value.
+class FanCurve
+{
+public:
+    enum class Interpolation {
+        Linear,        // straight segments between points
+        MonotoneCubic, // smooth, never overshoots between points
+        Step           // hold each point's RPM until the next point
+    };
+
+    static constexpr double kMinTemperature = 0.0;
+    static constexpr double kMaxTemperature = 100.0;
+    static constexpr int kStepsPerDegree = 10;
+    static constexpr int kTableSize = int(kMaxTemperature - kMinTemperature) * kStepsPerDegree + 1;
+
+    // Built-in curves by internal profile name ("Quiet", "Standard", ...)
+    static QVector<QPointF> defaultPointsForProfile(const QString &profile);
+
+    // Settings names ("linear", "cubic", "step"); unknown names are Linear
+    static QString interpolationName(Interpolation interpolation);
+    static Interpolation interpolationFromName(const QString &name);
+
+    FanCurve() = default;
+    explicit FanCurve(const QVector<QPointF> &points, Interpolation interpolation = Interpolation::Linear);
+
+    // At least two points; an invalid curve evaluates to 0 RPM
+    bool isValid() const { return !m_table.isEmpty(); }
+
+    const QVector<QPointF> &points() const { return m_points; }
+    Interpolation interpolation() const { return m_interpolation; }
+
+    // Temperature is clamped to 0-100 °C and rounded to 0.1 °C
+    int rpmAt(double temperature) const
+    {
+        if (m_table.isEmpty()) {
+            return 0;
+        }
+        double t = qBound(kMinTemperature, temperature, kMaxTemperature);
+        return m_table.at(qRound((t - kMinTemperature) * kStepsPerDegree));
+    }
+
+private:
+    void compile();
+
+    QVector<QPointF> m_points;
+    Interpolation m_interpolation = Interpolation::Linear;
+    QVector<int> m_table;
+};
+
+#endif // FANCURVE_H
@@ -0,0 +1,359 @@
+#include "sensorexpression.h"
+#include <algorithm>
+#include <cmath>
+
+// Recursive-descent parser emitting postfix ops
+//
+//     expr    := term (('+' | '-') term)*
+//     term    := unary (('*' | '/') unary)*
+//     unary   := '-' unary | primary
+//     primary := number | source | call | '(' expr ')'
+class SensorExpressionParser
+{
+public:
+    SensorExpressionParser(const QString &text, QStringList *channels)
+        : m_text(text)
+        , m_pos(0)
+        , m_depth(0)
+        , m_maxDepth(0)
+        , m_channels(channels)
+    {
+    }
+
+    bool parse(QVector<SensorExpression::Op> &program, QString &error)
+    {
+        if (!parseExpression()) {
+            error = m_error;
+            return false;
+        }
+        skipSpace();
+        if (m_pos < m_text.size()) {
+            error = QString("unexpected '%1' at %2").arg(m_text.mid(m_pos, 1)).arg(m_pos + 1);
+            return false;
+        }
+        if (m_maxDepth > SensorExpression::kMaxStack) {
+            error = "expression too deeply nested";
+            return false;
+        }
+        program = m_program;
+        return true;
+    }
+
+private:
+    using Op = SensorExpression::Op;
+
+    void push(Op::Code code, double value = 0.0, int argument = 0)
+    {
+        m_program.append({ code, value, argument });
+
+        // Track the stack the program will need
+        switch (code) {
+        case Op::Constant:
+        case Op::Load:
+            ++m_depth;
+            break;
+        case Op::Negate:
+            break;
+        case Op::Max:
+        case Op::Min:
+        case Op::Avg:
+        case Op::Blend:
+            m_depth -= argument - 1;
+            break;
+        default:
+            --m_depth;
+            break;
+        }
+        m_maxDepth = std::max(m_maxDepth, m_depth);
+    }
+
+    bool fail(const QString &message)
+    {
+        if (m_error.isEmpty()) {
+            m_error = message;
+        }
+        return false;
+    }
+
+    void skipSpace()
+    {
+        while (m_pos < m_text.size() && m_text.at(m_pos).isSpace()) {
+            ++m_pos;
+        }
+    }
+
+    bool accept(QChar c)
+    {
+        skipSpace();
+        if (m_pos < m_text.size() && m_text.at(m_pos) == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool expect(QChar c)
+    {
+        return accept(c) || fail(QString("expected '%1' at %2").arg(c).arg(m_pos + 1));
+    }
+
+    bool parseExpression()
+    {
+        if (!parseTerm()) {
+            return false;
+        }
+        for (;;) {
+            if (accept('+')) {
+                if (!parseTerm()) return false;
+                push(Op::Add);
+            } else if (accept('-')) {
+                if (!parseTerm()) return false;
+                push(Op::Subtract);
+            } else {
+                return true;
+            }
+        }
+    }
+
+    bool parseTerm()
+    {
+        if (!parseUnary()) {
+            return false;
+        }
+        for (;;) {
+            if (accept('*')) {
+                if (!parseUnary()) return false;
+                push(Op::Multiply);
+            } else if (accept('/')) {
+                if (!parseUnary()) return false;
+                push(Op::Divide);
+            } else {
+                return true;
+            }
+        }
+    }
+
+    bool parseUnary()
+    {
+        if (accept('-')) {
+            if (!parseUnary()) return false;
+            push(Op::Negate);
+            return true;
+        }
+        return parsePrimary();
+    }
+
+    bool parsePrimary()
+    {
+        skipSpace();
+        if (m_pos >= m_text.size()) {
+            return fail("unexpected end of expression");
+        }
+
+        if (accept('(')) {
+            return parseExpression() && expect(')');
+        }
+
+        QChar c = m_text.at(m_pos);
+        if (c.isDigit() || c == '.') {
+            int start = m_pos;
+            while (m_pos < m_text.size() && (m_text.at(m_pos).isDigit() || m_text.at(m_pos) == '.')) {
+                ++m_pos;
+            }
+            bool ok = false;
+            double value = m_text.mid(start, m_pos - start).toDouble(&ok);
+            if (!ok) {
+                return fail(QString("bad number at %1").arg(start + 1));
+            }
+            push(Op::Constant, value);
+            return true;
+        }
+
+        if (!c.isLetter()) {
+            return fail(QString("unexpected '%1' at %2").arg(c).arg(m_pos + 1));
+        }
+
+        int start = m_pos;
+        while (m_pos < m_text.size() && (m_text.at(m_pos).isLetterOrNumber() || m_text.at(m_pos) == '_')) {
+            ++m_pos;
+        }
+        const QString name = m_text.mid(start, m_pos - start).toLower();
+
+        if (name == "cpu") { push(Op::Load, 0.0, SensorValues::Cpu); return true; }
+        if (name == "gpu") { push(Op::Load, 0.0, SensorValues::Gpu); return true; }
+        if (name == "nvme") { push(Op::Load, 0.0, SensorValues::Nvme); return true; }
+        if (name == "liquid") { push(Op::Load, 0.0, SensorValues::Liquid); return true; }
+        if (name == "hwmon") return parseChannel();
+
+        Op::Code code;
+        if (name == "max") code = Op::Max;
+        else if (name == "min") code = Op::Min;
+        else if (name == "avg") code = Op::Avg;
+        else if (name == "blend") code = Op::Blend;
+        else return fail(QString("unknown name '%1'").arg(name));
+
+        if (!expect('(')) {
+            return false;
+        }
+        int count = 0;
+        do {
+            if (!parseExpression()) return false;
+            ++count;
+        } while (accept(','));
+        if (!expect(')')) {
+            return false;
+        }
+        if (code == Op::Blend && (count < 2 || count % 2 != 0)) {
+            return fail("blend() takes value, weight pairs");
+        }
+        push(code, 0.0, count);
+        return true;
+    }
+
+    // hwmon("chip", "label") -> a channel slot
+    bool parseChannel()
+    {
+        QString chip;
+        QString label;
+        if (!expect('(') || !parseString(chip) || !expect(',') || !parseString(label) || !expect(')')) {
+            return false;
+        }
+
+        const QString key = chip + "/" + label;
+        int index = m_channels ? m_channels->indexOf(key) : -1;
+        if (index < 0) {
+            if (!m_channels || m_channels->size() >= SensorValues::kMaxChannels) {
+                return fail(QString("too many hwmon channels (at most %1)").arg(SensorValues::kMaxChannels));
+            }
+            m_channels->append(key);
+            index = m_channels->size() - 1;
+        }
+        push(Op::Load, 0.0, SensorValues::FirstChannel + index);
+        return true;
+    }
+
+    bool parseString(QString &out)
+    {
+        if (!expect('"')) {
+            return false;
+        }
+        int end = m_text.indexOf('"', m_pos);
+        if (end < 0) {
+            return fail("unterminated string");
+        }
+        out = m_text.mid(m_pos, end - m_pos);
+        m_pos = end + 1;
+        return true;
+    }
+
+    const QString &m_text;
+    int m_pos;
+    int m_depth;
+    int m_maxDepth;
+    QStringList *m_channels;
+    QString m_error;
+    QVector<SensorExpression::Op> m_program;
+};
+
+SensorExpression::SensorExpression()
+    : m_text("cpu")
+{
+    m_program.append({ Op::Load, 0.0, SensorValues::Cpu });
+}
+
+SensorExpression SensorExpression::compile(const QString &text, QStringList *channels, QString *error)
+{
+    SensorExpression expression;
+    expression.m_text = text.trimmed();
+    expression.m_program.clear();
+
+    // Don't register channels from an expression that turns out to be invalid
+    QStringList scratch = channels ? *channels : QStringList();
+    QString message;
+    SensorExpressionParser parser(expression.m_text, &scratch);
+    if (!parser.parse(expression.m_program, message)) {
+        expression.m_program.clear();
+        if (error) *error = message;
+        return expression;
+    }
+
+    if (channels) {
+        *channels = scratch;
+    }
+    return expression;
+}
+
+double SensorExpression::evaluate(const SensorValues &values) const
+{
+    double stack[kMaxStack];
+    int top = 0;
+
+    for (const Op &op : m_program) {
+        switch (op.code) {
+        case Op::Constant:
+            stack[top++] = op.value;
+            break;
+        case Op::Load:
+            stack[top++] = values[op.argument];
+            break;
+        case Op::Add:
+            --top;
+            stack[top - 1] += stack[top];
+            break;
+        case Op::Subtract:
+            --top;
+            stack[top - 1] -= stack[top];
+            break;
+        case Op::Multiply:
+            --top;
+            stack[top - 1] *= stack[top];
+            break;
+        case Op::Divide:
+            --top;
+            stack[top - 1] /= stack[top];
+            break;
+        case Op::Negate:
+            stack[top - 1] = -stack[top - 1];
+            break;
+        case Op::Max:
+        case Op::Min:
+        case Op::Avg: {
+            // Missing arguments don't count
+            top -= op.argument;
+            double result = std::numeric_limits<double>::quiet_NaN();
+            double sum = 0.0;
+            int count = 0;
+            for (int i = 0; i < op.argument; ++i) {
+                double v = stack[top + i];
+                if (std::isnan(v)) continue;
+                sum += v;
+                ++count;
+                if (std::isnan(result) || (op.code == Op::Max ? v > result : v < result)) {
+                    result = v;
+                }
+            }
+            if (op.code == Op::Avg) {
+                result = count > 0 ? sum / count : std::numeric_limits<double>::quiet_NaN();
+            }
+            stack[top++] = result;
+            break;
+        }
+        case Op::Blend: {
+            top -= op.argument;
+            double sum = 0.0;
+            double weights = 0.0;
+            for (int i = 0; i < op.argument; i += 2) {
+                double v = stack[top + i];
+                double w = stack[top + i + 1];
+                if (std::isnan(v) || std::isnan(w)) continue;
+                sum += v * w;
+                weights += w;
+            }
+            stack[top++] = weights != 0.0 ? sum / weights : std::numeric_limits<double>::quiet_NaN();
+            break;
+        }
+        }
+    }
+
+    return top > 0 ? stack[top - 1] : std::numeric_limits<double>::quiet_NaN();
+}
@@ -0,0 +1,84 @@
+#ifndef SENSOREXPRESSION_H
+#define SENSOREXPRESSION_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <array>
+#include <limits>
+
+// Every temperature a fan curve can be bound to, refreshed by the engine at
+// the sensor interval. Missing sources are NaN.
+struct SensorValues
+{
+    enum Source {
+        Cpu = 0,
+        Gpu,
+        Nvme,
+        Liquid,
+        FirstChannel   // named hwmon channels follow, see SensorExpression
+    };
+
+    static constexpr int kMaxChannels = 8;
+    static constexpr int kSize = FirstChannel + kMaxChannels;
+
+    SensorValues() { values.fill(std::numeric_limits<double>::quiet_NaN()); }
+
+    double &operator[](int source) { return values[source]; }
+    double operator[](int source) const { return values[source]; }
+
+    std::array<double, kSize> values;
+};
+
+// The temperature a port's curve follows, as an expression over sensors:
+//
+//     cpu                                  the default
+//     max(cpu, gpu - 10)                   whichever is hotter, GPU offset
+//     0.7 * cpu + 0.3 * gpu                fixed weights
+//     blend(cpu, 2, gpu, 1)                weights renormalised over the
+//                                          sources that can be read
+//     liquid
+//     hwmon("k10temp", "Tccd1")            a specific hwmon channel
+//
+// Sources: cpu, gpu, nvme, liquid, hwmon("chip", "label"). Functions: max,
+// min and avg (any number of arguments, missing sources skipped) and
+// blend(value, weight, ...). Operators: + - * / and parentheses; arithmetic
+// on a missing source is missing.
+//
+// compile() parses once into a short postfix program; evaluate() runs it on
+// a fixed stack, so the per-tick cost doesn't depend on how the expression
+// was written and nothing is allocated.
+class SensorExpression
+{
+public:
+    static constexpr int kMaxStack = 16;
+
+    // Reads the CPU temperature
+    SensorExpression();
+
+    // hwmon("chip", "label") channels are looked up in, or appended to,
+    // `channels` ("chip/label"); channel i is SensorValues::FirstChannel + i.
+    // Returns an invalid expression and sets `error` on a syntax error.
+    static SensorExpression compile(const QString &text, QStringList *channels, QString *error = nullptr);
+
+    bool isValid() const { return !m_program.isEmpty(); }
+    QString text() const { return m_text; }
+
+    // NaN if every source the result depends on is missing
+    double evaluate(const SensorValues &values) const;
+
+private:
+    struct Op {
+        enum Code { Constant, Load, Add, Subtract, Multiply, Divide, Negate, Max, Min, Avg, Blend };
+        Code code;
+        double value;   // Constant
+        int argument;   // Load: source index; Max/Min/Avg/Blend: argument count
+    };
+
+    friend class SensorExpressionParser;
+
+    QString m_text;
+    QVector<Op> m_program;
+};
+
+#endif // SENSOREXPRESSION_H
@@ -0,0 +1,93 @@
+#include "sensorring.h"
+#include <cstring>
+
+SensorRing::SensorRing(int capacity)
+    : m_mask(0)
+{
+    quint64 size = 1;
+    while (size < static_cast<quint64>(qMax(2, capacity))) {
+        size <<= 1;
+    }
+    m_mask = size - 1;
+
+    m_slots.reset(new Slot[size]);
+    for (quint64 i = 0; i < size; ++i) {
+        for (auto &word : m_slots[i].words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void SensorRing::push(SensorSample sample)
+{
+    const quint64 sequence = m_head.load(std::memory_order_relaxed) + 1;
+    sample.sequence = sequence;
+
+    quint64 words[kWords] = {};
+    std::memcpy(words, &sample, sizeof(sample));
+
+    Slot &slot = m_slots[sequence & m_mask];
+    const quint32 version = slot.version.load(std::memory_order_relaxed);
+
+    // Odd version: readers of this slot retry until the store is complete
+    slot.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < kWords; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.version.store(version + 2, std::memory_order_release);
+
+    m_head.store(sequence, std::memory_order_release);
+}
+
+bool SensorRing::readSlot(const Slot &slot, SensorSample &out) const
+{
+    quint64 words[kWords];
+
+    // The writer touches a slot once per `capacity` ticks, so a retry is
+    // rare and bounded in practice
+    for (;;) {
+        const quint32 before = slot.version.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        for (int i = 0; i < kWords; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) == before) {
+            break;
+        }
+    }
+
+    std::memcpy(&out, words, sizeof(out));
+    return out.sequence != 0;
+}
+
+bool SensorRing::latest(SensorSample &out) const
+{
+    const quint64 sequence = head();
+    return sequence != 0 && at(sequence, out);
+}
+
+bool SensorRing::at(quint64 sequence, SensorSample &out) const
+{
+    const quint64 newest = head();
+    if (sequence == 0 || sequence > newest || newest - sequence > m_mask) {
+        return false;
+    }
+
+    // The slot may have been reused since head() was read
+    return readSlot(m_slots[sequence & m_mask], out) && out.sequence == sequence;
+}
+
+int SensorRing::recent(SensorSample *out, int count) const
+{
+    quint64 sequence = head();
+    int copied = 0;
+    while (copied < count && sequence > 0 && at(sequence, out[copied])) {
+        ++copied;
+        --sequence;
+    }
+    return copied;
+}
@@ -0,0 +1,118 @@
+#ifndef SENSORRING_H
+#define SENSORRING_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// One control-loop step as seen by everyone downstream of the engine.
+// Plain data so it can be copied in and out of the ring word by word.
+struct SensorSample
+{
+    quint64 sequence = 0;              // 1-based push counter, 0 = empty
+    qint64 timestamp = 0;              // ms since the engine started
+    float temperature = 0.0f;          // last measured CPU temperature (°C)
+    float filteredTemperature = 0.0f;  // filtered CPU temperature
+    float portTemperature[4] = { 0.0f, 0.0f, 0.0f, 0.0f }; // filtered input of each port's curve
+    qint16 rpm[4] = { 0, 0, 0, 0 };    // last RPM commanded per port
+    quint8 duty[4] = { 0, 0, 0, 0 };   // percent handed to the driver per port
+    quint8 connectedMask = 0;          // bit N set = port N+1 has a fan
+    bool simulatedTemperature = false; // no real sensor could be read
+
+    bool isConnected(int port) const { return (connectedMask >> (port - 1)) & 1; }
+
+    // Same values on screen (temperature rounded like the UI shows it)
+    bool sameReadingAs(const SensorSample &other) const
+    {
+        if (qRound(temperature) != qRound(other.temperature) || connectedMask != other.connectedMask) {
+            return false;
+        }
+        for (int i = 0; i < 4; ++i) {
+            if (rpm[i] != other.rpm[i] || qRound(portTemperature[i]) != qRound(other.portTemperature[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Fixed-capacity single-producer / multi-consumer ring of SensorSamples.
+//
+// The fan control engine pushes one sample per tick; any thread may read
+// the newest sample or walk back through the retained history without
+// taking a lock. Each slot is a seqlock: the writer bumps the slot's
+// version to odd, stores the payload, and bumps it to even again; a reader
+// retries if it saw an odd version or the version changed under it. The
+// payload is kept in relaxed atomic words, so torn reads are detected
+// rather than being undefined behaviour.
+//
+// Readers never block the writer. A reader that falls more than a full
+// ring behind simply finds the slot overwritten and stops walking.
+class SensorRing
+{
+public:
+    // Capacity is rounded up to a power of two
+    explicit SensorRing(int capacity = 1024);
+
+    SensorRing(const SensorRing &) = delete;
+    SensorRing &operator=(const SensorRing &) = delete;
+
+    int capacity() const { return static_cast<int>(m_mask + 1); }
+
+    // Producer only
+    void push(SensorSample sample);
+
+    // Number of samples pushed so far (sequence of the newest one)
+    quint64 head() const { return m_head.load(std::memory_order_acquire); }
+
+    // Newest sample; false if nothing was pushed yet
+    bool latest(SensorSample &out) const;
+
+    // The sample with the given sequence, if it is still retained
+    bool at(quint64 sequence, SensorSample &out) const;
+
+    // Up to `count` newest samples, newest first; returns how many were copied
+    int recent(SensorSample *out, int count) const;
+
+    // Calls fn(sample) newest-first for every retained sample no older than
+    // windowMs relative to the newest; returns how many were visited
+    template <typename Fn>
+    int forEachInWindow(qint64 windowMs, Fn fn) const
+    {
+        SensorSample sample;
+        quint64 seq = head();
+        if (seq == 0 || !at(seq, sample)) {
+            return 0;
+        }
+
+        const qint64 newest = sample.timestamp;
+        int visited = 0;
+        do {
+            if (newest - sample.timestamp > windowMs) {
+                break;
+            }
+            fn(sample);
+            ++visited;
+        } while (--seq > 0 && at(seq, sample));
+        return visited;
+    }
+
+private:
+    static constexpr int kWords = (sizeof(SensorSample) + sizeof(quint64) - 1) / sizeof(quint64);
+    static_assert(std::is_trivially_copyable<SensorSample>::value, "SensorSample must be trivially copyable");
+
+    struct alignas(64) Slot {
+        std::atomic<quint32> version{0};
+        std::atomic<quint64> words[kWords];
+    };
+
+    bool readSlot(const Slot &slot, SensorSample &out) const;
+
+    std::unique_ptr<Slot[]> m_slots;
+    quint64 m_mask;
+    std::atomic<quint64> m_head{0};
+};
+
+#endif // SENSORRING_H
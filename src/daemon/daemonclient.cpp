@@ -0,0 +1,227 @@
+#include "daemonclient.h"
+#include <QLocalSocket>
+#include <QTimer>
+#include <QDebug>
+
+using DaemonProtocol::MessageType;
+
+DaemonClient::DaemonClient(QObject *parent)
+    : QObject(parent)
+    , m_socket(new QLocalSocket(this))
+    , m_reconnectTimer(new QTimer(this))
+    , m_pollTimer(new QTimer(this))
+    , m_telemetrySequence(0)
+    , m_helloReceived(false)
+    , m_ring(kHistoryCapacity)
+    , m_announcedOnce(false)
+    , m_publishInterval(0)
+{
+    connect(m_socket, &QLocalSocket::connected, this, &DaemonClient::onConnected);
+    connect(m_socket, &QLocalSocket::disconnected, this, &DaemonClient::onDisconnected);
+    connect(m_socket, &QLocalSocket::readyRead, this, &DaemonClient::onReadyRead);
+
+    m_reconnectTimer->setInterval(kReconnectInterval);
+    connect(m_reconnectTimer, &QTimer::timeout, this, &DaemonClient::reconnect);
+
+    connect(m_pollTimer, &QTimer::timeout, this, &DaemonClient::pollTelemetry);
+}
+
+DaemonClient::~DaemonClient()
+{
+    // Don't let the daemon keep publishing for us
+    disconnect(m_socket, nullptr, this, nullptr);
+    m_socket->abort();
+}
+
+bool DaemonClient::connectToDaemon(int timeoutMs)
+{
+    m_socket->connectToServer(DaemonProtocol::socketPath());
+    if (m_socket->waitForConnected(timeoutMs)) {
+        return true;
+    }
+    m_socket->abort();
+    m_reconnectTimer->start();
+    return false;
+}
+
+bool DaemonClient::isConnected() const
+{
+    return m_socket->state() == QLocalSocket::ConnectedState;
+}
+
+void DaemonClient::setPublishInterval(int ms)
+{
+    m_publishInterval = qMax(0, ms);
+    updateFeed();
+}
+
+void DaemonClient::setPortCurve(int port, const FanCurve &curve)
+{
+    if (curve.isValid()) {
+        send(DaemonProtocol::encode(MessageType::Curve, DaemonProtocol::curveMessage(port, curve)));
+    }
+}
+
+void DaemonClient::setPortStrategy(int port, FanControlStrategy::Kind kind)
+{
+    send(DaemonProtocol::encode(MessageType::Strategy, DaemonProtocol::strategyMessage(port, kind)));
+}
+
+void DaemonClient::setPortSensor(int port, const QString &expression)
+{
+    send(DaemonProtocol::encode(MessageType::Sensor, DaemonProtocol::sensorMessage(port, expression)));
+}
+
+void DaemonClient::setOutputParameters(const DutyOutputStage::Parameters &parameters)
+{
+    send(DaemonProtocol::encode(MessageType::Output, DaemonProtocol::outputMessage(parameters)));
+}
+
+void DaemonClient::setLighting(const LightingState &state)
+{
+    send(DaemonProtocol::encode(MessageType::Lighting, DaemonProtocol::lightingMessage(state)));
+}
+
+void DaemonClient::send(const QByteArray &frame)
+{
+    if (isConnected()) {
+        m_socket->write(frame);
+        m_socket->flush();
+    }
+}
+
+void DaemonClient::updateFeed()
+{
+    // Nothing is known about the page until the daemon said hello
+    if (!m_helloReceived) {
+        m_pollTimer->stop();
+        return;
+    }
+
+    if (m_telemetry.isOpen()) {
+        if (m_publishInterval > 0) {
+            m_pollTimer->start(m_publishInterval);
+            pollTelemetry();
+        } else {
+            m_pollTimer->stop();
+        }
+    } else {
+        send(DaemonProtocol::encode(MessageType::Publish, DaemonProtocol::Publish{ m_publishInterval }));
+    }
+}
+
+void DaemonClient::onConnected()
+{
+    m_reconnectTimer->stop();
+    m_reader.clear();
+    m_helloReceived = false;
+    send(DaemonProtocol::encode(MessageType::Hello, DaemonProtocol::hello()));
+    qDebug() << "Connected to llconnectd at" << DaemonProtocol::socketPath();
+    emit connected();
+}
+
+void DaemonClient::onDisconnected()
+{
+    m_pollTimer->stop();
+    m_telemetry.close();
+    m_helloReceived = false;
+    qWarning() << "Lost connection to llconnectd - retrying every" << kReconnectInterval << "ms";
+    m_reconnectTimer->start();
+    emit disconnected();
+}
+
+void DaemonClient::reconnect()
+{
+    if (m_socket->state() == QLocalSocket::UnconnectedState) {
+        m_socket->connectToServer(DaemonProtocol::socketPath());
+    }
+}
+
+void DaemonClient::handleHello(const QByteArray &payload)
+{
+    DaemonProtocol::Hello hello;
+    if (!DaemonProtocol::decode(payload, &hello) || hello.version != DaemonProtocol::kVersion
+        || hello.sampleSize != sizeof(SensorSample)) {
+        qWarning() << "llconnectd speaks another protocol version - expected" << DaemonProtocol::kVersion;
+        m_socket->disconnectFromServer();
+        return;
+    }
+
+    const QString name = QString::fromLocal8Bit(hello.telemetryName, qstrnlen(hello.telemetryName, sizeof(hello.telemetryName)));
+    m_telemetry.close();
+    if (!name.isEmpty() && !m_telemetry.open(name)) {
+        qWarning() << "Cannot map llconnectd telemetry" << name << "- using the socket feed";
+    }
+    // A restarted daemon starts counting again
+    m_telemetrySequence = 0;
+    m_helloReceived = true;
+    updateFeed();
+}
+
+void DaemonClient::onReadyRead()
+{
+    m_reader.append(m_socket->readAll());
+
+    // Only the newest sample matters to the UI, but every one goes into
+    // the history
+    const quint64 before = m_ring.head();
+    MessageType type;
+    QByteArray payload;
+    while (m_reader.next(&type, &payload)) {
+        SensorSample sample;
+        if (type == MessageType::Sample && DaemonProtocol::decode(payload, &sample)) {
+            m_ring.push(sample);
+        } else if (type == MessageType::Hello) {
+            handleHello(payload);
+        }
+    }
+
+    if (m_reader.hasError()) {
+        qWarning() << "llconnectd sent a broken frame - reconnecting";
+        m_socket->abort();
+        return;
+    }
+
+    if (m_ring.head() != before) {
+        announce();
+    }
+}
+
+void DaemonClient::pollTelemetry()
+{
+    const quint64 newest = m_telemetry.head();
+    if (newest == m_telemetrySequence) {
+        return;
+    }
+
+    // Samples older than the page holds are gone; start from the oldest left
+    quint64 sequence = m_telemetrySequence + 1;
+    if (newest < sequence || newest - sequence >= TelemetryPage::kCapacity) {
+        sequence = newest >= TelemetryPage::kCapacity ? newest - TelemetryPage::kCapacity + 1 : 1;
+    }
+
+    for (; sequence <= newest; ++sequence) {
+        SensorSample sample;
+        if (m_telemetry.at(sequence, sample)) {
+            m_ring.push(sample);
+        }
+    }
+    m_telemetrySequence = newest;
+    announce();
+}
+
+void DaemonClient::announce()
+{
+    SensorSample sample;
+    if (!m_ring.latest(sample)) {
+        return;
+    }
+
+    // Nothing the UI shows has changed - don't wake it up
+    if (m_announcedOnce && sample.sameReadingAs(m_lastAnnounced)) {
+        return;
+    }
+    m_lastAnnounced = sample;
+    m_announcedOnce = true;
+    emit samplesPublished(sample.sequence);
+}
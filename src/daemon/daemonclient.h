@@ -0,0 +1,82 @@
+#ifndef DAEMONCLIENT_H
+#define DAEMONCLIENT_H
+
+#include <QObject>
+#include <QByteArray>
+#include "control/sensorring.h"
+#include "control/fancurve.h"
+#include "daemon/daemonprotocol.h"
+#include "daemon/telemetrypage.h"
+#include "lighting/lightingstate.h"
+
+class QLocalSocket;
+class QTimer;
+
+// The GUI's connection to llconnectd. Mirrors the parts of FanControlEngine
+// FanProfilePage uses: samples arrive in a local SensorRing and are
+// announced with samplesPublished(); fan control and lighting edits are
+// sent to the daemon. Samples are read from the daemon's shared
+// TelemetryPage at the publish interval, or requested over the socket if
+// the page can't be mapped. If the daemon goes away the client keeps retrying, and resumes
+// the feed once it is back.
+class DaemonClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kReconnectInterval = 2000;   // ms
+    static constexpr int kHistoryCapacity = 256;      // samples kept locally
+
+    explicit DaemonClient(QObject *parent = nullptr);
+    ~DaemonClient();
+
+    // Blocks for at most timeoutMs; false if no daemon answers yet, in
+    // which case it keeps retrying and emits connected() once one does
+    bool connectToDaemon(int timeoutMs = 200);
+    bool isConnected() const;
+
+    // Samples received from the daemon, newest last
+    const SensorRing &sensorRing() const { return m_ring; }
+
+public slots:
+    // 0 stops the feed
+    void setPublishInterval(int ms);
+    void setPortCurve(int port, const FanCurve &curve);
+    void setPortStrategy(int port, FanControlStrategy::Kind kind);
+    void setPortSensor(int port, const QString &expression);
+    void setOutputParameters(const DutyOutputStage::Parameters &parameters);
+    void setLighting(const LightingState &state);
+
+signals:
+    void samplesPublished(quint64 sequence);
+    // (Re)connected; curves edited while the daemon was away should be sent again
+    void connected();
+    void disconnected();
+
+private slots:
+    void onConnected();
+    void onDisconnected();
+    void onReadyRead();
+    void reconnect();
+    void pollTelemetry();
+
+private:
+    void send(const QByteArray &frame);
+    void handleHello(const QByteArray &payload);
+    void updateFeed();
+    void announce();
+
+    QLocalSocket *m_socket;
+    QTimer *m_reconnectTimer;
+    QTimer *m_pollTimer;
+    DaemonProtocol::FrameReader m_reader;
+    TelemetryPage m_telemetry;
+    quint64 m_telemetrySequence;    // newest page sample copied so far
+    bool m_helloReceived;
+    SensorRing m_ring;
+    SensorSample m_lastAnnounced;
+    bool m_announcedOnce;
+    int m_publishInterval;
+};
+
+#endif // DAEMONCLIENT_H
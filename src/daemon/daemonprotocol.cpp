@@ -0,0 +1,237 @@
+#include "daemonprotocol.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <cmath>
+#include <unistd.h>
+
+namespace DaemonProtocol {
+
+static_assert(sizeof(FrameHeader) == 8, "FrameHeader layout");
+static_assert(sizeof(Hello) == 64, "Hello layout");
+static_assert(sizeof(SensorMessage) == 128, "SensorMessage layout");
+static_assert(sizeof(OutputMessage) == 8, "OutputMessage layout");
+static_assert(sizeof(LightingMessage) == 104, "LightingMessage layout");
+
+QString socketPath()
+{
+    QString runtime = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    if (runtime.isEmpty()) {
+        runtime = QDir::tempPath();
+    }
+    return QDir(runtime).filePath("llconnectd.sock");
+}
+
+QString fanControlLockPath()
+{
+    return QFileInfo(socketPath()).dir().filePath("llconnectd.lock");
+}
+
+QString telemetryName()
+{
+    return QString("/llconnectd-%1").arg(::getuid());
+}
+
+Hello hello(const QString &telemetryName)
+{
+    Hello message = {};
+    message.version = kVersion;
+    message.sampleSize = sizeof(SensorSample);
+    const QByteArray name = telemetryName.toLocal8Bit();
+    if (name.size() < static_cast<int>(sizeof(message.telemetryName))) {
+        std::memcpy(message.telemetryName, name.constData(), name.size());
+    }
+    return message;
+}
+
+CurveMessage curveMessage(int port, const FanCurve &curve)
+{
+    CurveMessage message = {};
+    message.port = static_cast<quint8>(port);
+    message.interpolation = static_cast<quint8>(curve.interpolation());
+
+    const QVector<QPointF> &points = curve.points();
+    message.count = static_cast<quint16>(qMin<int>(points.size(), kMaxCurvePoints));
+    for (int i = 0; i < message.count; ++i) {
+        message.points[i].temperature = static_cast<float>(points[i].x());
+        message.points[i].rpm = static_cast<float>(points[i].y());
+    }
+    return message;
+}
+
+bool parseCurve(const CurveMessage &message, int *port, FanCurve *curve)
+{
+    if (message.port < 1 || message.port > 4 || message.count < 2 || message.count > kMaxCurvePoints
+        || message.interpolation > static_cast<quint8>(FanCurve::Interpolation::Step)) {
+        return false;
+    }
+
+    QVector<QPointF> points;
+    points.reserve(message.count);
+    for (int i = 0; i < message.count; ++i) {
+        const float t = message.points[i].temperature;
+        const float rpm = message.points[i].rpm;
+        if (!std::isfinite(t) || !std::isfinite(rpm)) {
+            return false;
+        }
+        points.append(QPointF(t, rpm));
+    }
+
+    *port = message.port;
+    *curve = FanCurve(points, static_cast<FanCurve::Interpolation>(message.interpolation));
+    return curve->isValid();
+}
+
+StrategyMessage strategyMessage(int port, FanControlStrategy::Kind kind)
+{
+    StrategyMessage message = {};
+    message.port = static_cast<quint8>(port);
+    message.kind = static_cast<quint8>(kind);
+    return message;
+}
+
+bool parseStrategy(const StrategyMessage &message, int *port, FanControlStrategy::Kind *kind)
+{
+    if (message.port < 1 || message.port > 4
+        || message.kind > static_cast<quint8>(FanControlStrategy::Kind::Predictive)) {
+        return false;
+    }
+    *port = message.port;
+    *kind = static_cast<FanControlStrategy::Kind>(message.kind);
+    return true;
+}
+
+SensorMessage sensorMessage(int port, const QString &expression)
+{
+    SensorMessage message = {};
+    message.port = static_cast<quint8>(port);
+    const QByteArray text = expression.toUtf8();
+    std::memcpy(message.expression, text.constData(), qMin<int>(text.size(), sizeof(message.expression) - 1));
+    return message;
+}
+
+bool parseSensor(const SensorMessage &message, int *port, QString *expression)
+{
+    const int length = static_cast<int>(qstrnlen(message.expression, sizeof(message.expression)));
+    if (message.port < 1 || message.port > 4 || length == 0 || length == sizeof(message.expression)) {
+        return false;
+    }
+    *port = message.port;
+    *expression = QString::fromUtf8(message.expression, length);
+    return true;
+}
+
+OutputMessage outputMessage(const DutyOutputStage::Parameters &parameters)
+{
+    OutputMessage message = {};
+    message.hysteresis = static_cast<quint8>(qBound(0, parameters.hysteresis, 100));
+    message.minDwell = static_cast<float>(parameters.minDwell);
+    return message;
+}
+
+bool parseOutput(const OutputMessage &message, DutyOutputStage::Parameters *parameters)
+{
+    if (message.hysteresis > 100 || !std::isfinite(message.minDwell) || message.minDwell < 0) {
+        return false;
+    }
+    parameters->hysteresis = message.hysteresis;
+    parameters->minDwell = message.minDwell;
+    return true;
+}
+
+LightingMessage lightingMessage(const LightingState &state)
+{
+    LightingMessage message = {};
+    const QByteArray effect = state.effect.toUtf8();
+    std::memcpy(message.effect, effect.constData(), qMin<int>(effect.size(), sizeof(message.effect) - 1));
+    message.selectedPort = static_cast<qint8>(state.selectedPort);
+    message.speed = static_cast<quint8>(qBound(0, state.speed, 100));
+    message.brightness = static_cast<quint8>(qBound(0, state.brightness, 100));
+    message.directionLeft = state.directionLeft ? 1 : 0;
+    message.software = state.software ? 1 : 0;
+    for (int port = 0; port < 4; ++port) {
+        if (state.portEnabled[port]) {
+            message.enabledMask |= 1 << port;
+        }
+        for (int i = 0; i < 4; ++i) {
+            const QColor &color = state.colors[port][i];
+            quint8 *rgbv = message.colors[port][i];
+            if (color.isValid()) {
+                rgbv[0] = static_cast<quint8>(color.red());
+                rgbv[1] = static_cast<quint8>(color.green());
+                rgbv[2] = static_cast<quint8>(color.blue());
+                rgbv[3] = 1;
+            }
+        }
+    }
+    return message;
+}
+
+bool parseLighting(const LightingMessage &message, LightingState *state)
+{
+    const int length = static_cast<int>(qstrnlen(message.effect, sizeof(message.effect)));
+    if (length == 0 || length == sizeof(message.effect) || message.selectedPort < -1 || message.selectedPort > 3
+        || message.speed > 100 || message.brightness > 100) {
+        return false;
+    }
+
+    LightingState parsed;
+    parsed.effect = QString::fromUtf8(message.effect, length);
+    parsed.selectedPort = message.selectedPort;
+    parsed.speed = message.speed;
+    parsed.brightness = message.brightness;
+    parsed.directionLeft = message.directionLeft != 0;
+    parsed.software = message.software != 0;
+    for (int port = 0; port < 4; ++port) {
+        parsed.portEnabled[port] = (message.enabledMask >> port) & 1;
+        for (int i = 0; i < 4; ++i) {
+            const quint8 *rgbv = message.colors[port][i];
+            parsed.colors[port][i] = rgbv[3] ? QColor(rgbv[0], rgbv[1], rgbv[2]) : QColor();
+        }
+    }
+    *state = parsed;
+    return true;
+}
+
+void FrameReader::append(const QByteArray &data)
+{
+    // Drop what was already handed out before growing the buffer
+    if (m_offset > 0) {
+        m_buffer.remove(0, m_offset);
+        m_offset = 0;
+    }
+    m_buffer += data;
+}
+
+bool FrameReader::next(MessageType *type, QByteArray *payload)
+{
+    if (m_error || m_buffer.size() - m_offset < static_cast<int>(sizeof(FrameHeader))) {
+        return false;
+    }
+
+    FrameHeader header;
+    std::memcpy(&header, m_buffer.constData() + m_offset, sizeof(header));
+    if (header.size > kMaxPayload) {
+        m_error = true;
+        return false;
+    }
+
+    const int frameSize = static_cast<int>(sizeof(header) + header.size);
+    if (m_buffer.size() - m_offset < frameSize) {
+        return false;
+    }
+
+    *type = static_cast<MessageType>(header.type);
+    *payload = m_buffer.mid(m_offset + sizeof(header), header.size);
+    m_offset += frameSize;
+    return true;
+}
+
+void FrameReader::clear()
+{
+    m_buffer.clear();
+    m_offset = 0;
+    m_error = false;
+}
+
+} // namespace DaemonProtocol
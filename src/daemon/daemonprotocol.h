@@ -0,0 +1,184 @@
+#ifndef DAEMONPROTOCOL_H
+#define DAEMONPROTOCOL_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <cstring>
+#include <type_traits>
+#include "control/fancurve.h"
+#include "control/fancontrolstrategy.h"
+#include "control/dutyoutputstage.h"
+#include "control/sensorring.h"
+#include "lighting/lightingstate.h"
+
+// Binary protocol between llconnectd and the GUI over a UNIX socket.
+//
+// Every message is a FrameHeader followed by `size` payload bytes; each
+// payload is one of the fixed-size structs below, copied as is. Both ends
+// run on the same machine, so fields are in native byte order. Unknown
+// message types are skipped so either side can be newer; a different
+// kVersion in Hello means the layouts differ and the connection is closed.
+//
+//   both    Hello      version, SensorSample size, telemetry page name
+//   client  Publish    socket sample feed interval, 0 = off
+//   client  Curve      one port's curve points
+//   client  Strategy   controller a port's curve is run by
+//   client  Sensor     sensor expression a port's curve follows
+//   client  Output     hysteresis and dwell of every port's output stage
+//   client  Lighting   effect to apply (the daemon owns the hub)
+//   client  Ping       echoed back unchanged as Pong
+//   daemon  Sample     one SensorSample, for clients without the page
+//
+// Samples normally don't go over the socket at all: the daemon pushes
+// every tick into a shared TelemetryPage, which clients map and poll.
+namespace DaemonProtocol {
+
+constexpr quint16 kVersion = 2;
+constexpr quint32 kMaxPayload = 64 * 1024;
+constexpr int kMaxCurvePoints = 32;
+
+enum class MessageType : quint16 {
+    Hello = 1,
+    Publish = 2,
+    Curve = 3,
+    Sample = 4,
+    Lighting = 5,
+    Ping = 6,
+    Pong = 7,
+    Strategy = 8,
+    Sensor = 9,
+    Output = 10,
+};
+
+struct FrameHeader {
+    quint32 size;       // payload bytes after the header
+    quint16 type;       // MessageType
+    quint16 reserved;
+};
+
+struct Hello {
+    quint16 version;
+    quint16 reserved;
+    quint32 sampleSize;         // sizeof(SensorSample) of the sender
+    char telemetryName[56];     // shm name of the daemon's page, "" = none
+};
+
+struct Publish {
+    qint32 intervalMs;
+};
+
+struct CurveMessage {
+    quint8 port;                // 1-4
+    quint8 interpolation;       // FanCurve::Interpolation
+    quint16 count;
+    struct { float temperature; float rpm; } points[kMaxCurvePoints];
+};
+
+struct StrategyMessage {
+    quint8 port;                // 1-4
+    quint8 kind;                // FanControlStrategy::Kind
+    quint16 reserved;
+};
+
+struct SensorMessage {
+    quint8 port;                // 1-4
+    quint8 reserved[3];
+    char expression[124];       // SensorExpression text, NUL terminated
+};
+
+struct OutputMessage {
+    quint8 hysteresis;          // percent
+    quint8 reserved[3];
+    float minDwell;             // s
+};
+
+struct LightingMessage {
+    char effect[32];            // UI name, NUL terminated
+    qint8 selectedPort;         // -1 = all
+    quint8 enabledMask;         // bit N = port N+1
+    quint8 speed;
+    quint8 brightness;
+    quint8 directionLeft;
+    quint8 software;            // LightingState::software
+    quint8 reserved[2];
+    quint8 colors[4][4][4];     // [port][index] r, g, b, valid
+};
+
+struct Ping {
+    quint64 id;
+    qint64 sent;                // sender's clock, returned untouched
+};
+
+// $XDG_RUNTIME_DIR/llconnectd.sock
+QString socketPath();
+// $XDG_RUNTIME_DIR/llconnectd.lock, see FanControlLock
+QString fanControlLockPath();
+// Default shm name of the daemon's TelemetryPage, per user
+QString telemetryName();
+
+template <typename T>
+QByteArray encode(MessageType type, const T &payload)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "payloads are copied byte for byte");
+
+    FrameHeader header = { sizeof(T), static_cast<quint16>(type), 0 };
+    QByteArray frame(sizeof(header) + sizeof(T), Qt::Uninitialized);
+    std::memcpy(frame.data(), &header, sizeof(header));
+    std::memcpy(frame.data() + sizeof(header), &payload, sizeof(T));
+    return frame;
+}
+
+// False unless the payload is exactly one T
+template <typename T>
+bool decode(const QByteArray &payload, T *out)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "payloads are copied byte for byte");
+
+    if (payload.size() != static_cast<int>(sizeof(T))) {
+        return false;
+    }
+    std::memcpy(out, payload.constData(), sizeof(T));
+    return true;
+}
+
+Hello hello(const QString &telemetryName = QString());
+
+CurveMessage curveMessage(int port, const FanCurve &curve);
+// False for a port or point list the engine can't use
+bool parseCurve(const CurveMessage &message, int *port, FanCurve *curve);
+
+StrategyMessage strategyMessage(int port, FanControlStrategy::Kind kind);
+bool parseStrategy(const StrategyMessage &message, int *port, FanControlStrategy::Kind *kind);
+
+SensorMessage sensorMessage(int port, const QString &expression);
+// Only checks the framing; the engine compiles the expression
+bool parseSensor(const SensorMessage &message, int *port, QString *expression);
+
+OutputMessage outputMessage(const DutyOutputStage::Parameters &parameters);
+bool parseOutput(const OutputMessage &message, DutyOutputStage::Parameters *parameters);
+
+LightingMessage lightingMessage(const LightingState &state);
+bool parseLighting(const LightingMessage &message, LightingState *state);
+
+// Splits a byte stream into frames
+class FrameReader
+{
+public:
+    void append(const QByteArray &data);
+    // The next complete frame; false if it hasn't fully arrived yet or the
+    // stream is broken (see hasError())
+    bool next(MessageType *type, QByteArray *payload);
+    // A frame claimed more than kMaxPayload; the peer isn't speaking this protocol
+    bool hasError() const { return m_error; }
+    void clear();
+
+private:
+    QByteArray m_buffer;
+    int m_offset = 0;
+    bool m_error = false;
+};
+
+} // namespace DaemonProtocol
+
+#endif // DAEMONPROTOCOL_H
@@ -0,0 +1,201 @@
+#include "daemonserver.h"
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QDebug>
+
+using DaemonProtocol::MessageType;
+
+// Samples are skipped for a client that stopped reading, instead of queueing
+static constexpr qint64 kMaxBacklog = 64 * 1024;
+
+DaemonServer::DaemonServer(QObject *parent)
+    : QObject(parent)
+    , m_server(new QLocalServer(this))
+{
+    connect(m_server, &QLocalServer::newConnection, this, &DaemonServer::onNewConnection);
+}
+
+DaemonServer::~DaemonServer()
+{
+    m_server->close();
+}
+
+bool DaemonServer::listen(const QString &path, const QString &telemetryName)
+{
+    // A socket file is left behind when a daemon dies; only remove it if
+    // nobody answers on it
+    QLocalSocket probe;
+    probe.connectToServer(path);
+    if (probe.waitForConnected(200)) {
+        m_error = QString("another llconnectd is already running on %1").arg(path);
+        return false;
+    }
+    QLocalServer::removeServer(path);
+
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    if (!m_server->listen(path)) {
+        m_error = m_server->errorString();
+        return false;
+    }
+
+    // Not fatal: clients then get samples over the socket
+    m_telemetryName.clear();
+    if (!telemetryName.isEmpty()) {
+        if (m_telemetry.create(telemetryName)) {
+            m_telemetryName = telemetryName;
+        } else {
+            qWarning() << "Telemetry page" << telemetryName << "not available - samples go over the socket";
+        }
+    }
+    return true;
+}
+
+void DaemonServer::publishSample(const SensorSample &sample)
+{
+    m_latest = sample;
+    m_telemetry.push(sample);
+
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        Client &client = it.value();
+        if (client.publishInterval > 0 && sample.timestamp - client.lastSent >= client.publishInterval) {
+            sendSample(it.key(), client, sample);
+        }
+    }
+}
+
+void DaemonServer::sendSample(QLocalSocket *socket, Client &client, const SensorSample &sample)
+{
+    if (socket->bytesToWrite() >= kMaxBacklog) {
+        return;
+    }
+    socket->write(DaemonProtocol::encode(MessageType::Sample, sample));
+    socket->flush();
+    client.lastSent = sample.timestamp;
+}
+
+void DaemonServer::onNewConnection()
+{
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        m_clients.insert(socket, Client());
+        connect(socket, &QLocalSocket::readyRead, this, &DaemonServer::onReadyRead);
+        // Queued: a socket dropped while one of its messages is handled must
+        // stay valid until that returns
+        connect(socket, &QLocalSocket::disconnected, this, &DaemonServer::onDisconnected, Qt::QueuedConnection);
+        socket->write(DaemonProtocol::encode(MessageType::Hello, DaemonProtocol::hello(m_telemetryName)));
+        socket->flush();
+        qDebug() << "GUI connected," << m_clients.size() << "client(s)";
+    }
+}
+
+void DaemonServer::onReadyRead()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    auto it = m_clients.find(socket);
+    if (it == m_clients.end()) {
+        return;
+    }
+
+    Client &client = it.value();
+    client.reader.append(socket->readAll());
+
+    MessageType type;
+    QByteArray payload;
+    while (client.reader.next(&type, &payload)) {
+        handleMessage(socket, client, type, payload);
+    }
+
+    if (client.reader.hasError()) {
+        qWarning() << "Dropping client: not speaking protocol" << DaemonProtocol::kVersion;
+        socket->abort();
+    }
+}
+
+void DaemonServer::onDisconnected()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    if (m_clients.remove(socket) == 0) {
+        return;
+    }
+    socket->deleteLater();
+    qDebug() << "GUI disconnected," << m_clients.size() << "client(s)";
+}
+
+void DaemonServer::handleMessage(QLocalSocket *socket, Client &client, MessageType type, const QByteArray &payload)
+{
+    switch (type) {
+    case MessageType::Hello: {
+        DaemonProtocol::Hello hello;
+        if (!DaemonProtocol::decode(payload, &hello) || hello.version != DaemonProtocol::kVersion
+            || hello.sampleSize != sizeof(SensorSample)) {
+            qWarning() << "Client speaks another protocol version - expected" << DaemonProtocol::kVersion;
+            socket->disconnectFromServer();
+        }
+        break;
+    }
+    case MessageType::Publish: {
+        DaemonProtocol::Publish publish;
+        if (DaemonProtocol::decode(payload, &publish)) {
+            client.publishInterval = qMax(0, publish.intervalMs);
+            // A new subscriber starts from the newest sample
+            if (client.publishInterval > 0 && m_latest.sequence != 0) {
+                sendSample(socket, client, m_latest);
+            }
+        }
+        break;
+    }
+    case MessageType::Curve: {
+        DaemonProtocol::CurveMessage message;
+        int port = 0;
+        FanCurve curve;
+        if (DaemonProtocol::decode(payload, &message) && DaemonProtocol::parseCurve(message, &port, &curve)) {
+            emit curveChanged(port, curve);
+        }
+        break;
+    }
+    case MessageType::Strategy: {
+        DaemonProtocol::StrategyMessage message;
+        int port = 0;
+        FanControlStrategy::Kind kind;
+        if (DaemonProtocol::decode(payload, &message) && DaemonProtocol::parseStrategy(message, &port, &kind)) {
+            emit strategyChanged(port, kind);
+        }
+        break;
+    }
+    case MessageType::Sensor: {
+        DaemonProtocol::SensorMessage message;
+        int port = 0;
+        QString expression;
+        if (DaemonProtocol::decode(payload, &message) && DaemonProtocol::parseSensor(message, &port, &expression)) {
+            emit sensorChanged(port, expression);
+        }
+        break;
+    }
+    case MessageType::Output: {
+        DaemonProtocol::OutputMessage message;
+        DutyOutputStage::Parameters parameters;
+        if (DaemonProtocol::decode(payload, &message) && DaemonProtocol::parseOutput(message, &parameters)) {
+            emit outputChanged(parameters);
+        }
+        break;
+    }
+    case MessageType::Lighting: {
+        DaemonProtocol::LightingMessage message;
+        LightingState state;
+        if (DaemonProtocol::decode(payload, &message) && DaemonProtocol::parseLighting(message, &state)) {
+            emit lightingChanged(state);
+        }
+        break;
+    }
+    case MessageType::Ping: {
+        DaemonProtocol::Ping ping;
+        if (DaemonProtocol::decode(payload, &ping)) {
+            socket->write(DaemonProtocol::encode(MessageType::Pong, ping));
+            socket->flush();
+        }
+        break;
+    }
+    default:
+        // Newer client; nothing we understand
+        break;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef DAEMONSERVER_H
+#define DAEMONSERVER_H
+
+#include <QObject>
+#include <QHash>
+#include "control/fancurve.h"
+#include "control/sensorring.h"
+#include "daemon/daemonprotocol.h"
+#include "daemon/telemetrypage.h"
+#include "lighting/lightingstate.h"
+
+class QLocalServer;
+class QLocalSocket;
+
+// llconnectd's end of the GUI connection (see DaemonProtocol). Every sample
+// handed to publishSample() goes into the shared TelemetryPage; clients
+// that couldn't map the page and asked for a feed also get it over the
+// socket, at most once per their interval. Fan control and lighting edits
+// from clients come out as signals, so the server knows nothing about the
+// engine or the hub it runs next to.
+class DaemonServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DaemonServer(QObject *parent = nullptr);
+    ~DaemonServer();
+
+    // Fails if another daemon already answers on the socket. Without a
+    // telemetry page (empty name, or no shm) clients fall back to Sample
+    // messages.
+    bool listen(const QString &path, const QString &telemetryName);
+    QString errorString() const { return m_error; }
+
+public slots:
+    // Every control step
+    void publishSample(const SensorSample &sample);
+
+signals:
+    void curveChanged(int port, const FanCurve &curve);
+    void strategyChanged(int port, FanControlStrategy::Kind kind);
+    void sensorChanged(int port, const QString &expression);
+    void outputChanged(const DutyOutputStage::Parameters &parameters);
+    void lightingChanged(const LightingState &state);
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+
+private:
+    struct Client {
+        DaemonProtocol::FrameReader reader;
+        int publishInterval = 0; // ms, 0 = no socket feed
+        qint64 lastSent = 0;     // timestamp of the last sample sent
+    };
+
+    void handleMessage(QLocalSocket *socket, Client &client, DaemonProtocol::MessageType type, const QByteArray &payload);
+    void sendSample(QLocalSocket *socket, Client &client, const SensorSample &sample);
+
+    QLocalServer *m_server;
+    QHash<QLocalSocket *, Client> m_clients;
+    TelemetryPage m_telemetry;
+    QString m_telemetryName;
+    SensorSample m_latest;
+    QString m_error;
+};
+
+#endif // DAEMONSERVER_H
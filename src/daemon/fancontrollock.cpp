@@ -0,0 +1,38 @@
+#include "fancontrollock.h"
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+FanControlLock::~FanControlLock()
+{
+    release();
+}
+
+bool FanControlLock::tryAcquire(const QString &path)
+{
+    if (m_fd >= 0) {
+        return true;
+    }
+
+    const QByteArray file = path.toLocal8Bit();
+    int fd = ::open(file.constData(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    if (::flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        ::close(fd);
+        return false;
+    }
+    m_fd = fd;
+    return true;
+}
+
+void FanControlLock::release()
+{
+    if (m_fd < 0) {
+        return;
+    }
+    // Closing the only descriptor drops the lock
+    ::close(m_fd);
+    m_fd = -1;
+}
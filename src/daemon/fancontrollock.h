@@ -0,0 +1,28 @@
+#ifndef FANCONTROLLOCK_H
+#define FANCONTROLLOCK_H
+
+#include <QString>
+
+// Held by whichever process runs a FanControlEngine, so the GUI's own loop
+// and llconnectd never drive the ports at the same time. An flock() on
+// $XDG_RUNTIME_DIR/llconnectd.lock: the kernel drops it when the holder
+// exits or crashes, so a leftover file never blocks anyone.
+class FanControlLock
+{
+public:
+    FanControlLock() = default;
+    ~FanControlLock();
+
+    FanControlLock(const FanControlLock &) = delete;
+    FanControlLock &operator=(const FanControlLock &) = delete;
+
+    // Never blocks; false while another process holds it
+    bool tryAcquire(const QString &path);
+    void release();
+    bool isHeld() const { return m_fd >= 0; }
+
+private:
+    int m_fd = -1;
+};
+
+#endif // FANCONTROLLOCK_H
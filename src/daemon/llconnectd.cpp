@@ -0,0 +1,179 @@
+// llconnectd - headless fan control daemon
+//
+// Runs FanControlEngine with only Qt Core, so the fans follow their curves
+// whether or not the GUI is open (or has crashed). Curves, strategies and
+// sensors come from the same settings the GUI saves; a running GUI connects
+// over a UNIX socket (see DaemonProtocol) for live edits, and reads the
+// samples from a shared telemetry page. While connected, the GUI's lighting
+// changes are applied from here too, so only one process talks to the hub.
+// A GUI started without the daemon runs its own loop and holds the
+// FanControlLock; the daemon leaves the fans alone until that GUI connects
+// here and lets go of it.
+//
+//   llconnectd                      normally started by systemd --user
+//   llconnectd --socket /tmp/ll.sock
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QSocketNotifier>
+#include <QThread>
+#include <QTimer>
+#include <QDebug>
+#include <csignal>
+#include <cstdio>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "control/fancontrolengine.h"
+#include "daemon/daemonprotocol.h"
+#include "daemon/daemonserver.h"
+#include "daemon/fancontrollock.h"
+#include "lian_li_qt_integration.h"
+#include "lighting/lightingstate.h"
+#include "sensors/sensorservice.h"
+#include "utils/debugutil.h"
+#include "utils/driversettings.h"
+#include "utils/trace.h"
+
+// How often to check whether a GUI's own fan loop has let go (ms)
+static constexpr int kLockRetryInterval = 1000;
+
+// Written by the signal handler, read by the event loop
+static int s_signalPipe[2] = { -1, -1 };
+
+static void onTerminate(int)
+{
+    char byte = 1;
+    ssize_t written = ::write(s_signalPipe[1], &byte, 1);
+    Q_UNUSED(written);
+}
+
+// Warnings always; debug output only with Debug/Enabled, like the GUI
+static void messageHandler(QtMsgType type, const QMessageLogContext &, const QString &msg)
+{
+    if (type == QtDebugMsg || type == QtInfoMsg) {
+        if (!DebugUtil::isDebugEnabled()) {
+            return;
+        }
+        fprintf(stdout, "%s\n", msg.toLocal8Bit().constData());
+        fflush(stdout);
+        return;
+    }
+    fprintf(stderr, "%s\n", msg.toLocal8Bit().constData());
+    if (type == QtFatalMsg) {
+        abort();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("llconnectd");
+    qInstallMessageHandler(messageHandler);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("LL-Connect 3 fan control daemon");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "socket", "Listen here instead of $XDG_RUNTIME_DIR/llconnectd.sock.", "path" },
+        { "telemetry", "Shared memory name of the telemetry page.", "name", DaemonProtocol::telemetryName() },
+        { "tick", "Control tick in ms.", "ms", QString::number(FanControlEngine::kDefaultTickInterval) },
+    });
+    parser.process(app);
+
+    // SIGTERM (systemd) and SIGINT end the event loop, so the engine and the
+    // sensor thread shut down normally
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, s_signalPipe) != 0) {
+        qCritical() << "llconnectd: cannot create the signal pipe";
+        return 1;
+    }
+    QSocketNotifier signalNotifier(s_signalPipe[0], QSocketNotifier::Read);
+    QObject::connect(&signalNotifier, &QSocketNotifier::activated, &app, &QCoreApplication::quit);
+    std::signal(SIGTERM, onTerminate);
+    std::signal(SIGINT, onTerminate);
+
+    const QString tracePath = qEnvironmentVariable("LLCONNECT_TRACE");
+    if (!tracePath.isEmpty()) {
+        Trace::start();
+    }
+
+    // Port configuration and driver logging as saved in the GUI's settings
+    DriverSettings::applySaved();
+
+    // Only the temperatures a curve can follow; nothing here shows the rest
+    QThread sensorThread;
+    sensorThread.setObjectName("Sensors");
+    SensorService *sensorService = new SensorService();
+    sensorService->setScope(SensorService::Scope::Temperatures);
+    sensorService->moveToThread(&sensorThread);
+    QObject::connect(&sensorThread, &QThread::started, sensorService, &SensorService::start);
+    QObject::connect(&sensorThread, &QThread::finished, sensorService, &QObject::deleteLater);
+    sensorThread.start();
+
+    // The engine and the socket share the main thread; neither does much
+    FanControlEngine engine;
+    engine.setSensorService(sensorService);
+    engine.setTickInterval(parser.value("tick").toInt());
+
+    // Lighting effects sent by the GUI; the hub is opened on demand
+    LianLiQtIntegration &lighting = *LianLiQtIntegration::shared();
+    QObject::connect(&lighting, &LianLiQtIntegration::errorOccurred, [](const QString &error) {
+        qWarning() << "llconnectd:" << error;
+    });
+
+    DaemonServer server;
+    QObject::connect(&engine, &FanControlEngine::stepped, &server, &DaemonServer::publishSample);
+    QObject::connect(&server, &DaemonServer::curveChanged, &engine, &FanControlEngine::setPortCurve);
+    QObject::connect(&server, &DaemonServer::strategyChanged, &engine, &FanControlEngine::setPortStrategy);
+    QObject::connect(&server, &DaemonServer::sensorChanged, &engine, &FanControlEngine::setPortSensor);
+    QObject::connect(&server, &DaemonServer::outputChanged, &engine, &FanControlEngine::setOutputParameters);
+    QObject::connect(&server, &DaemonServer::lightingChanged, &lighting, [&lighting](const LightingState &state) {
+        if (!lighting.isConnected() && !lighting.initialize()) {
+            qWarning() << "llconnectd: hub not connected - lighting not applied";
+            return;
+        }
+        state.apply(lighting);
+    });
+
+    const QString socketPath = parser.isSet("socket") ? parser.value("socket") : DaemonProtocol::socketPath();
+    if (!server.listen(socketPath, parser.value("telemetry"))) {
+        qCritical() << "llconnectd:" << server.errorString();
+        sensorThread.quit();
+        sensorThread.wait();
+        return 1;
+    }
+
+    qInfo() << "llconnectd listening on" << socketPath;
+
+    // Only one loop may drive the ports; an open GUI that runs its own
+    // hands over once it sees the socket
+    FanControlLock fanLock;
+    QTimer lockTimer;
+    lockTimer.setInterval(kLockRetryInterval);
+    QObject::connect(&lockTimer, &QTimer::timeout, &engine, [&]() {
+        if (fanLock.tryAcquire(DaemonProtocol::fanControlLockPath())) {
+            lockTimer.stop();
+            qInfo() << "llconnectd: fan control taken over from the GUI";
+            engine.start();
+        }
+    });
+    if (fanLock.tryAcquire(DaemonProtocol::fanControlLockPath())) {
+        engine.start();
+    } else {
+        qInfo() << "llconnectd: the GUI is running the fans - waiting for it to hand over";
+        lockTimer.start();
+    }
+
+    int result = app.exec();
+
+    engine.stop();
+    sensorThread.quit();
+    sensorThread.wait();
+
+    if (!tracePath.isEmpty()) {
+        std::string error;
+        if (!Trace::save(tracePath.toStdString(), &error)) {
+            qWarning() << "Trace not saved:" << QString::fromStdString(error);
+        }
+    }
+    return result;
+}
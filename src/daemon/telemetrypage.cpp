@@ -0,0 +1,171 @@
+#include "telemetrypage.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Readers retry a slot that is being written; the writer holds it for a few
+// dozen stores, so running out means it died mid-write
+static constexpr int kMaxRetries = 1000;
+
+TelemetryPage::~TelemetryPage()
+{
+    close();
+}
+
+bool TelemetryPage::create(const QString &name)
+{
+    return map(name, true);
+}
+
+bool TelemetryPage::open(const QString &name)
+{
+    return map(name, false);
+}
+
+bool TelemetryPage::map(const QString &name, bool create)
+{
+    close();
+
+    const QByteArray path = name.toLocal8Bit();
+    int fd = -1;
+    if (create) {
+        // Never reuse an existing object: someone else may have created it
+        // first to feed our clients. Ours from a previous run goes away
+        // here; another user's can't be unlinked, so O_EXCL fails on it.
+        ::shm_unlink(path.constData());
+        fd = ::shm_open(path.constData(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    } else {
+        fd = ::shm_open(path.constData(), O_RDONLY, 0);
+    }
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (create) {
+        if (::ftruncate(fd, sizeof(Layout)) != 0) {
+            ::close(fd);
+            ::shm_unlink(path.constData());
+            return false;
+        }
+    } else if (::fstat(fd, &info) != 0 || info.st_uid != ::getuid()
+               || info.st_size < static_cast<off_t>(sizeof(Layout))) {
+        // Only trust a page our own daemon created
+        ::close(fd);
+        return false;
+    }
+
+    void *address = ::mmap(nullptr, sizeof(Layout), create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+
+    Layout *layout = static_cast<Layout *>(address);
+    if (create) {
+        // Readers check the header last, once the slots are in place
+        layout->magic = 0;
+        layout->head.store(0, std::memory_order_relaxed);
+        for (Slot &slot : layout->slots) {
+            slot.version.store(0, std::memory_order_relaxed);
+            for (auto &word : slot.words) {
+                word.store(0, std::memory_order_relaxed);
+            }
+        }
+        layout->version = kVersion;
+        layout->sampleSize = sizeof(SensorSample);
+        layout->capacity = kCapacity;
+        std::atomic_thread_fence(std::memory_order_release);
+        layout->magic = kMagic;
+    } else if (layout->magic != kMagic || layout->version != kVersion
+               || layout->sampleSize != sizeof(SensorSample) || layout->capacity != kCapacity) {
+        ::munmap(address, sizeof(Layout));
+        return false;
+    }
+
+    m_layout = layout;
+    m_name = path;
+    m_owner = create;
+    return true;
+}
+
+void TelemetryPage::close()
+{
+    if (!m_layout) {
+        return;
+    }
+    ::munmap(m_layout, sizeof(Layout));
+    if (m_owner) {
+        ::shm_unlink(m_name.constData());
+    }
+    m_layout = nullptr;
+    m_owner = false;
+}
+
+void TelemetryPage::push(SensorSample sample)
+{
+    if (!m_layout || !m_owner) {
+        return;
+    }
+
+    const quint64 sequence = m_layout->head.load(std::memory_order_relaxed) + 1;
+    sample.sequence = sequence;
+
+    quint64 words[kWords] = {};
+    std::memcpy(words, &sample, sizeof(sample));
+
+    Slot &slot = m_layout->slots[sequence % kCapacity];
+    const quint32 version = slot.version.load(std::memory_order_relaxed);
+
+    slot.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < kWords; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.version.store(version + 2, std::memory_order_release);
+
+    m_layout->head.store(sequence, std::memory_order_release);
+}
+
+quint64 TelemetryPage::head() const
+{
+    return m_layout ? m_layout->head.load(std::memory_order_acquire) : 0;
+}
+
+bool TelemetryPage::readSlot(const Slot &slot, SensorSample &out) const
+{
+    quint64 words[kWords];
+
+    for (int attempt = 0; attempt < kMaxRetries; ++attempt) {
+        const quint32 before = slot.version.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        for (int i = 0; i < kWords; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) == before) {
+            std::memcpy(&out, words, sizeof(out));
+            return out.sequence != 0;
+        }
+    }
+    return false;
+}
+
+bool TelemetryPage::latest(SensorSample &out) const
+{
+    const quint64 sequence = head();
+    return sequence != 0 && at(sequence, out);
+}
+
+bool TelemetryPage::at(quint64 sequence, SensorSample &out) const
+{
+    const quint64 newest = head();
+    if (sequence == 0 || sequence > newest || newest - sequence >= kCapacity) {
+        return false;
+    }
+    return readSlot(m_layout->slots[sequence % kCapacity], out) && out.sequence == sequence;
+}
@@ -0,0 +1,73 @@
+#ifndef TELEMETRYPAGE_H
+#define TELEMETRYPAGE_H
+
+#include <QByteArray>
+#include <QString>
+#include <atomic>
+#include <cstddef>
+#include "control/sensorring.h"
+
+// The newest control-loop samples of llconnectd in POSIX shared memory, so
+// a GUI can follow every tick without a socket message per sample.
+//
+// Same seqlock slots as SensorRing, but laid out in one fixed block that
+// both processes map: the daemon pushes, any number of clients read
+// without a lock or a syscall. A reader gives up on a slot that stays
+// mid-write (a writer that died) instead of spinning forever.
+class TelemetryPage
+{
+public:
+    static constexpr int kCapacity = 64;            // ~3 s at the default tick
+
+    TelemetryPage() = default;
+    ~TelemetryPage();
+
+    TelemetryPage(const TelemetryPage &) = delete;
+    TelemetryPage &operator=(const TelemetryPage &) = delete;
+
+    // Daemon: replaces any page of this user by a new one, readable by
+    // this user only; fails if another user owns the name
+    bool create(const QString &name);
+    // Client: maps an existing page read-only; fails on a layout mismatch
+    // or if another user owns it
+    bool open(const QString &name);
+    void close();
+    bool isOpen() const { return m_layout != nullptr; }
+
+    // Writer only
+    void push(SensorSample sample);
+
+    quint64 head() const;
+    bool latest(SensorSample &out) const;
+    bool at(quint64 sequence, SensorSample &out) const;
+
+private:
+    static constexpr quint32 kMagic = 0x4c4c5450;   // "LLTP"
+    static constexpr quint32 kVersion = 1;
+    static constexpr int kWords = (sizeof(SensorSample) + sizeof(quint64) - 1) / sizeof(quint64);
+
+    struct alignas(64) Slot {
+        std::atomic<quint32> version;
+        std::atomic<quint64> words[kWords];
+    };
+
+    struct Layout {
+        quint32 magic;
+        quint32 version;
+        quint32 sampleSize;
+        quint32 capacity;
+        alignas(64) std::atomic<quint64> head;
+        Slot slots[kCapacity];
+    };
+
+    static_assert(std::atomic<quint64>::is_always_lock_free, "shared atomics must be lock-free");
+
+    bool map(const QString &name, bool create);
+    bool readSlot(const Slot &slot, SensorSample &out) const;
+
+    Layout *m_layout = nullptr;
+    QByteArray m_name;
+    bool m_owner = false;
+};
+
+#endif // TELEMETRYPAGE_H
@@ -10,19 +10,26 @@
 
 #include "lian_li_qt_integration.h"
 #include "utils/qtdebugutil.h"
+#include <QCoreApplication>
 #include <QDebug>
-#include <QThread>
-#include <QApplication>
+
+LianLiQtIntegration *LianLiQtIntegration::shared()
+{
+    static LianLiQtIntegration *session = new LianLiQtIntegration(QCoreApplication::instance());
+    return session;
+}
 
 LianLiQtIntegration::LianLiQtIntegration(QObject *parent)
     : QObject(parent)
     , m_controller(std::make_unique<SLInfinityHIDController>())
     , m_deviceCheckTimer(new QTimer(this))
     , m_wasConnected(false)
+    , m_writeErrorPending(false)
 {
     // Set up device monitoring timer
     m_deviceCheckTimer->setInterval(2000); // Check every 2 seconds
     connect(m_deviceCheckTimer, &QTimer::timeout, this, &LianLiQtIntegration::onDeviceCheck);
+    watchWrites();
 }
 
 LianLiQtIntegration::~LianLiQtIntegration()
@@ -34,6 +41,12 @@ bool LianLiQtIntegration::initialize()
 {
     if (!m_controller) {
         m_controller = std::make_unique<SLInfinityHIDController>();
+        watchWrites();
+    }
+
+    // Another user of the session got there first; no second open or scan
+    if (m_controller->IsConnected()) {
+        return true;
     }
     
     if (m_controller->Initialize()) {
@@ -63,11 +76,34 @@ void LianLiQtIntegration::shutdown()
     m_wasConnected = false;
 }
 
+void LianLiQtIntegration::watchWrites()
+{
+    // The bool setters only queue; failures come back from the I/O thread
+    m_controller->SetWriteErrorHandler([this](const HIDCommand &command) {
+        if (m_writeErrorPending.exchange(true)) {
+            return;
+        }
+        const int channel = command.channel;
+        QMetaObject::invokeMethod(this, [this, channel]() {
+            m_writeErrorPending = false;
+            DEBUG_LOG("HID write failed on channel", channel);
+            emit errorOccurred(QString("Failed to write to channel %1 of the Lian Li device").arg(channel + 1));
+        }, Qt::QueuedConnection);
+    });
+}
+
 bool LianLiQtIntegration::isConnected() const
 {
     return m_controller && m_controller->IsConnected();
 }
 
+void LianLiQtIntegration::queueDelay(int milliseconds)
+{
+    if (m_controller) {
+        m_controller->QueueDelay(std::chrono::milliseconds(milliseconds));
+    }
+}
+
 QString LianLiQtIntegration::getDeviceName() const
 {
     if (!m_controller) return "Unknown";
@@ -113,16 +149,15 @@ bool LianLiQtIntegration::setChannelColor(int channel, const QColor &color, int
     DEBUG_LOG("SetChannelColors for channel", channel, "result:", success);
     
     if (success) {
-        // Add delay to ensure colors are fully sent before committing
-        QThread::msleep(10);
-        
         // Send commit action for static color mode with brightness
+        // The write queue gives the hub 10ms to take the colors before committing
         success = m_controller->SendCommitAction(
             static_cast<uint8_t>(channel), 
             0x01, // Static color mode
             0x00, // Speed doesn't matter for static
             0x00, // Direction doesn't matter for static
-            hwBrightness
+            hwBrightness,
+            std::chrono::milliseconds(10)
         );
         DEBUG_LOG("SendCommitAction for channel", channel, "result:", success);
         DEBUG_LOG("Command sent: channel=", channel, "effect=0x01 speed=0x00 direction=0x00 brightness=", hwBrightness);
@@ -167,18 +202,17 @@ bool LianLiQtIntegration::setChannelStaticWithFanColors(int channel, const QColo
     bool success = m_controller->SetChannelColors(static_cast<uint8_t>(channel), slColors, brightness_scale, false);
     
     if (success) {
-        // Increased delay to ensure colors are fully sent before committing
-        // The hardware may need time to process the color data before accepting the mode change
-        QThread::msleep(30);
-        
         // Send commit action for static color mode with brightness
         // Note: SetChannelMode sends a commit with brightness 0x00, so we don't use it here
+        // Increased settle time: the hardware may need time to process the color data
+        // before accepting the mode change (enforced by the write queue, not by sleeping here)
         success = m_controller->SendCommitAction(
             static_cast<uint8_t>(channel), 
             0x01, // Static color mode
             0x00, // Speed doesn't matter for static
             0x00, // Direction doesn't matter for static
-            hwBrightness
+            hwBrightness,
+            std::chrono::milliseconds(30)
         );
     }
     
@@ -467,17 +501,15 @@ bool LianLiQtIntegration::setChannelMeteorWithFanColors(int channel, const QColo
         return false;
     }
     
-    // Small delay to ensure colors are sent
-    QThread::msleep(50);
-    
-    // Send Meteor mode commit action
+    // Send Meteor mode commit action (queued 50ms after the colors to ensure they are sent)
     uint8_t meteorMode = 0x24;
     bool success = m_controller->SendCommitAction(
         static_cast<uint8_t>(channel),
         meteorMode,
         hwSpeed,
         hwDirection,
-        hwBrightness
+        hwBrightness,
+        std::chrono::milliseconds(50)
     );
     
     DEBUG_LOG("Meteor with 4 fan colors: channel=", channel, "mode=0x", QString::number(meteorMode, 16).toUpper(),
@@ -517,22 +549,21 @@ bool LianLiQtIntegration::setChannelMeteorWithColors(int channel, const QColor c
         return false;
     }
     
-    // Increased delay to ensure colors are fully processed before committing mode
-    // Meteor mode needs the colors to be set first, then the mode is applied
-    QThread::msleep(50);
-    
     // Send Meteor mode commit action (no direction control)
+    // Increased settle time to ensure colors are fully processed before committing mode
+    // Meteor mode needs the colors to be set first, then the mode is applied
     uint8_t meteorMode = 0x24;
     bool success = m_controller->SendCommitAction(
         static_cast<uint8_t>(channel),
         meteorMode,
         hwSpeed,
         hwDirection, // Always 0x00 for Meteor
-        hwBrightness
+        hwBrightness,
+        std::chrono::milliseconds(50)
     );
     
-    // Additional delay after commit to ensure mode is applied
-    QThread::msleep(10);
+    // Additional gap after commit to ensure mode is applied
+    m_controller->QueueDelay(std::chrono::milliseconds(10));
     
     DEBUG_LOG("Meteor with 2 colors (OpenRGB style): channel=", channel, "mode=0x", QString::number(meteorMode, 16).toUpper(),
              "speed=", hwSpeed, "dir=", hwDirection, "bright=", hwBrightness);
@@ -596,6 +627,59 @@ void LianLiQtIntegration::onDeviceCheck()
     }
 }
 
+bool LianLiQtIntegration::startDirectMode(int fps, const QVector<int> &channels)
+{
+    if (!isConnected()) {
+        return false;
+    }
+
+    uint8_t mask = 0;
+    for (int channel : channels) {
+        if (isChannelValid(channel)) {
+            mask |= 1 << channel;
+        }
+    }
+
+    DEBUG_LOG("Direct mode: streaming", channels.size(), "channel(s) at", fps, "FPS");
+    return m_controller->StartDirectMode(fps, mask);
+}
+
+bool LianLiQtIntegration::startSoftwareEffect(const LightingEffect &effect, const QVector<int> &ports, int fps)
+{
+    if (!isConnected()) {
+        return false;
+    }
+
+    QVector<int> channels;
+    for (int port : ports) {
+        channels << port * 2 << port * 2 + 1; // inner and outer ring
+    }
+
+    // Channel c belongs to port c / 2; the lambda keeps its own copy
+    m_controller->SetDirectRenderer([effect](uint8_t channel, double seconds, LedFrame &frame) {
+        effect.frame(channel / 2, seconds, frame);
+    });
+    return startDirectMode(fps, channels);
+}
+
+void LianLiQtIntegration::stopDirectMode()
+{
+    if (!m_controller || !m_controller->IsDirectMode()) {
+        return;
+    }
+
+    LedStreamer::Stats stats = m_controller->GetDirectStats();
+    m_controller->StopDirectMode();
+    m_controller->SetDirectRenderer(nullptr);
+    DEBUG_LOG("Direct mode stopped:", stats.frames, "frames,", stats.dropped, "dropped,",
+              stats.channelsSkipped, "unchanged channel updates skipped");
+}
+
+bool LianLiQtIntegration::isDirectMode() const
+{
+    return m_controller && m_controller->IsDirectMode();
+}
+
 SLInfinityColor LianLiQtIntegration::qColorToSLInfinity(const QColor &color) const
 {
     return SLInfinityColor::fromRGB(
@@ -694,15 +778,14 @@ bool LianLiQtIntegration::setChannelEffectWithColors(int channel, uint8_t mode,
         return false;
     }
     
-    QThread::msleep(10);
-    
-    // Send commit action
+    // Send commit action (queued 10ms after the colors)
     return m_controller->SendCommitAction(
         static_cast<uint8_t>(channel),
         mode,
         hwSpeed,
         hwDirection,
-        hwBrightness
+        hwBrightness,
+        std::chrono::milliseconds(10)
     );
 }
 
@@ -980,16 +1063,15 @@ bool LianLiQtIntegration::setChannelColorCycle(int channel, const QColor colors[
         return false;
     }
     
-    // Add delay to ensure colors are set before sending commit action
-    QThread::msleep(10);
-    
     // Send commit action for color cycle effect
+    // The write queue holds it 10ms after the colors to ensure they are set
     bool result = m_controller->SendCommitAction(
         static_cast<uint8_t>(channel),
         0x23, // ColorCycle mode
         hwSpeed,
         hwDirection,
-        hwBrightness
+        hwBrightness,
+        std::chrono::milliseconds(10)
     );
     
     if (result) {
@@ -1122,14 +1204,13 @@ bool LianLiQtIntegration::setChannelTunnel(int channel, const QColor colors[4],
         return false;
     }
     
-    QThread::msleep(10);
-    
     // Send commit action for tunnel effect (has direction control)
     return m_controller->SendCommitAction(
         static_cast<uint8_t>(channel),
         0x29, // Tunnel mode
         hwSpeed,
         hwDirection,
-        hwBrightness
+        hwBrightness,
+        std::chrono::milliseconds(10)
     );
 }
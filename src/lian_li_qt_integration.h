@@ -14,9 +14,15 @@
 #include <QColor>
 #include <QTimer>
 #include <QString>
+#include <QVector>
+#include <atomic>
 #include <memory>
 #include "usb/sl_infinity_hid.h"
+#include "lighting/lightingeffect.h"
 
+// One hub, one hidraw fd: the pages share the session from shared()
+// rather than opening the device themselves. Writes are serialized by the
+// controller's I/O thread; the object itself lives on the GUI thread.
 class LianLiQtIntegration : public QObject
 {
     Q_OBJECT
@@ -25,17 +31,28 @@ public:
     explicit LianLiQtIntegration(QObject *parent = nullptr);
     ~LianLiQtIntegration();
 
+    // The process-wide session, owned by the application
+    static LianLiQtIntegration *shared();
+
     // Device management
+    // Opens the hub unless this session already has it; deviceConnected()
+    // goes out to every listener only when it was actually opened
     bool initialize();
     void shutdown();
     bool isConnected() const;
     
+    // Writes are queued to the device's I/O thread; this inserts a pause
+    // between queued writes without blocking the caller
+    void queueDelay(int milliseconds);
+    
     // Device information
     QString getDeviceName() const;
     QString getFirmwareVersion() const;
     QString getSerialNumber() const;
     
     // RGB Control
+    // These return once the writes are queued; a write the hub rejects
+    // later is reported through errorOccurred()
     bool setChannelColor(int channel, const QColor &color, int brightness = 100);
     bool setChannelStaticWithFanColors(int channel, const QColor colors[4], int brightness = 100);
     bool setChannelMode(int channel, int mode);
@@ -79,6 +96,14 @@ public:
     bool setTunnelEffect(const QColor &color, int speed = 50, int brightness = 100, bool directionLeft = false);
     bool setChannelTunnel(int channel, const QColor colors[4], int speed = 50, int brightness = 100, bool directionLeft = false);
     
+    // Direct mode: runs a software effect on the given ports (0-3, both
+    // channels each), drawn by the same LightingEffect as the preview and
+    // streamed by the host at a fixed frame rate. Any of the preset calls
+    // above ends it.
+    bool startSoftwareEffect(const LightingEffect &effect, const QVector<int> &ports, int fps = 30);
+    void stopDirectMode();
+    bool isDirectMode() const;
+    
     // Helper to convert percentage values to hardware values
     static uint8_t convertSpeed(int speedPercent);
     static uint8_t convertBrightness(int brightnessPercent);
@@ -101,8 +126,12 @@ private:
     std::unique_ptr<SLInfinityHIDController> m_controller;
     QTimer *m_deviceCheckTimer;
     bool m_wasConnected;
+    // One errorOccurred() in flight at a time, however many writes fail
+    std::atomic<bool> m_writeErrorPending;
     
     // Helper methods
+    void watchWrites();
+    bool startDirectMode(int fps, const QVector<int> &channels);
     SLInfinityColor qColorToSLInfinity(const QColor &color) const;
     QColor slInfinityToQColor(const SLInfinityColor &color) const;
 };
@@ -0,0 +1,233 @@
+#include "lightingeffect.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int N = LightingEffect::kLedsPerRing;
+
+// Per-LED working set of a kernel: 0-255 floats, before brightness
+struct Channels
+{
+    float r[N];
+    float g[N];
+    float b[N];
+};
+
+void fillSolid(Channels &out, const SLInfinityColor &color, const float intensity[N])
+{
+    for (int k = 0; k < N; ++k) {
+        out.r[k] = color.r * intensity[k];
+        out.g[k] = color.g * intensity[k];
+        out.b[k] = color.b * intensity[k];
+    }
+}
+
+void fillBlend(Channels &out, const SLInfinityColor &from, const SLInfinityColor &to, const float mix[N])
+{
+    for (int k = 0; k < N; ++k) {
+        out.r[k] = from.r + (to.r - from.r) * mix[k];
+        out.g[k] = from.g + (to.g - from.g) * mix[k];
+        out.b[k] = from.b + (to.b - from.b) * mix[k];
+    }
+}
+
+// Fully saturated hue (degrees) per LED, branch-free
+void fillHue(Channels &out, const float hue[N], const float intensity[N])
+{
+    auto component = [](float h, float n) {
+        float k = std::fmod(n + h / 60.0f, 6.0f);
+        if (k < 0.0f) k += 6.0f;
+        return 1.0f - std::max(0.0f, std::min({ k, 4.0f - k, 1.0f }));
+    };
+    for (int k = 0; k < N; ++k) {
+        out.r[k] = 255.0f * intensity[k] * component(hue[k], 5.0f);
+        out.g[k] = 255.0f * intensity[k] * component(hue[k], 3.0f);
+        out.b[k] = 255.0f * intensity[k] * component(hue[k], 1.0f);
+    }
+}
+
+float wave(double x)
+{
+    return static_cast<float>(std::sin(x) * 0.5 + 0.5);
+}
+
+} // namespace
+
+LightingEffect::LightingEffect()
+{
+    m_parameters.palette = { SLInfinityColor(255, 0, 0), SLInfinityColor(0, 255, 0),
+                             SLInfinityColor(0, 0, 255), SLInfinityColor(255, 255, 0) };
+}
+
+LightingEffect::LightingEffect(const Parameters &parameters)
+    : m_parameters(parameters)
+{
+}
+
+LightingEffect::Kind LightingEffect::kindFromName(const std::string &name)
+{
+    if (name == "Rainbow Wave" || name == "Rainbow") return Kind::Rainbow;
+    if (name == "Spectrum Cycle" || name == "Rainbow Morph") return Kind::RainbowMorph;
+    if (name == "Breathing") return Kind::Breathing;
+    if (name == "Meteor") return Kind::Meteor;
+    if (name == "Runway") return Kind::Runway;
+    if (name == "Groove") return Kind::Groove;
+    if (name == "Mixing") return Kind::Mixing;
+    if (name == "Neon") return Kind::Neon;
+    if (name == "Stack") return Kind::Stack;
+    if (name == "Staggered") return Kind::Staggered;
+    if (name == "Tide") return Kind::Tide;
+    if (name == "Tunnel") return Kind::Tunnel;
+    if (name == "Voice") return Kind::Voice;
+    return Kind::Static;
+}
+
+LightingEffect::Ring LightingEffect::ring(int port, double seconds) const
+{
+    const Parameters &p = m_parameters;
+    port = ((port % kPortCount) + kPortCount) % kPortCount;
+
+    const SLInfinityColor &own = p.palette[port];
+    const SLInfinityColor &next = p.palette[(port + 1) % kPortCount];
+
+    // Phase at the chosen speed; direction only reverses the moving effects
+    const double t = seconds * kPhaseRate * (p.speed / 100.0);
+    const double signedT = p.directionLeft ? -t : t;
+
+    Channels out;
+    float a[N];   // intensity or mix per LED
+    float h[N];   // hue per LED
+
+    switch (p.kind) {
+    case Kind::Rainbow: {
+        // The whole rainbow turns: LED k shows what was at k - shift
+        const double shift = signedT * N / (2.0 * M_PI);
+        for (int k = 0; k < N; ++k) {
+            h[k] = static_cast<float>(std::fmod((k - shift + port * 2) * 360.0 / N, 360.0));
+            a[k] = 1.0f;
+        }
+        fillHue(out, h, a);
+        break;
+    }
+    case Kind::RainbowMorph: {
+        const double morph = signedT * 0.5;
+        for (int k = 0; k < N; ++k) {
+            int position = k + port * 3 + static_cast<int>(std::sin(morph + k * 0.5) * 0.3 * N);
+            h[k] = static_cast<float>(((position % N + N) % N) * 360.0 / N);
+            a[k] = 1.0f;
+        }
+        fillHue(out, h, a);
+        break;
+    }
+    case Kind::Breathing:
+    case Kind::Neon: {
+        // Whole ring pulses, 30-100% (Breathing) or 40-100% (Neon)
+        const float floor = (p.kind == Kind::Breathing) ? 0.3f : 0.4f;
+        const float level = floor + (1.0f - floor) * wave(t * 2.0);
+        std::fill(a, a + N, level);
+        fillSolid(out, own, a);
+        break;
+    }
+    case Kind::Meteor: {
+        // Bright head with a squared fade over the 5 LEDs behind it
+        double position = std::fmod(t * 1.5, 1.0);
+        if (p.directionLeft) position = 1.0 - position;
+        const int head = static_cast<int>(position * N) % N;
+        for (int k = 0; k < N; ++k) {
+            int distance = (k - head + N) % N;
+            float trail = std::max(0.0f, 1.0f - distance / 5.0f);
+            a[k] = distance <= 5 ? trail * trail : 0.0f;
+        }
+        fillSolid(out, own, a);
+        break;
+    }
+    case Kind::Runway: {
+        double position = std::fmod(t * 1.2, 1.0);
+        if (p.directionLeft) position = 1.0 - position;
+        for (int k = 0; k < N; ++k) {
+            a[k] = std::fmod(position * N + k, static_cast<double>(N)) / N < 0.2 ? 1.0f : 0.0f;
+        }
+        fillSolid(out, p.color, a);
+        break;
+    }
+    case Kind::Stack: {
+        double level = std::fmod(t, 1.0);
+        if (p.directionLeft) level = 1.0 - level;
+        for (int k = 0; k < N; ++k) {
+            a[k] = static_cast<double>(k) / N <= level ? 1.0f : 0.0f;
+        }
+        fillSolid(out, own, a);
+        break;
+    }
+    case Kind::Mixing: {
+        // The port color against a lighter version of itself
+        SLInfinityColor light(std::min(255, own.r + 50), std::min(255, own.g + 50), std::min(255, own.b + 50));
+        for (int k = 0; k < N; ++k) {
+            a[k] = wave(t + k * 0.5);
+        }
+        fillBlend(out, own, light, a);
+        break;
+    }
+    case Kind::Tide: {
+        for (int k = 0; k < N; ++k) {
+            a[k] = wave(t * 2.0 + k * 0.5);
+        }
+        fillBlend(out, own, next, a);
+        break;
+    }
+    case Kind::Staggered: {
+        const int step = static_cast<int>(t * 4);
+        for (int k = 0; k < N; ++k) {
+            a[k] = ((step + k) % 4 < 2) ? 0.0f : 1.0f;
+        }
+        fillBlend(out, own, next, a);
+        break;
+    }
+    case Kind::Tunnel: {
+        for (int k = 0; k < N; ++k) {
+            a[k] = 0.3f + 0.7f * wave((k + signedT * N) * 0.1);
+        }
+        fillSolid(out, own, a);
+        break;
+    }
+    case Kind::Voice: {
+        // Rainbow ring with odd and even LEDs pulsing out of step
+        const float even = wave(t * 3.0);
+        const float odd = wave(t * 4.0 + 1.0);
+        for (int k = 0; k < N; ++k) {
+            h[k] = static_cast<float>(((k + port * 2) % N) * 360.0 / N);
+            a[k] = 0.4f + 0.6f * ((k % 2 == 0) ? even : odd);
+        }
+        fillHue(out, h, a);
+        break;
+    }
+    case Kind::Groove:   // four rotating four-LED segments cover the whole ring
+    case Kind::Static:
+        std::fill(a, a + N, 1.0f);
+        fillSolid(out, own, a);
+        break;
+    }
+
+    // Brightness, then the same limiter the hub frames get
+    const float scale = std::clamp(p.brightness, 0, 100) / 100.0f;
+    Ring result;
+    for (int k = 0; k < N; ++k) {
+        SLInfinityColor color(static_cast<uint8_t>(std::clamp(out.r[k], 0.0f, 255.0f)),
+                              static_cast<uint8_t>(std::clamp(out.g[k], 0.0f, 255.0f)),
+                              static_cast<uint8_t>(std::clamp(out.b[k], 0.0f, 255.0f)));
+        result[k] = LedFrame::Scaled(color, scale);
+    }
+    return result;
+}
+
+void LightingEffect::frame(int port, double seconds, LedFrame &out) const
+{
+    const Ring leds = ring(port, seconds);
+    out.Clear();
+    for (int fan = 0; fan < LedFrame::kFanCount; ++fan) {
+        for (int k = 0; k < kLedsPerRing; ++k) {
+            out.SetLed(fan * LedFrame::kLedsPerFan + k, leds[k]);
+        }
+    }
+}
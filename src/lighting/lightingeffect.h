@@ -0,0 +1,76 @@
+#ifndef LIGHTINGEFFECT_H
+#define LIGHTINGEFFECT_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include "usb/led_frame.h"
+
+// The software lighting effects, independent of how they are shown.
+//
+// Each effect is a kernel over the 16 LEDs of one fan's ring: given the
+// time, speed, direction and palette it fills per-LED arrays in plain
+// loops over the LED index, and the result is scaled and limited exactly
+// like a frame sent to the hub. FanLightingWidget paints the ring it
+// returns and, with LightingState::software, the direct-mode streamer
+// sends frame() to the hardware, so the preview shows what the fans show.
+// The hub's own presets are firmware animations and only resemble these.
+//
+// Ports are 0-3 (the preview's fans, channels 2 * port and 2 * port + 1 on
+// the hub); every fan daisy-chained on a channel shows the same ring.
+class LightingEffect
+{
+public:
+    enum class Kind {
+        Rainbow,
+        RainbowMorph,
+        Static,
+        Breathing,
+        Meteor,
+        Runway,
+        Groove,
+        Mixing,
+        Neon,
+        Stack,
+        Staggered,
+        Tide,
+        Tunnel,
+        Voice
+    };
+
+    static constexpr int kLedsPerRing = LedFrame::kLedsPerFan;
+    static constexpr int kPortCount = 4;
+    // Animation phase per second at 100% speed
+    static constexpr double kPhaseRate = 2.0;
+
+    struct Parameters
+    {
+        Kind kind = Kind::Rainbow;
+        int speed = 50;             // percent
+        int brightness = 100;       // percent
+        bool directionLeft = false;
+        SLInfinityColor color = SLInfinityColor(255, 255, 255);   // Runway
+        std::array<SLInfinityColor, kPortCount> palette;          // one per port
+    };
+
+    using Ring = std::array<SLInfinityColor, kLedsPerRing>;
+
+    LightingEffect();
+    explicit LightingEffect(const Parameters &parameters);
+
+    // UI names ("Rainbow Wave", "Static Color", ...); unknown names are Static
+    static Kind kindFromName(const std::string &name);
+
+    const Parameters &parameters() const { return m_parameters; }
+    void setParameters(const Parameters &parameters) { m_parameters = parameters; }
+
+    // LED k of the ring sits at k * 22.5 degrees
+    Ring ring(int port, double seconds) const;
+    // The ring on all four fans of a channel, ready for the hub
+    void frame(int port, double seconds, LedFrame &out) const;
+
+private:
+    Parameters m_parameters;
+};
+
+#endif // LIGHTINGEFFECT_H
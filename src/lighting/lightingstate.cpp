@@ -0,0 +1,391 @@
+#include "lightingstate.h"
+#include "lian_li_qt_integration.h"
+#include "utils/qtdebugutil.h"
+#include <QVector>
+
+static SLInfinityColor toLedColor(const QColor &color)
+{
+    return SLInfinityColor::fromRGB(static_cast<uint8_t>(color.red()),
+                                    static_cast<uint8_t>(color.green()),
+                                    static_cast<uint8_t>(color.blue()));
+}
+
+LightingEffect::Parameters LightingState::effectParameters() const
+{
+    LightingEffect::Parameters parameters;
+    parameters.kind = LightingEffect::kindFromName(effect.toStdString());
+    parameters.speed = speed;
+    parameters.brightness = brightness;
+    parameters.directionLeft = directionLeft;
+
+    // Same fallbacks as the presets below
+    QColor runway;
+    for (int port = 0; port < 4; ++port) {
+        const QColor color = colors[port][0].isValid() ? colors[port][0] : QColor(255, 0, 0);
+        parameters.palette[port] = toLedColor(color);
+        if (!runway.isValid() && portEnabled[port] && colors[port][0].isValid()) {
+            runway = colors[port][0];
+        }
+    }
+    parameters.color = toLedColor(runway.isValid() ? runway : QColor(255, 200, 100));
+    return parameters;
+}
+
+bool LightingState::apply(LianLiQtIntegration &device) const
+{
+    bool success = false;
+    
+    DEBUG_LOG("Applying effect:", effect, 
+             "Speed:", speed, 
+             "Brightness:", brightness, 
+             "Direction:", (directionLeft ? "Left" : "Right"),
+             software ? "(software)" : "");
+    
+    if (software) {
+        QVector<int> ports;
+        for (int port = 0; port < 4; ++port) {
+            if (portEnabled[port]) {
+                ports.append(port);
+            }
+        }
+        if (ports.isEmpty()) {
+            device.stopDirectMode();
+            return true;
+        }
+        return device.startSoftwareEffect(LightingEffect(effectParameters()), ports);
+    }
+    
+    // Every preset call below ends a running software effect
+    if (effect == "Rainbow Wave") {
+        success = device.setRainbowEffect(speed, brightness, directionLeft);
+    } else if (effect == "Spectrum Cycle") {
+        success = device.setRainbowMorphEffect(speed, brightness);
+    } else if (effect == "Static") {
+        // Static: One solid color per port - apply to selected port(s)
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        
+        QColor currentColor = QColor(255, 0, 0);
+        success = true;  // Start optimistic - will be set to false if any channel fails
+        
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            // Skip disabled ports
+            if (!portEnabled[port]) {
+                continue;
+            }
+            
+            // Use the first color for this port (single solid color per port)
+            QColor portColor = colors[port][0];
+            if (!portColor.isValid()) {
+                portColor = currentColor;
+            }
+            
+            int channel1 = port * 2;      // First channel for this port
+            int channel2 = port * 2 + 1;  // Second channel for this port
+            
+            DEBUG_LOG("Setting Static for Port", (port + 1), "via channels", channel1, "&", channel2, 
+                     "to color", portColor, "brightness", brightness);
+            
+            // Send to both channels for this port (inner and outer rings)
+            bool channel1Success = device.setChannelColor(channel1, portColor, brightness);
+            bool channel2Success = device.setChannelColor(channel2, portColor, brightness);
+            
+            if (!channel1Success) {
+                DEBUG_LOG("Failed to set Static for Port", (port + 1), "channel", channel1);
+                success = false;
+            }
+            if (!channel2Success) {
+                DEBUG_LOG("Failed to set Static for Port", (port + 1), "channel", channel2);
+                success = false;
+            }
+            
+            if (channel1Success && channel2Success) {
+                DEBUG_LOG("✓ Successfully set Port", (port + 1));
+            }
+        }
+    } else if (effect == "Breathing") {
+        // Breathing supports up to 6 colors per OpenRGB - apply to selected port(s)
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        
+        QColor currentColor = QColor(255, 0, 0);
+        
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            if (!portEnabled[port]) continue;
+            
+            QColor portColor = colors[port][0];
+            if (!portColor.isValid()) portColor = currentColor;
+            int channel = port * 2;
+            device.setChannelBreathing(channel, portColor, speed, brightness);
+            if (channel + 1 < 8) {
+                device.setChannelBreathing(channel + 1, portColor, speed, brightness);
+            }
+            success = true;
+        }
+    } else if (effect == "Meteor") {
+        // Meteor: One color per port (like Static/Breathing)
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        
+        QColor currentColor = QColor(255, 0, 0);
+        
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            if (!portEnabled[port]) continue;
+            
+            // Use the first color for this port (single color per port)
+            QColor portColor = colors[port][0];
+            if (!portColor.isValid()) portColor = currentColor;
+            
+            // Meteor uses 2 colors internally, but we use the same color for both
+            QColor portColors[2] = {portColor, portColor};
+            
+            int channel = port * 2;
+            DEBUG_LOG("Applying Meteor to Port", (port + 1), "channel", channel,
+                     "Color(RGB):", portColor.red(), portColor.green(), portColor.blue(),
+                     "Speed:", speed, "Brightness:", brightness);
+            
+            device.setChannelMeteorWithColors(channel, portColors, speed, brightness, false);
+            device.queueDelay(10);
+            if (channel + 1 < 8) {
+                device.setChannelMeteorWithColors(channel + 1, portColors, speed, brightness, false);
+            }
+            device.queueDelay(50);
+            success = true;
+        }
+    } else if (effect == "Voice") {
+        success = device.setVoiceEffect(speed, brightness);
+    } else if (effect == "Groove") {
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        QColor currentColor = QColor(255, 0, 0);
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            if (!portEnabled[port]) continue;
+            QColor portColor = colors[port][0];
+            if (!portColor.isValid()) portColor = currentColor;
+            int channel = port * 2;
+            device.setChannelGroove(channel, portColor, speed, brightness, directionLeft);
+            if (channel + 1 < 8) {
+                device.setChannelGroove(channel + 1, portColor, speed, brightness, directionLeft);
+            }
+            success = true;
+        }
+    } else if (effect == "Tunnel") {
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        QColor currentColor = QColor(255, 0, 0);
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            if (!portEnabled[port]) continue;
+            int channel = port * 2;
+            QColor portColors[4] = {colors[port][0], colors[port][1], 
+                                   colors[port][2], colors[port][3]};
+            if (!portColors[0].isValid()) portColors[0] = currentColor;
+            if (!portColors[1].isValid()) portColors[1] = currentColor;
+            if (!portColors[2].isValid()) portColors[2] = currentColor;
+            if (!portColors[3].isValid()) portColors[3] = currentColor;
+            device.setChannelTunnel(channel, portColors, speed, brightness, directionLeft);
+            if (channel + 1 < 8) {
+                device.setChannelTunnel(channel + 1, portColors, speed, brightness, directionLeft);
+            }
+            success = true;
+        }
+    } else if (effect == "Staggered") {
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        QColor currentColor = QColor(255, 0, 0);
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            if (!portEnabled[port]) continue;
+            int channel = port * 2;
+            QColor portColors[2] = {colors[port][0], colors[port][1]};
+            if (!portColors[0].isValid()) portColors[0] = currentColor;
+            if (!portColors[1].isValid()) portColors[1] = currentColor;
+            device.setChannelStaggered(channel, portColors, speed, brightness);
+            if (channel + 1 < 8) {
+                device.setChannelStaggered(channel + 1, portColors, speed, brightness);
+            }
+            success = true;
+        }
+    } else if (effect == "Tide") {
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            if (!portEnabled[port]) continue;
+            
+            QColor portColors[2] = {colors[port][0], colors[port][1]};
+            int channel = port * 2;
+            device.setChannelTide(channel, portColors, speed, brightness);
+            if (channel + 1 < 8) {
+                device.setChannelTide(channel + 1, portColors, speed, brightness);
+            }
+            success = true;
+        }
+    } else if (effect == "Runway") {
+        // Runway: One color per port (like Static/Breathing/Meteor/Mixing/Neon)
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        
+        QColor currentColor = QColor(255, 200, 100); // Default orange
+        
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            if (!portEnabled[port]) continue;
+            
+            // Use the first color for this port (single color per port)
+            QColor portColor = colors[port][0];
+            if (!portColor.isValid()) portColor = currentColor;
+            
+            // Runway uses 2 colors internally, but we use the same color for both
+            QColor portColors[2] = {portColor, portColor};
+            
+            int channel = port * 2;
+            device.setChannelRunwayWithColors(channel, portColors, speed, brightness, false);
+            if (channel + 1 < 8) {
+                device.setChannelRunwayWithColors(channel + 1, portColors, speed, brightness, false);
+            }
+            success = true;
+        }
+    } else if (effect == "Mixing") {
+        // Mixing: One color per port (like Static/Breathing/Meteor)
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        
+        QColor currentColor = QColor(255, 0, 0);
+        
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            if (!portEnabled[port]) continue;
+            
+            // Use the first color for this port (single color per port)
+            QColor portColor = colors[port][0];
+            if (!portColor.isValid()) portColor = currentColor;
+            
+            // Mixing uses 2 colors internally, but we use the same color for both
+            QColor portColors[2] = {portColor, portColor};
+            
+            int channel = port * 2;
+            DEBUG_LOG("Applying Mixing to Port", (port + 1), "channel", channel,
+                     "Color(RGB):", portColor.red(), portColor.green(), portColor.blue(),
+                     "Speed:", speed, "Brightness:", brightness);
+            
+            device.setChannelMixing(channel, portColors, speed, brightness);
+            device.queueDelay(10);
+            if (channel + 1 < 8) {
+                device.setChannelMixing(channel + 1, portColors, speed, brightness);
+            }
+            device.queueDelay(50);
+            success = true;
+        }
+    } else if (effect == "Stack") {
+        // Stack: One color per port (like Static/Breathing/Meteor/Mixing/Neon/Runway)
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        
+        QColor currentColor = QColor(255, 0, 0); // Default red
+        
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            if (!portEnabled[port]) continue;
+            
+            // Use the first color for this port (single color per port)
+            QColor portColor = colors[port][0];
+            if (!portColor.isValid()) portColor = currentColor;
+            
+            int channel = port * 2;
+            device.setChannelStack(channel, portColor, speed, brightness, directionLeft);
+            if (channel + 1 < 8) {
+                device.setChannelStack(channel + 1, portColor, speed, brightness, directionLeft);
+            }
+            success = true;
+        }
+    } else if (effect == "Neon") {
+        // Neon: One color per port (like Static/Breathing/Meteor)
+        int portsToApply[4] = {0, 1, 2, 3};
+        int portCount = 4;
+        if (selectedPort >= 0 && selectedPort < 4) {
+            portsToApply[0] = selectedPort;
+            portCount = 1;
+        }
+        
+        QColor currentColor = QColor(255, 0, 0);
+        
+        for (int i = 0; i < portCount; i++) {
+            int port = portsToApply[i];
+            if (!portEnabled[port]) continue;
+            
+            // Use the first color for this port (single color per port)
+            QColor portColor = colors[port][0];
+            if (!portColor.isValid()) portColor = currentColor;
+            
+            int channel = port * 2;
+            DEBUG_LOG("Applying Neon to Port", (port + 1), "channel", channel,
+                     "Color(RGB):", portColor.red(), portColor.green(), portColor.blue(),
+                     "Speed:", speed, "Brightness:", brightness);
+            
+            // Use setChannelEffect with Neon mode (0x22) and the port color
+            device.setChannelEffect(channel, 0x22, portColor, speed, brightness, false);
+            device.queueDelay(10);
+            if (channel + 1 < 8) {
+                device.setChannelEffect(channel + 1, 0x22, portColor, speed, brightness, false);
+            }
+            device.queueDelay(50);
+            success = true;
+        }
+    }
+    
+    if (success) {
+        DEBUG_LOG("✓ Successfully applied effect:", effect);
+    } else {
+        DEBUG_LOG("✗ Failed to apply effect:", effect);
+    }
+    
+    return success;
+}
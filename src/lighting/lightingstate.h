@@ -0,0 +1,32 @@
+#ifndef LIGHTINGSTATE_H
+#define LIGHTINGSTATE_H
+
+#include <QColor>
+#include <QString>
+#include "lighting/lightingeffect.h"
+
+class LianLiQtIntegration;
+
+// Everything a hardware lighting effect is applied from: what LightingPage
+// shows, and what the GUI sends to llconnectd when the daemon owns the hub.
+struct LightingState
+{
+    QString effect = "Rainbow Wave";   // UI name
+    int speed = 75;                    // percent
+    int brightness = 100;              // percent
+    bool directionLeft = false;
+    int selectedPort = -1;             // -1 = all ports, 0-3 = only that one
+    bool portEnabled[4] = { true, true, true, true };
+    QColor colors[4][4];               // [port][color index]
+    // Drawn by the host instead of the hub's preset, so the fans show
+    // exactly what the preview shows. Runs on every enabled port and only
+    // while the process that applied it is running.
+    bool software = false;
+
+    // Sends the effect to the hub (both channels of each port it applies to)
+    bool apply(LianLiQtIntegration &device) const;
+    // The effect as LightingEffect draws it, for the preview and software mode
+    LightingEffect::Parameters effectParameters() const;
+};
+
+#endif // LIGHTINGSTATE_H
@@ -6,14 +6,16 @@
 #include <QIcon>
 #include <QDebug>
 #include <QSettings>
+#include <QElapsedTimer>
 #include "mainwindow.h"
+#include "utils/debugutil.h"
+#include "utils/trace.h"
 
 // Custom message handler to filter debug output based on settings
 void customMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-    // Check if debug mode is enabled
-    QSettings settings("LianLi", "LConnect3");
-    bool debugEnabled = settings.value("Debug/Enabled", false).toBool();
+    // Check if debug mode is enabled (cached; SettingsPage keeps it current)
+    bool debugEnabled = DebugUtil::isDebugEnabled();
     
     // Always show warnings, critical messages, and fatal errors
     if (type == QtWarningMsg || type == QtCriticalMsg || type == QtFatalMsg) {
@@ -46,11 +48,29 @@ void customMessageHandler(QtMsgType type, const QMessageLogContext &context, con
 
 int main(int argc, char *argv[])
 {
+    // Time to the first frame is logged by the window
+    QElapsedTimer startupClock;
+    startupClock.start();
+    
     // High DPI scaling is enabled by default in Qt6
     QApplication app(argc, argv);
     
     // Install custom message handler to control debug output
     qInstallMessageHandler(customMessageHandler);
+
+    // LLCONNECT_TRACE=<file> records HID and fan control events into <file>
+    // (see tracedump)
+    const QString tracePath = qEnvironmentVariable("LLCONNECT_TRACE");
+    if (!tracePath.isEmpty()) {
+        Trace::setThreadName("gui");
+        Trace::start();
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, [tracePath]() {
+            std::string error;
+            if (!Trace::save(tracePath.toStdString(), &error)) {
+                qWarning() << "Trace not saved:" << QString::fromStdString(error);
+            }
+        });
+    }
     
     // Set application properties
     app.setApplicationName("LL-Connect 3");
@@ -106,6 +126,7 @@ int main(int argc, char *argv[])
     
     // Create and show main window
     MainWindow window;
+    window.setStartupClock(startupClock);
     bool minimizeOnStartup = false;
     {
         QSettings settings("LianLi", "LConnect3");
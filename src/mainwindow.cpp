@@ -4,6 +4,12 @@
 #include "pages/fanprofilepage.h"
 #include "pages/lightingpage.h"
 #include "pages/settingspage.h"
+#include "control/fancontrolengine.h"
+#include "daemon/daemonclient.h"
+#include "daemon/daemonprotocol.h"
+#include "sensors/sensorservice.h"
+#include "utils/driversettings.h"
+#include "utils/visibilityscheduler.h"
 #include <QApplication>
 #include <QStyleFactory>
 #include <QPalette>
@@ -13,11 +19,26 @@
 #include <QList>
 #include <QSettings>
 #include <QCloseEvent>
+#include <QShowEvent>
+#include <QTimer>
+#include <QThread>
+#include <QDebug>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
+    , m_systemInfoPage(nullptr)
+    , m_fanProfilePage(nullptr)
+    , m_lightingPage(nullptr)
+    , m_settingsPage(nullptr)
+    , m_sensorThread(nullptr)
+    , m_sensorService(nullptr)
+    , m_daemonClient(nullptr)
+    , m_fanControlThread(nullptr)
+    , m_fanControlEngine(nullptr)
     , m_currentPage(0)
+    , m_windowBuiltMs(0)
+    , m_firstFrameShown(false)
 {
     // Enable High DPI scaling for this window
     setAttribute(Qt::WA_NoSystemBackground, false);
@@ -53,6 +74,19 @@ MainWindow::~MainWindow()
     // Save window geometry before destruction
     QSettings settings("LianLi", "LConnect3");
     settings.setValue("windowGeometry", saveGeometry());
+    
+    // Stop the control loop; the engine is deleted on its own thread
+    if (m_fanControlThread) {
+        m_fanControlThread->quit();
+        m_fanControlThread->wait();
+    }
+    
+    // The engine reads sensor snapshots, so the sensor thread goes last
+    if (m_sensorThread) {
+        m_sensorThread->quit();
+        m_sensorThread->wait();
+    }
+    
     delete ui;
 }
 
@@ -64,6 +98,50 @@ void MainWindow::closeEvent(QCloseEvent *event)
     event->accept();
 }
 
+void MainWindow::setStartupClock(const QElapsedTimer &clock)
+{
+    m_startupClock = clock;
+    m_windowBuiltMs = clock.elapsed();
+}
+
+void MainWindow::showEvent(QShowEvent *event)
+{
+    QMainWindow::showEvent(event);
+    
+    // Started minimized (desktop login): the first page waits until opened
+    if (!isMinimized()) {
+        showPage(m_currentPage);
+    }
+}
+
+void MainWindow::changeEvent(QEvent *event)
+{
+    QMainWindow::changeEvent(event);
+    
+    if (event->type() == QEvent::WindowStateChange && isVisible() && !isMinimized()) {
+        showPage(m_currentPage);
+    }
+}
+
+void MainWindow::paintEvent(QPaintEvent *event)
+{
+    QMainWindow::paintEvent(event);
+    
+    if (m_firstFrameShown) {
+        return;
+    }
+    m_firstFrameShown = true;
+    
+    // The pages paint after the window in the same pass; report once the
+    // whole frame has been flushed
+    QTimer::singleShot(0, this, [this]() {
+        if (m_startupClock.isValid()) {
+            qInfo().noquote() << QString("Startup: window built after %1 ms, first frame after %2 ms")
+                                 .arg(m_windowBuiltMs).arg(m_startupClock.elapsed());
+        }
+    });
+}
+
 void MainWindow::setupUI()
 {
     // UI is already set up by ui->setupUi(this)
@@ -75,26 +153,184 @@ void MainWindow::setupUI()
     connect(ui->lightingBtn, &QPushButton::clicked, this, &MainWindow::onNavigationClicked);
     connect(ui->settingsBtn, &QPushButton::clicked, this, &MainWindow::onNavigationClicked);
     
-    // Create page instances
-    m_systemInfoPage = new SystemInfoPage();
-    m_fanProfilePage = new FanProfilePage();
-    m_lightingPage = new LightingPage();
-    m_settingsPage = new SettingsPage();
-    
-    // Set up cross-page references
-    m_settingsPage->setLightingPage(m_lightingPage);
+    // The driver's port and logging options can't wait for the lazily
+    // built Settings page
+    DriverSettings::applySaved();
     
-    // Add pages to content stack
-    ui->contentStack->addWidget(m_systemInfoPage);
-    ui->contentStack->addWidget(m_fanProfilePage);
-    ui->contentStack->addWidget(m_lightingPage);
-    ui->contentStack->addWidget(m_settingsPage);
+    // Fan control must keep running no matter which page is shown. Sensors
+    // start with it, or with the System Info page when llconnectd does the
+    // fan control
+    setupFanControl();
     
-    // Set initial page
-    ui->contentStack->setCurrentIndex(0);
+    // Pages are created on first navigation (see showPage); the first one
+    // when the window is first shown un-minimized
     ui->systemInfoBtn->setChecked(true);
 }
 
+QWidget *MainWindow::page(int index)
+{
+    switch (index) {
+    case 0:
+        if (!m_systemInfoPage) {
+            setupSensors();
+            m_systemInfoPage = new SystemInfoPage();
+            m_systemInfoPage->setSensorService(m_sensorService);
+            ui->contentStack->addWidget(m_systemInfoPage);
+            VisibilityScheduler::instance()->watch(m_systemInfoPage, this, [this](bool) {
+                updateSensorScope();
+            });
+        }
+        return m_systemInfoPage;
+    case 1:
+        if (!m_fanProfilePage) {
+            m_fanProfilePage = new FanProfilePage();
+            if (m_fanControlEngine) {
+                m_fanProfilePage->setFanControlEngine(m_fanControlEngine);
+            } else {
+                m_fanProfilePage->setDaemonClient(m_daemonClient);
+            }
+            ui->contentStack->addWidget(m_fanProfilePage);
+        }
+        return m_fanProfilePage;
+    case 2:
+        if (!m_lightingPage) {
+            m_lightingPage = new LightingPage();
+            if (!m_fanControlEngine) {
+                m_lightingPage->setDaemonClient(m_daemonClient);
+            }
+            if (m_settingsPage) {
+                m_settingsPage->setLightingPage(m_lightingPage);
+            }
+            ui->contentStack->addWidget(m_lightingPage);
+        }
+        return m_lightingPage;
+    case 3:
+        if (!m_settingsPage) {
+            m_settingsPage = new SettingsPage();
+            // Without a lighting page, its saved settings are reset and it
+            // loads the defaults once created
+            m_settingsPage->setLightingPage(m_lightingPage);
+            ui->contentStack->addWidget(m_settingsPage);
+        }
+        return m_settingsPage;
+    default:
+        return nullptr;
+    }
+}
+
+void MainWindow::showPage(int index)
+{
+    QWidget *widget = page(index);
+    if (widget) {
+        ui->contentStack->setCurrentWidget(widget);
+        m_currentPage = index;
+    }
+}
+
+void MainWindow::setupSensors()
+{
+    if (m_sensorThread) {
+        return;
+    }
+    
+    m_sensorThread = new QThread(this);
+    m_sensorThread->setObjectName("Sensors");
+    
+    m_sensorService = new SensorService();
+    // Until the System Info page is on screen only the local fan loop reads it
+    m_sensorService->setScope(m_fanControlEngine ? SensorService::Scope::Temperatures : SensorService::Scope::Nothing);
+    m_sensorService->moveToThread(m_sensorThread);
+    
+    connect(m_sensorThread, &QThread::started, m_sensorService, &SensorService::start);
+    connect(m_sensorThread, &QThread::finished, m_sensorService, &QObject::deleteLater);
+    
+    m_sensorThread->start();
+}
+
+void MainWindow::updateSensorScope()
+{
+    if (!m_sensorService) {
+        return;
+    }
+    
+    // Storage, network, RAM, clocks and power are only shown on System Info;
+    // the local fan loop needs the temperatures at full rate regardless
+    SensorService::Scope scope = SensorService::Scope::Nothing;
+    if (VisibilityScheduler::isOnScreen(m_systemInfoPage)) {
+        scope = SensorService::Scope::Everything;
+    } else if (m_fanControlEngine) {
+        scope = SensorService::Scope::Temperatures;
+    }
+    
+    QMetaObject::invokeMethod(m_sensorService, [service = m_sensorService, scope]() {
+        service->setScope(scope);
+    }, Qt::QueuedConnection);
+}
+
+void MainWindow::setupFanControl()
+{
+    // The daemon keeps the fans under control when the window is closed;
+    // running a second loop here would fight it over the same ports
+    m_daemonClient = new DaemonClient(this);
+    if (m_daemonClient->connectToDaemon()) {
+        qDebug() << "Fan control is done by llconnectd";
+        return;
+    }
+    
+    // Whoever runs a loop holds the lock; if it is taken, a daemon that
+    // doesn't answer yet (or another window) already drives the fans
+    if (!m_fanControlLock.tryAcquire(DaemonProtocol::fanControlLockPath())) {
+        qDebug() << "Fan control is held by another process - waiting for llconnectd";
+        return;
+    }
+    
+    // The client keeps retrying; a daemon started later takes over
+    connect(m_daemonClient, &DaemonClient::connected, this, &MainWindow::handOverFanControl);
+    
+    m_fanControlThread = new QThread(this);
+    m_fanControlThread->setObjectName("FanControl");
+    
+    m_fanControlEngine = new FanControlEngine();
+    setupSensors();
+    m_fanControlEngine->setSensorService(m_sensorService);
+    m_fanControlEngine->moveToThread(m_fanControlThread);
+    
+    connect(m_fanControlThread, &QThread::started, m_fanControlEngine, &FanControlEngine::start);
+    connect(m_fanControlThread, &QThread::finished, m_fanControlEngine, &QObject::deleteLater);
+    
+    m_fanControlThread->start();
+}
+
+void MainWindow::handOverFanControl()
+{
+    if (!m_fanControlThread) {
+        return;
+    }
+    
+    qDebug() << "llconnectd is up - handing fan control over";
+    disconnect(m_daemonClient, &DaemonClient::connected, this, &MainWindow::handOverFanControl);
+    if (m_fanProfilePage) {
+        m_fanProfilePage->setFanControlEngine(nullptr);
+    }
+    
+    // The engine is deleted on its own thread before wait() returns, so the
+    // daemon can't start its loop while ours still writes
+    m_fanControlThread->quit();
+    m_fanControlThread->wait();
+    m_fanControlThread->deleteLater();
+    m_fanControlThread = nullptr;
+    m_fanControlEngine = nullptr;
+    m_fanControlLock.release();
+    
+    if (m_fanProfilePage) {
+        m_fanProfilePage->setDaemonClient(m_daemonClient);
+    }
+    if (m_lightingPage) {
+        m_lightingPage->setDaemonClient(m_daemonClient);
+    }
+    updateSensorScope();
+}
+
 void MainWindow::setupSidebar()
 {
     // Create sidebar with proper size policy
@@ -435,19 +671,15 @@ void MainWindow::onNavigationClicked()
     // Check clicked button
     button->setChecked(true);
     
-    // Switch to corresponding page
+    // Switch to corresponding page, creating it on first use
     if (button == ui->systemInfoBtn) {
-        ui->contentStack->setCurrentWidget(m_systemInfoPage);
-        m_currentPage = 0;
+        showPage(0);
     } else if (button == ui->fanProfileBtn) {
-        ui->contentStack->setCurrentWidget(m_fanProfilePage);
-        m_currentPage = 1;
+        showPage(1);
     } else if (button == ui->lightingBtn) {
-        ui->contentStack->setCurrentWidget(m_lightingPage);
-        m_currentPage = 2;
+        showPage(2);
     } else if (button == ui->settingsBtn) {
-        ui->contentStack->setCurrentWidget(m_settingsPage);
-        m_currentPage = 3;
+        showPage(3);
     }
 }
 
@@ -11,11 +11,14 @@
 #include <QTabWidget>
 #include <QScrollArea>
 #include <QCheckBox>
+#include <QElapsedTimer>
+#include "daemon/fancontrollock.h"
 
 QT_BEGIN_NAMESPACE
 class QAction;
 class QMenu;
 class QCloseEvent;
+class QThread;
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
@@ -23,6 +26,9 @@ class SystemInfoPage;
 class FanProfilePage;
 class LightingPage;
 class SettingsPage;
+class FanControlEngine;
+class DaemonClient;
+class SensorService;
 
 class MainWindow : public QMainWindow
 {
@@ -31,9 +37,15 @@ class MainWindow : public QMainWindow
 public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
+    
+    // Started at the top of main(); the time to the first frame is logged
+    void setStartupClock(const QElapsedTimer &clock);
 
 protected:
     void closeEvent(QCloseEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void changeEvent(QEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
 
 private slots:
     void onNavigationClicked();
@@ -42,6 +54,15 @@ private slots:
 private:
     Ui::MainWindow *ui;
     void setupUI();
+    void setupSensors();
+    // Matches the sensor sampling to what is on screen
+    void updateSensorScope();
+    void setupFanControl();
+    // A daemon answered after the local loop started; it takes the fans
+    void handOverFanControl();
+    // 0 System Info, 1 Fan Profile, 2 Lighting, 3 Settings; created on first use
+    QWidget *page(int index);
+    void showPage(int index);
     void setupSidebar();
     void setupTopTabs();
     void setupMainContent();
@@ -75,14 +96,30 @@ private:
     // Main content
     QStackedWidget *m_contentStack;
     
-    // Pages
+    // Pages, nullptr until first shown
     SystemInfoPage *m_systemInfoPage;
     FanProfilePage *m_fanProfilePage;
     LightingPage *m_lightingPage;
     SettingsPage *m_settingsPage;
     
+    // Shared sensor sampling, also on its own thread
+    QThread *m_sensorThread;
+    SensorService *m_sensorService;
+    
+    // Fan control runs in llconnectd when it is running; otherwise on its
+    // own thread, holding the lock, until a daemon answers the client
+    DaemonClient *m_daemonClient;
+    QThread *m_fanControlThread;
+    FanControlEngine *m_fanControlEngine;
+    FanControlLock m_fanControlLock;
+    
     // Current page tracking
     int m_currentPage;
+    
+    // Startup timing
+    QElapsedTimer m_startupClock;
+    qint64 m_windowBuiltMs;
+    bool m_firstFrameShown;
 };
 
 #endif // MAINWINDOW_H
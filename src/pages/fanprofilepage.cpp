@@ -1,6 +1,9 @@
 #include "fanprofilepage.h"
 #include "utils/qtdebugutil.h"
+#include "utils/visibilityscheduler.h"
+#include "sensors/hwmonsensors.h"
 #include <QHeaderView>
+#include <QLineEdit>
 #include <QFont>
 #include <QTimer>
 #include <QVector>
@@ -8,9 +11,7 @@
 #include <QFile>
 #include <QTextStream>
 #include <QDebug>
-#include <QProcess>
 #include <QThread>
-#include <QRegularExpression>
 #include <QDir>
 #include <QRandomGenerator>
 #include <QSettings>
@@ -21,17 +22,14 @@
 #include <deque>
 #include <QElapsedTimer>
 #include <QInputDialog>
+#include <QScreen>
 
 FanProfilePage::FanProfilePage(QWidget *parent)
     : QWidget(parent)
-    , m_cachedTemperature(39) // Start with your current temperature
-    , m_temperatureCounter(0)
-    , m_cachedCPULoad(0) // Initialize CPU load
-    , m_cachedGPULoad(0) // Initialize GPU load
-    , m_cachedFanRPMs(4, 0) // Initialize with 4 fans at 0 RPM
     , m_portConnected(4, false) // Initialize port detection
     , m_activePorts() // Empty initially
-    , m_hidController(nullptr)
+    , m_fanControlEngine(nullptr)
+    , m_daemonClient(nullptr)
     , m_selectedPort(1) // Default to Port 1
 {
     // Initialize all ports with 120mm fan size (2100 RPM max) by default
@@ -55,33 +53,11 @@ FanProfilePage::FanProfilePage(QWidget *parent)
     setupFanCurve();
     setupControls();
     
-    // Start fast update timer for visual updates
-    m_updateTimer = new QTimer(this);
-    connect(m_updateTimer, &QTimer::timeout, this, &FanProfilePage::updateFanData);
-    m_updateTimer->start(50); // Update every 50ms for smooth real-time updates
-    
-    // Start slower timer for temperature reading (every 500ms)
-    m_tempUpdateTimer = new QTimer(this);
-    connect(m_tempUpdateTimer, &QTimer::timeout, this, &FanProfilePage::updateTemperature);
-    m_tempUpdateTimer->start(500); // Update temperature every 500ms
-    
-    // Start timer for fan RPM reading (every 1 second)
-    m_fanRPMTimer = new QTimer(this);
-    connect(m_fanRPMTimer, &QTimer::timeout, this, &FanProfilePage::updateFanRPMs);
-    m_fanRPMTimer->start(1000); // Update fan RPMs every 1 second
+    // Fan control (sensor sampling, curve evaluation, speed writes) is done by
+    // FanControlEngine on its own thread - see setFanControlEngine()
     
     // CPU and GPU load monitoring removed - not needed for fan control
     
-    // Initialize HID controller for fan control
-    m_hidController = new LianLiSLInfinityController();
-    if (m_hidController->Initialize()) {
-        qDebug() << "Lian Li device connected successfully";
-        qDebug() << "Device name:" << QString::fromStdString(m_hidController->GetDeviceName());
-        qDebug() << "Firmware version:" << QString::fromStdString(m_hidController->GetFirmwareVersion());
-    } else {
-        qDebug() << "Failed to connect to Lian Li device - fans will not work";
-    }
-    
     // Fan configuration is now handled via Settings page
     
     // Load saved custom curves and profiles
@@ -120,10 +96,156 @@ FanProfilePage::FanProfilePage(QWidget *parent)
     // Connect table selection to update which port's curve is shown
     connect(m_fanTable, &QTableWidget::itemSelectionChanged, this, &FanProfilePage::onPortSelectionChanged);
     
-    // Initial update
-    updateTemperature();
-    updateFanRPMs();
-    updateFanData();
+    // The UI feed runs only while the page is on screen
+    VisibilityScheduler::instance()->watch(this, this, [this](bool) {
+        updateSnapshotPublishing();
+    });
+}
+
+void FanProfilePage::setFanControlEngine(FanControlEngine *engine)
+{
+    if (m_fanControlEngine) {
+        disconnect(m_fanControlEngine, nullptr, this, nullptr);
+    }
+    
+    m_fanControlEngine = engine;
+    // Never leave the graph on the ring of an engine about to be deleted
+    m_fanCurveWidget->setSensorRing(sensorRing(), m_selectedPort);
+    if (!m_fanControlEngine) {
+        return;
+    }
+    
+    // Notifications arrive from the engine thread (queued); the data itself
+    // is read straight from the engine's sample ring
+    connect(m_fanControlEngine, &FanControlEngine::samplesPublished, this, &FanProfilePage::onFanControlSamples);
+    
+    pushCurvesToEngine();
+    pushPortSettingsToEngine();
+    onFanControlSamples();
+    updateSnapshotPublishing();
+}
+
+void FanProfilePage::setDaemonClient(DaemonClient *client)
+{
+    if (m_daemonClient) {
+        disconnect(m_daemonClient, nullptr, this, nullptr);
+    }
+    
+    m_daemonClient = client;
+    m_fanCurveWidget->setSensorRing(sensorRing(), m_selectedPort);
+    if (!m_daemonClient) {
+        return;
+    }
+    
+    connect(m_daemonClient, &DaemonClient::samplesPublished, this, &FanProfilePage::onFanControlSamples);
+    // A restarted daemon loads the saved curves; send the live ones again
+    connect(m_daemonClient, &DaemonClient::connected, this, &FanProfilePage::pushCurvesToEngine);
+    connect(m_daemonClient, &DaemonClient::connected, this, &FanProfilePage::pushPortSettingsToEngine);
+    
+    pushCurvesToEngine();
+    pushPortSettingsToEngine();
+    onFanControlSamples();
+    updateSnapshotPublishing();
+}
+
+const SensorRing *FanProfilePage::sensorRing() const
+{
+    if (m_daemonClient) {
+        return &m_daemonClient->sensorRing();
+    }
+    return m_fanControlEngine ? &m_fanControlEngine->sensorRing() : nullptr;
+}
+
+void FanProfilePage::updateSnapshotPublishing()
+{
+    if (!m_fanControlEngine && !m_daemonClient) {
+        return;
+    }
+    
+    // The engine keeps controlling the fans regardless; only the UI feed is
+    // paused while nobody can see it
+    int interval = 0;
+    if (VisibilityScheduler::isOnScreen(this)) {
+        qreal refreshRate = screen() ? screen()->refreshRate() : 60.0;
+        interval = qBound(16, static_cast<int>(1000.0 / qMax<qreal>(1.0, refreshRate)), 100);
+    }
+    
+    if (m_daemonClient) {
+        m_daemonClient->setPublishInterval(interval);
+        return;
+    }
+    
+    QMetaObject::invokeMethod(m_fanControlEngine.data(), [engine = m_fanControlEngine.data(), interval]() {
+        engine->setPublishInterval(interval);
+    }, Qt::QueuedConnection);
+}
+
+QVector<QPointF> FanProfilePage::effectiveCurveForPort(int port)
+{
+    // A per-port curve always wins
+    if (m_customCurves.contains(port) && m_customCurves[port].size() >= 2) {
+        return m_customCurves[port];
+    }
+    
+    // Otherwise use the curve of the profile assigned to the port
+    QString portProfile = m_portProfiles.value(port, "Quiet");
+    for (int i = 1; i <= 3; ++i) {
+        if (portProfile == m_customProfileNames[i]) {
+            return m_customProfileCurves[i];
+        }
+    }
+    return getDefaultCurveForProfile(getInternalProfileName(portProfile));
+}
+
+void FanProfilePage::pushCurvesToEngine()
+{
+    if (!m_fanControlEngine && !m_daemonClient) {
+        return;
+    }
+    
+    for (int port = 1; port <= 4; ++port) {
+        // Compiled here, once per edit; the engine only ever reads the table
+        FanCurve curve(effectiveCurveForPort(port), m_portInterpolation.value(port, FanCurve::Interpolation::Linear));
+        if (m_daemonClient) {
+            m_daemonClient->setPortCurve(port, curve);
+            continue;
+        }
+        QMetaObject::invokeMethod(m_fanControlEngine.data(), [engine = m_fanControlEngine.data(), port, curve]() {
+            engine->setPortCurve(port, curve);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void FanProfilePage::pushPortSettingsToEngine()
+{
+    if (!m_fanControlEngine && !m_daemonClient) {
+        return;
+    }
+    
+    for (int port = 1; port <= 4; ++port) {
+        const FanControlStrategy::Kind kind = m_portStrategy.value(port, FanControlStrategy::Kind::Heuristic);
+        const QString sensor = m_portSensor.value(port, "cpu");
+        if (m_daemonClient) {
+            m_daemonClient->setPortStrategy(port, kind);
+            m_daemonClient->setPortSensor(port, sensor);
+            continue;
+        }
+        QMetaObject::invokeMethod(m_fanControlEngine.data(), [engine = m_fanControlEngine.data(), port, kind, sensor]() {
+            engine->setPortStrategy(port, kind);
+            engine->setPortSensor(port, sensor);
+        }, Qt::QueuedConnection);
+    }
+    
+    DutyOutputStage::Parameters output;
+    output.hysteresis = m_hysteresisSpin->value();
+    output.minDwell = m_dwellSpin->value();
+    if (m_daemonClient) {
+        m_daemonClient->setOutputParameters(output);
+        return;
+    }
+    QMetaObject::invokeMethod(m_fanControlEngine.data(), [engine = m_fanControlEngine.data(), output]() {
+        engine->setOutputParameters(output);
+    }, Qt::QueuedConnection);
 }
 
 void FanProfilePage::setupUI()
@@ -412,6 +534,73 @@ void FanProfilePage::setupControls()
     
     buttonsLayout->addWidget(m_applyToAllButton);
     buttonsLayout->addWidget(m_defaultButton);
+    
+    // How the selected port's curve runs between its points
+    QLabel *interpolationLabel = new QLabel("Curve shape");
+    interpolationLabel->setObjectName("controlLabel");
+    m_interpolationCombo = new QComboBox();
+    m_interpolationCombo->addItem("Linear", static_cast<int>(FanCurve::Interpolation::Linear));
+    m_interpolationCombo->addItem("Smooth", static_cast<int>(FanCurve::Interpolation::MonotoneCubic));
+    m_interpolationCombo->addItem("Step", static_cast<int>(FanCurve::Interpolation::Step));
+    m_interpolationCombo->setToolTip("Straight lines, a smooth curve that never overshoots, or steps that hold each point's RPM");
+    connect(m_interpolationCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FanProfilePage::onInterpolationChanged);
+    
+    // What turns the selected port's curve into a fan speed
+    QLabel *strategyLabel = new QLabel("Controller");
+    strategyLabel->setObjectName("controlLabel");
+    m_strategyCombo = new QComboBox();
+    m_strategyCombo->addItem("Heuristic", FanControlStrategy::kindName(FanControlStrategy::Kind::Heuristic));
+    m_strategyCombo->addItem("PID", FanControlStrategy::kindName(FanControlStrategy::Kind::Pid));
+    m_strategyCombo->addItem("Predictive", FanControlStrategy::kindName(FanControlStrategy::Kind::Predictive));
+    m_strategyCombo->setToolTip("Follow the curve with look-ahead, add PID cooling above it, or pick the quietest speed that keeps the temperature in bounds");
+    connect(m_strategyCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FanProfilePage::onStrategyChanged);
+    
+    buttonsLayout->addWidget(interpolationLabel);
+    buttonsLayout->addWidget(m_interpolationCombo);
+    // Temperature the selected port's curve follows; any SensorExpression
+    QLabel *sensorLabel = new QLabel("Sensor");
+    sensorLabel->setObjectName("controlLabel");
+    m_sensorCombo = new QComboBox();
+    m_sensorCombo->setEditable(true);
+    m_sensorCombo->setInsertPolicy(QComboBox::NoInsert);
+    m_sensorCombo->addItems({ "cpu", "gpu", "nvme", "liquid", "max(cpu, gpu - 10)", "avg(cpu, gpu)" });
+    for (const QString &channel : HwmonChannel::available()) {
+        const int slash = channel.indexOf('/');
+        m_sensorCombo->addItem(QString("hwmon(\"%1\", \"%2\")").arg(channel.left(slash), channel.mid(slash + 1)));
+    }
+    m_sensorCombo->setToolTip("cpu, gpu, nvme, liquid or hwmon(\"chip\", \"label\"), combined with max, min, avg, blend and + - * /");
+    connect(m_sensorCombo, QOverload<int>::of(&QComboBox::activated), this, &FanProfilePage::onSensorEdited);
+    connect(m_sensorCombo->lineEdit(), &QLineEdit::editingFinished, this, &FanProfilePage::onSensorEdited);
+    
+    buttonsLayout->addWidget(strategyLabel);
+    buttonsLayout->addWidget(m_strategyCombo);
+    // How eagerly every port steps down; rises are always sent at once
+    QLabel *hysteresisLabel = new QLabel("Smallest drop");
+    hysteresisLabel->setObjectName("controlLabel");
+    m_hysteresisSpin = new QSpinBox();
+    m_hysteresisSpin->setRange(0, 20);
+    m_hysteresisSpin->setSuffix(" %");
+    m_hysteresisSpin->setValue(DutyOutputStage::Parameters().hysteresis);
+    m_hysteresisSpin->setToolTip("Speed drops smaller than this are not sent to the fans (all ports)");
+    connect(m_hysteresisSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &FanProfilePage::onOutputChanged);
+    
+    QLabel *dwellLabel = new QLabel("Drop delay");
+    dwellLabel->setObjectName("controlLabel");
+    m_dwellSpin = new QDoubleSpinBox();
+    m_dwellSpin->setRange(0.0, 30.0);
+    m_dwellSpin->setSingleStep(0.5);
+    m_dwellSpin->setDecimals(1);
+    m_dwellSpin->setSuffix(" s");
+    m_dwellSpin->setValue(DutyOutputStage::Parameters().minDwell);
+    m_dwellSpin->setToolTip("Time after any speed change before the fans may slow down (all ports)");
+    connect(m_dwellSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &FanProfilePage::onOutputChanged);
+    
+    buttonsLayout->addWidget(sensorLabel);
+    buttonsLayout->addWidget(m_sensorCombo);
+    buttonsLayout->addWidget(hysteresisLabel);
+    buttonsLayout->addWidget(m_hysteresisSpin);
+    buttonsLayout->addWidget(dwellLabel);
+    buttonsLayout->addWidget(m_dwellSpin);
     buttonsLayout->addStretch();
     
     fanCurveLayout->addLayout(buttonsLayout);
@@ -523,144 +712,52 @@ void FanProfilePage::updateFanCurve()
     }
 }
 
-void FanProfilePage::updateTemperature()
+void FanProfilePage::onFanControlSamples()
 {
-    // Try to get real CPU temperature first, fall back to simulation
-    int realTemp = getRealCPUTemperature();
-    
-    if (realTemp != -1) {
-        // Use real temperature
-        m_cachedTemperature = realTemp;
-    } else {
-        // Use simulation with smooth variation
-        m_temperatureCounter++;
-        int baseTemp = 39; // Your current temperature
-        int tempVariation = (m_temperatureCounter % 120) - 60; // -60 to +60 variation
-        m_cachedTemperature = qMax(25, qMin(85, baseTemp + tempVariation));
+    // Each port's curve may follow a different sensor; the graph reads the
+    // selected port's point and history from the ring itself. Handed over
+    // before anything else: after a source switch the old ring may be gone
+    // while the new one is still empty
+    const SensorRing *ring = sensorRing();
+    m_fanCurveWidget->setSensorRing(ring, m_selectedPort);
+    
+    SensorSample sample;
+    if (!ring || !ring->latest(sample)) {
+        return;
     }
-}
-
-void FanProfilePage::updateFanRPMs()
-{
-    // Try to get real fan RPMs first, fall back to simulation
-    QVector<int> realRPMs = getRealFanRPMs();
     
-    if (!realRPMs.isEmpty()) {
-        // Use real fan RPMs
-        m_cachedFanRPMs = realRPMs;
-        // qDebug() << "Using real fan RPMs:" << m_cachedFanRPMs;
-    } else {
-        // Use enhanced simulation with more realistic fan behavior
-        static int simulationCounter = 0;
-        simulationCounter++;
-        
-        for (int i = 0; i < 4; ++i) {
-            if (i == 2) {
-                // Port 3 is off
-                m_cachedFanRPMs[i] = 0;
-            } else {
-                // Simulate realistic fan RPM based on temperature and profile
-                int baseRPM = calculateRPMForTemperature(m_cachedTemperature);
-                
-                // Add more realistic variation based on fan characteristics
-                int variation = 0;
-                if (baseRPM < 500) {
-                    // Low RPM fans have less variation
-                    variation = QRandomGenerator::global()->bounded(50) - 25;
-                } else if (baseRPM < 1500) {
-                    // Medium RPM fans have moderate variation
-                    variation = QRandomGenerator::global()->bounded(100) - 50;
-                } else {
-                    // High RPM fans have more variation
-                    variation = QRandomGenerator::global()->bounded(150) - 75;
-                }
-                
-                // Add some "breathing" effect - fans don't change instantly
-                int targetRPM = qMax(0, baseRPM + variation);
-                
-                // Smooth transition to target RPM (simulate fan inertia)
-                if (m_cachedFanRPMs[i] == 0) {
-                    m_cachedFanRPMs[i] = targetRPM; // Instant start
-                } else {
-                    int currentRPM = m_cachedFanRPMs[i];
-                    int diff = targetRPM - currentRPM;
-                    int change = diff / 10; // Gradual change
-                    if (change == 0 && diff != 0) {
-                        change = (diff > 0) ? 1 : -1; // At least 1 RPM change
-                    }
-                    m_cachedFanRPMs[i] = qMax(0, currentRPM + change);
-                }
-                
-                // Ensure minimum RPM for running fans (except when off)
-                if (m_cachedFanRPMs[i] > 0 && m_cachedFanRPMs[i] < 200) {
-                    m_cachedFanRPMs[i] = 200 + QRandomGenerator::global()->bounded(100);
-                }
-            }
-        }
-        
-        // Debug output every 10 updates
-        if (simulationCounter % 10 == 0) {
-            // qDebug() << "Simulated fan RPMs (temp:" << m_cachedTemperature << "°C):" << m_cachedFanRPMs;
-        }
-    }
-}
-
-void FanProfilePage::updateFanData()
-{
-    // Use cached temperature for fast updates
-    int currentTemp = m_cachedTemperature;
-    
-    // Calculate corresponding RPM based on current profile (for curve reference)
-    int calculatedRPM = calculateRPMForTemperature(currentTemp);
-    
-    // Get average fake RPM from connected fans (based on temperature and profile)
-    int realRPM = 0;
-    if (!m_activePorts.isEmpty()) {
-        int totalRPM = 0;
-        int activeCount = 0;
-        for (int port : m_activePorts) {
-            int portRPM = getRealFanRPM(port);
-            totalRPM += portRPM;
-            if (portRPM > 0) activeCount++;
-        }
-        realRPM = activeCount > 0 ? totalRPM / activeCount : 0;
+    for (int row = 0; row < 4; ++row) {
+        m_portConnected[row] = sample.isConnected(row + 1);
     }
     
-    // Update fan curve widget - show real RPM instead of calculated
-    m_fanCurveWidget->setCurrentTemperature(currentTemp);
-    m_fanCurveWidget->setCurrentRPM(realRPM);
-    
-    // Force update of the fan curve widget
-    m_fanCurveWidget->update();
+    // Update the existing cells in place; only touch what changed
+    auto setCellText = [this](int row, int column, const QString &text) -> QTableWidgetItem * {
+        QTableWidgetItem *item = m_fanTable->item(row, column);
+        if (item && item->text() != text) {
+            item->setText(text);
+        }
+        return item;
+    };
     
-    // Update table data for all 4 ports
     for (int row = 0; row < 4; ++row) {
         int port = row + 1; // Port numbers are 1-4
         
-        // Always try to get RPM from kernel driver - let user see which ports work
-        int realRPM = getRealFanRPM(port);
-        
         // Profile - display the profile assigned to this port
-        QString portProfile = m_portProfiles.value(port, "Quiet");
-        QTableWidgetItem *profileItem = new QTableWidgetItem(portProfile);
-        profileItem->setFlags(profileItem->flags() & ~Qt::ItemIsEditable); // Make read-only
-        m_fanTable->setItem(row, 2, profileItem);
+        setCellText(row, 2, m_portProfiles.value(port, "Quiet"));
         
-        // Temperature with color coding (show for all ports)
-        QTableWidgetItem *tempItem = new QTableWidgetItem(QString::number(currentTemp) + "°C");
-        tempItem->setForeground(getTemperatureColor(currentTemp));
-        tempItem->setFlags(tempItem->flags() & ~Qt::ItemIsEditable); // Make read-only
-        m_fanTable->setItem(row, 3, tempItem);
+        // Temperature the port's curve follows, with color coding (show for all ports)
+        int portTemperature = qRound(sample.portTemperature[row]);
+        QString tempText = QString::number(portTemperature) + "°C";
+        QColor tempColor = getTemperatureColor(portTemperature);
+        QTableWidgetItem *tempItem = setCellText(row, 3, tempText);
+        if (tempItem && tempItem->foreground().color() != tempColor) {
+            tempItem->setForeground(tempColor);
+        }
         
-        // RPM with orange color (0 for inactive ports)
-        QTableWidgetItem *rpmItem = new QTableWidgetItem(QString::number(realRPM) + " RPM");
-        rpmItem->setForeground(QColor(255, 165, 0)); // Orange color
-        rpmItem->setFlags(rpmItem->flags() & ~Qt::ItemIsEditable); // Make read-only
-        m_fanTable->setItem(row, 4, rpmItem);
+        // RPM (0 for ports without a fan)
+        int rpm = m_portConnected[row] ? sample.rpm[row] : 0;
+        setCellText(row, 4, QString::number(rpm) + " RPM");
     }
-    
-    // Control fan speeds based on temperature and profile
-    controlFanSpeeds();
 }
 
 void FanProfilePage::onProfileChanged()
@@ -698,6 +795,7 @@ void FanProfilePage::onProfileChanged()
     
     // Save port profiles
     savePortProfiles();
+    pushCurvesToEngine();
     
     qDebug() << "Applied profile" << currentProfile << "to Port" << m_selectedPort;
     
@@ -708,18 +806,26 @@ void FanProfilePage::onApplyToAllClicked()
 {
     QString currentProfile = getCurrentProfile();
     QVector<QPointF> currentCurve = m_fanCurveWidget->getCurvePoints();
+    const FanCurve::Interpolation interpolation = m_portInterpolation.value(m_selectedPort, FanCurve::Interpolation::Linear);
+    const FanControlStrategy::Kind strategy = m_portStrategy.value(m_selectedPort, FanControlStrategy::Kind::Heuristic);
+    const QString sensor = m_portSensor.value(m_selectedPort, "cpu");
     
     qDebug() << "Apply To All clicked - applying profile" << currentProfile << "to all ports";
     
-    // Apply the current profile and curve to all ports
+    // Apply the current profile and curve (shape included) to all ports
     for (int port = 1; port <= 4; ++port) {
         m_portProfiles[port] = currentProfile;
         m_customCurves[port] = currentCurve;
+        m_portInterpolation[port] = interpolation;
+        m_portStrategy[port] = strategy;
+        m_portSensor[port] = sensor;
     }
     
     // Save all curves and port profiles
     saveCustomCurves();
     savePortProfiles();
+    pushCurvesToEngine();
+    pushPortSettingsToEngine();
     
     qDebug() << "Applied profile" << currentProfile << "to all 4 ports";
 }
@@ -770,206 +876,10 @@ void FanProfilePage::onDefaultClicked()
         
         qDebug() << "Reset Port" << m_selectedPort << "to" << displayName << "default curve";
     }
-}
-
-
-int FanProfilePage::calculateRPMForTemperature(int temperature)
-{
-    // Define curve data points for each profile (RPM values)
-    QVector<QPointF> curvePoints;
-    
-    // Check if a custom profile is selected
-    if (m_custom1Radio->isChecked()) {
-        curvePoints = m_customProfileCurves[1];
-    } else if (m_custom2Radio->isChecked()) {
-        curvePoints = m_customProfileCurves[2];
-    } else if (m_custom3Radio->isChecked()) {
-        curvePoints = m_customProfileCurves[3];
-    } else {
-        // Get current built-in profile (display name) and convert to internal name
-        QString displayName = getCurrentProfile();
-        QString profile = getInternalProfileName(displayName);
-    
-        if (profile == "Quiet") {
-            curvePoints << QPointF(0, 120) << QPointF(25, 420) << QPointF(45, 840) 
-                       << QPointF(65, 1050) << QPointF(80, 1680) << QPointF(90, 2100) << QPointF(100, 2100);
-        } else if (profile == "Standard") {
-            // Standard Speed (StdSP): Balanced curve
-            curvePoints << QPointF(0, 120) << QPointF(25, 420) << QPointF(40, 1050) << QPointF(55, 1260) 
-                       << QPointF(70, 1680) << QPointF(90, 2100) << QPointF(100, 2100);
-        } else if (profile == "High Speed") {
-            // High Speed (HighSP): Smooth progressive ramp
-            curvePoints << QPointF(0, 120) << QPointF(25, 910) << QPointF(35, 1140) << QPointF(50, 1470)
-                       << QPointF(70, 1800) << QPointF(85, 2100) << QPointF(100, 2100);
-        } else if (profile == "Full Speed") {
-            curvePoints << QPointF(0, 120) << QPointF(25, 2100) << QPointF(40, 2100) << QPointF(55, 2100)
-                       << QPointF(70, 2100) << QPointF(90, 2100) << QPointF(100, 2100);
-        } else {
-            // Default to Quiet (original Lian Li curve)
-            curvePoints << QPointF(0, 120) << QPointF(25, 420) << QPointF(45, 840) 
-                       << QPointF(65, 1050) << QPointF(80, 1680) << QPointF(90, 2100) << QPointF(100, 2100);
-        }
-    }
     
-    // Clamp temperature to valid range
-    temperature = qMax(0, qMin(100, temperature));
-    
-    // Find the two points to interpolate between
-    for (int i = 0; i < curvePoints.size() - 1; ++i) {
-        if (temperature >= curvePoints[i].x() && temperature <= curvePoints[i + 1].x()) {
-            // Linear interpolation between the two points
-            double t = (temperature - curvePoints[i].x()) / (curvePoints[i + 1].x() - curvePoints[i].x());
-            double rpm = curvePoints[i].y() + t * (curvePoints[i + 1].y() - curvePoints[i].y());
-            
-            // Convert RPM to percentage (assuming max RPM is 1200 for Lian Li fans)
-            // For display purposes, we'll return the RPM value
-            // For control purposes, we'll convert to percentage in controlFanSpeeds()
-            return static_cast<int>(rpm);
-        }
-    }
-    
-    // If temperature is outside the curve range, clamp to nearest point
-    if (temperature < curvePoints.first().x()) {
-        return static_cast<int>(curvePoints.first().y());
-    } else {
-        return static_cast<int>(curvePoints.last().y());
-    }
+    pushCurvesToEngine();
 }
 
-int FanProfilePage::getRealCPUTemperature()
-{
-    // Use the same temperature reading method as System Info page
-    int maxTemp = 0;
-    
-    // Method 1: Try sensors command first (most accurate) - same as System Info
-    QProcess sensorsProcess;
-    sensorsProcess.start("sensors", QStringList() << "k10temp-pci-00c3");
-    sensorsProcess.waitForFinished(1000);
-    
-    if (sensorsProcess.exitCode() == 0) {
-        QString output = sensorsProcess.readAllStandardOutput();
-        // Look for Tctl temperature (CPU core temperature) - same as System Info
-        QRegularExpression tempRegex("Tctl:\\s*\\+?([0-9.]+)°C");
-        QRegularExpressionMatch match = tempRegex.match(output);
-        if (match.hasMatch()) {
-            maxTemp = static_cast<int>(match.captured(1).toDouble());
-        }
-    }
-    
-    // Method 2: Fallback to hwmon if sensors didn't work - same as System Info
-    if (maxTemp == 0) {
-        QDir hwmonDir("/sys/class/hwmon");
-        QStringList hwmonDirs = hwmonDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-        
-        for (const QString &hwmon : hwmonDirs) {
-            QFile nameFile("/sys/class/hwmon/" + hwmon + "/name");
-            if (nameFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&nameFile);
-                QString name = stream.readLine().trimmed();
-                nameFile.close();
-                
-                // Check for CPU temperature sensors - same as System Info
-                if (name.contains("coretemp") || name.contains("k10temp") || name.contains("zenpower") || 
-                    name.contains("asus") || name.contains("acpi")) {
-                    
-                    QDir hwmonSubDir("/sys/class/hwmon/" + hwmon);
-                    QStringList files = hwmonSubDir.entryList(QDir::Files);
-                    for (const QString &file : files) {
-                        if (file.startsWith("temp") && file.endsWith("_input")) {
-                            QFile tempFile("/sys/class/hwmon/" + hwmon + "/" + file);
-                            if (tempFile.open(QIODevice::ReadOnly)) {
-                                QTextStream tStream(&tempFile);
-                                QString tempStr = tStream.readLine();
-                                if (!tempStr.isEmpty()) {
-                                    int temp = tempStr.toInt() / 1000; // Convert millidegrees to degrees
-                                    if (temp > maxTemp && temp < 200) { // Reasonable temperature range
-                                        maxTemp = temp;
-                                    }
-                                }
-                                tempFile.close();
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-    
-    // Method 3: Fallback to thermal zones if hwmon didn't work - same as System Info
-    if (maxTemp == 0) {
-        QDir thermalDir("/sys/class/thermal");
-        QStringList thermalZones = thermalDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-        for (const QString &zone : thermalZones) {
-            if (zone.startsWith("thermal_zone")) {
-                QFile tempFile("/sys/class/thermal/" + zone + "/temp");
-                if (tempFile.open(QIODevice::ReadOnly)) {
-                    QTextStream stream(&tempFile);
-                    int temp = stream.readLine().toInt() / 1000; // Convert millidegrees to degrees
-                    if (temp > maxTemp) maxTemp = temp;
-                    tempFile.close();
-                }
-            }
-        }
-    }
-    
-    // Return the temperature or -1 to indicate failure
-    return maxTemp > 0 ? maxTemp : -1;
-}
-
-QVector<int> FanProfilePage::getRealFanRPMs()
-{
-    QVector<int> fanRPMs(4, 0); // Initialize with 4 ports, all at 0 RPM
-    
-    // Read real RPMs from kernel driver for all ports
-    for (int port = 1; port <= 4; ++port) {
-        fanRPMs[port - 1] = getRealFanRPM(port);
-    }
-    
-    return fanRPMs;
-}
-
-int FanProfilePage::getRealFanRPM(int port)
-{
-    if (port < 1 || port > 4) {
-        return 0;
-    }
-    
-    // Check if fan is connected using kernel driver detection
-    QString connectedPath = QString("/proc/Lian_li_SL_INFINITY/Port_%1/fan_connected").arg(port);
-    QFile connectedFile(connectedPath);
-    
-    if (connectedFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&connectedFile);
-        QString connectedStr = stream.readLine().trimmed();
-        connectedFile.close();
-        
-        bool ok;
-        int connected = connectedStr.toInt(&ok);
-        
-        if (ok && connected == 0) {
-            // Fan not connected according to kernel driver
-            return 0;
-        }
-    } else {
-        // If we can't read the status, assume not connected
-        return 0;
-    }
-    
-    // Fan is connected - show fake RPM based on temperature and custom curve
-    // This gives a realistic RPM display even though we can't read actual RPM
-    int baseRPM = calculateRPMForCustomCurve(port, m_cachedTemperature);
-    
-    // Add some realistic noise (±50 RPM)
-    static int noiseCounter = 0;
-    noiseCounter++;
-    int noise = ((noiseCounter % 100) - 50); // -50 to +50
-    int fakeRPM = baseRPM + noise;
-    
-    // Clamp to reasonable range
-    fakeRPM = qBound(400, fakeRPM, 2100); // Minimum 400 RPM to show it's running
-    
-    return fakeRPM;
-}
 
 int FanProfilePage::convertPercentageToRPM(int percentage)
 {
@@ -987,331 +897,6 @@ int FanProfilePage::convertPercentageToRPM(int percentage)
     return rpm;
 }
 
-void FanProfilePage::controlFanSpeeds()
-{
-    if (!m_hidController) {
-        return;
-    }
-    
-    // Get current CPU temperature
-    int currentTemp = m_cachedTemperature;
-    
-    // --- state (static inside controlFanSpeeds or make members) ---
-    static double Tf = 0.0;                // filtered temp
-    static std::deque<double> hist;        // short history for derivative
-    static QMap<int, int> rpm_out;         // Per-port RPM output
-    static QElapsedTimer stepTimer;
-    
-    // Initialize rpm_out for all ports if empty
-    if (rpm_out.isEmpty()) {
-        for (int port = 1; port <= 4; ++port) {
-            rpm_out[port] = 0;
-        }
-    }
-    
-    double dt = stepTimer.isValid() ? stepTimer.restart()/1000.0 : 0.1;
-    if (dt <= 0) dt = 0.1;
-
-    // 1) Very fast asymmetric filter - almost instant response when heating
-    int Traw = currentTemp;  // your measured temp
-    double alpha = (Traw >= Tf) ? 0.95 : 0.60;  // VERY fast heating response, moderate cooling
-    Tf += alpha * (Traw - Tf);
-
-    // Keep short history for derivative (0.3s)
-    int histMax = std::max(2, int(std::round(0.3 / dt)));
-    hist.push_back(Tf);
-    while ((int)hist.size() > histMax) hist.pop_front();
-
-    // 2) Calculate temperature rate of change
-    double dTdt = 0.0;
-    if (hist.size() >= 2) dTdt = (hist.back() - hist.front()) / std::max(0.1, dt*(hist.size()-1));
-    if (dTdt < 0) dTdt = 0;  // Only care about heating
-    if (dTdt > 10.0) dTdt = 10.0;  // Allow very high rate of change
-
-    // Determine if heating
-    const bool heating = (dTdt > 0.02);   // very small threshold
-
-    // 3-8) Control each port individually using its custom curve
-    for (int port = 1; port <= 4; ++port) {
-        // Calculate base RPM from this port's custom curve
-        int base_now  = calculateRPMForCustomCurve(port, int(std::round(Tf)));
-        int base_pred = calculateRPMForCustomCurve(port, int(std::round(Tf + dTdt * 10.0))); // Look ahead 10 seconds
-        
-        int base_rpm  = heating ? std::max(base_now, base_pred) : base_now;
-        
-        // Aggressive feedforward proportional to heating rate
-        int ff_rpm = heating ? int(std::round(dTdt * 800.0)) : 0; // Very aggressive
-        
-        // Extra boost when heating rapidly (>0.3°C/s)
-        int boostRPM = 0;
-        if (heating && dTdt > 0.3) {
-            boostRPM = 400;  // Extra 400 RPM boost when heating fast
-        }
-
-        int target = std::clamp(base_rpm + ff_rpm + boostRPM, 0, 2100);
-
-        // Simplified slew rate control - very fast response
-        double up_slew = 1500.0;    // RPM/s upward (VERY FAST)
-        double down_slew = 200.0;   // RPM/s downward (moderate)
-        
-        // Even faster at high temperatures
-        if (Tf > 65.0) {
-            up_slew = 2000.0;       // EXTREMELY fast at high temps
-            down_slew = 300.0;      // Faster cooling too
-        }
-        
-        int maxStepUp = std::max(1, int(std::round(up_slew * dt)));
-        int maxStepDown = std::max(1, int(std::round(down_slew * dt)));
-        
-        // Apply slew limits
-        int gated = rpm_out[port];
-        if (target > rpm_out[port]) {
-            // Going up - apply max step
-            gated = std::min(target, rpm_out[port] + maxStepUp);
-        } else if (target < rpm_out[port]) {
-            // Going down - apply max step
-            gated = std::max(target, rpm_out[port] - maxStepDown);
-        }
-        
-        // Simple write threshold - write if change is meaningful
-        int writeThresh = 10;  // 10 RPM threshold
-        bool shouldWrite = false;
-        
-        if (std::abs(gated - rpm_out[port]) >= writeThresh || rpm_out[port] == 0) {
-            shouldWrite = true;
-        }
-
-        if (shouldWrite) {
-            setFanSpeed(port, gated);
-            rpm_out[port] = gated;
-            DEBUG_LOG_CATEGORY("FanSpeeds", "Port", port, ": T=", Tf, "°C dT/dt=", dTdt, "°C/s"
-                     , " heating=", heating, " base=", base_rpm 
-                     , " target=", target, " -> RPM=", rpm_out[port]);
-        }
-    }
-}
-
-void FanProfilePage::setFanSpeed(int port, int targetRPM)
-{
-    // Clamp speed to valid range
-    // Minimum 840 RPM to prevent fan shutdown (allow 120 RPM for idle)
-    if (targetRPM > 120 && targetRPM < 840) {
-        targetRPM = 840; // Enforce minimum operating speed
-    }
-    targetRPM = qBound(0, targetRPM, 2100);
-    
-    // Convert RPM to percentage for kernel driver
-    // Based on calibration: Percentage = RPM / 21
-    // 840 RPM = 40%, 1260 RPM = 60%, 1680 RPM = 80%, 2100 RPM = 100%
-    int speedPercent = targetRPM / 21;
-    
-    // Clamp to valid range
-    speedPercent = qBound(0, speedPercent, 100);
-    
-    // Calculate expected dBA based on calibration
-    // Linear interpolation from calibrated values:
-    // 840 RPM = 34 dBA, 1040 RPM = 39 dBA, 1260 RPM = 45 dBA, 
-    // 1480 RPM = 49 dBA, 1680 RPM = 52 dBA, 1880 RPM = 56 dBA, 2100 RPM = 60 dBA
-    double expectedDBA = 0.0;
-    if (targetRPM <= 840) {
-        expectedDBA = 34.0 + (targetRPM - 840) * (34.0 - 0.0) / (840 - 0);
-    } else if (targetRPM <= 1040) {
-        expectedDBA = 34.0 + (targetRPM - 840) * (39.0 - 34.0) / (1040 - 840);
-    } else if (targetRPM <= 1260) {
-        expectedDBA = 39.0 + (targetRPM - 1040) * (45.0 - 39.0) / (1260 - 1040);
-    } else if (targetRPM <= 1480) {
-        expectedDBA = 45.0 + (targetRPM - 1260) * (49.0 - 45.0) / (1480 - 1260);
-    } else if (targetRPM <= 1680) {
-        expectedDBA = 49.0 + (targetRPM - 1480) * (52.0 - 49.0) / (1680 - 1480);
-    } else if (targetRPM <= 1880) {
-        expectedDBA = 52.0 + (targetRPM - 1680) * (56.0 - 52.0) / (1880 - 1680);
-    } else {
-        expectedDBA = 56.0 + (targetRPM - 1880) * (60.0 - 56.0) / (2100 - 1880);
-    }
-    
-    // Debug: show what we're actually sending
-    DEBUG_LOG_CATEGORY("FanSpeeds", "RPM conversion: targetRPM=", targetRPM, " -> speedPercent=", speedPercent, "%");
-    DEBUG_LOG_CATEGORY("FanSpeeds", "Expected dBA for", targetRPM, "RPM:", expectedDBA);
-    
-    // Use kernel driver for individual port control (more reliable)
-    QString procPath = QString("/proc/Lian_li_SL_INFINITY/Port_%1/fan_speed").arg(port);
-    QFile file(procPath);
-    
-    if (file.open(QIODevice::WriteOnly)) {
-        QTextStream stream(&file);
-        stream << speedPercent;
-        file.close();
-        
-        
-        DEBUG_LOG_CATEGORY("FanSpeeds", "Set Port", port, "to", targetRPM, "RPM (", speedPercent, "%, expected dBA=", expectedDBA, ") via kernel driver");
-    } else {
-        DEBUG_LOG_CATEGORY("FanSpeeds", "Failed to open", procPath, "for writing - falling back to USB HID");
-        
-        // Fallback to USB HID controller if kernel driver fails
-        if (m_hidController) {
-            uint8_t channel = port - 1;
-            bool success = m_hidController->SetChannelSpeed(channel, speedPercent);
-            
-            if (success) {
-                DEBUG_LOG_CATEGORY("FanSpeeds", "Set Port", port, "(Channel", channel, ") to", targetRPM, "RPM (", speedPercent, "%, expected dBA=", expectedDBA, ") via USB HID fallback");
-            } else {
-                DEBUG_LOG_CATEGORY("FanSpeeds", "Failed to set Port", port, "(Channel", channel, ") to", targetRPM, "RPM via USB HID fallback");
-            }
-        } else {
-            qDebug() << "HID controller not available for Port" << port;
-        }
-    }
-}
-
-// CPU and GPU load monitoring removed - not needed for fan control
-
-int FanProfilePage::getRealCPULoad()
-{
-    // Method 1: Try /proc/loadavg (1-minute average)
-    QFile loadavgFile("/proc/loadavg");
-    if (loadavgFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&loadavgFile);
-        QString line = stream.readLine();
-        loadavgFile.close();
-        
-        QStringList parts = line.split(' ');
-        if (parts.size() >= 3) {
-            double load1min = parts[0].toDouble();
-            // Convert load average to percentage (rough approximation)
-            // Assuming 4 cores, load > 4.0 = 100%
-            int loadPercent = qMin(100, static_cast<int>((load1min / 4.0) * 100));
-            return loadPercent;
-        }
-    }
-    
-    // Method 2: Try /proc/stat (more accurate)
-    QFile statFile("/proc/stat");
-    if (statFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&statFile);
-        QString line = stream.readLine();
-        statFile.close();
-        
-        if (line.startsWith("cpu ")) {
-            QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 8) {
-                // Parse CPU times: user, nice, system, idle, iowait, irq, softirq, steal
-                qint64 user = parts[1].toLongLong();
-                qint64 nice = parts[2].toLongLong();
-                qint64 system = parts[3].toLongLong();
-                qint64 idle = parts[4].toLongLong();
-                qint64 iowait = parts[5].toLongLong();
-                qint64 irq = parts[6].toLongLong();
-                qint64 softirq = parts[7].toLongLong();
-                qint64 steal = parts.size() > 8 ? parts[8].toLongLong() : 0;
-                
-                qint64 totalIdle = idle + iowait;
-                qint64 totalNonIdle = user + nice + system + irq + softirq + steal;
-                qint64 total = totalIdle + totalNonIdle;
-                
-                // Calculate CPU usage percentage
-                static qint64 prevTotal = 0;
-                static qint64 prevIdle = 0;
-                
-                if (prevTotal > 0) {
-                    qint64 totalDiff = total - prevTotal;
-                    qint64 idleDiff = totalIdle - prevIdle;
-                    
-                    if (totalDiff > 0) {
-                        int cpuPercent = static_cast<int>(((totalDiff - idleDiff) * 100) / totalDiff);
-                        prevTotal = total;
-                        prevIdle = totalIdle;
-                        return qMax(0, qMin(100, cpuPercent));
-                    }
-                }
-                
-                prevTotal = total;
-                prevIdle = totalIdle;
-            }
-        }
-    }
-    
-    return -1; // Failed to get CPU load
-}
-
-int FanProfilePage::getRealGPULoad()
-{
-    // Method 1: Try nvidia-smi (NVIDIA GPUs)
-    QProcess nvidiaProcess;
-    nvidiaProcess.start("nvidia-smi", QStringList() << "--query-gpu=utilization.gpu" << "--format=csv,noheader,nounits");
-    nvidiaProcess.waitForFinished(1000);
-    
-    if (nvidiaProcess.exitCode() == 0) {
-        QString output = nvidiaProcess.readAllStandardOutput().trimmed();
-        bool ok;
-        int gpuLoad = output.toInt(&ok);
-        if (ok && gpuLoad >= 0 && gpuLoad <= 100) {
-            return gpuLoad;
-        }
-    }
-    
-    // Method 2: Try radeontop (AMD GPUs)
-    QProcess radeonProcess;
-    radeonProcess.start("radeontop", QStringList() << "-d" << "1" << "-l" << "1");
-    radeonProcess.waitForFinished(2000);
-    
-    if (radeonProcess.exitCode() == 0) {
-        QString output = radeonProcess.readAllStandardOutput();
-        QRegularExpression gpuRegex("gpu\\s+(\\d+)%");
-        QRegularExpressionMatch match = gpuRegex.match(output);
-        if (match.hasMatch()) {
-            return match.captured(1).toInt();
-        }
-    }
-    
-    // Method 3: Try intel_gpu_top (Intel GPUs)
-    QProcess intelProcess;
-    intelProcess.start("intel_gpu_top", QStringList() << "-s" << "1");
-    intelProcess.waitForFinished(2000);
-    
-    if (intelProcess.exitCode() == 0) {
-        QString output = intelProcess.readAllStandardOutput();
-        QRegularExpression gpuRegex("GPU\\s+(\\d+)%");
-        QRegularExpressionMatch match = gpuRegex.match(output);
-        if (match.hasMatch()) {
-            return match.captured(1).toInt();
-        }
-    }
-    
-    return -1; // Failed to get GPU load
-}
-
-int FanProfilePage::calculateRPMForLoad(int temperature, int cpuLoad, int gpuLoad)
-{
-    // Get base RPM from temperature
-    int baseRPM = calculateRPMForTemperature(temperature);
-    
-    // Calculate load-based boost
-    int maxLoad = qMax(cpuLoad, gpuLoad);
-    int loadBoost = 0;
-    
-    if (maxLoad > 80) {
-        // High load: significant boost
-        loadBoost = 300 + ((maxLoad - 80) * 10); // 300-500 RPM boost
-    } else if (maxLoad > 60) {
-        // Medium load: moderate boost
-        loadBoost = 150 + ((maxLoad - 60) * 7); // 150-290 RPM boost
-    } else if (maxLoad > 40) {
-        // Low load: small boost
-        loadBoost = (maxLoad - 40) * 5; // 0-100 RPM boost
-    }
-    
-    // Apply load boost to base RPM
-    int finalRPM = baseRPM + loadBoost;
-    
-    // Clamp to valid range
-    finalRPM = qMax(0, qMin(2100, finalRPM));
-    
-    DEBUG_LOG_CATEGORY("FanSpeeds", "Load-based RPM: temp=", temperature, "°C, CPU=", cpuLoad, "%, GPU=", gpuLoad 
-             , "%, baseRPM=", baseRPM, ", loadBoost=", loadBoost, ", finalRPM=", finalRPM);
-    
-    return finalRPM;
-}
-
 // Profile test function removed - no longer needed
 
 // Fan detection functions removed - configuration is now handled via Settings page
@@ -1365,7 +950,7 @@ void FanProfilePage::onCurvePointsChanged(const QVector<QPointF> &points)
     }
     
     // Immediately apply the new curve to fan control
-    controlFanSpeeds();
+    pushCurvesToEngine();
 }
 
 void FanProfilePage::onPortSelectionChanged()
@@ -1383,6 +968,25 @@ void FanProfilePage::onPortSelectionChanged()
     
     // Update fan size for the graph
     m_fanCurveWidget->setFanSize(m_fanSizeMaxRPM[m_selectedPort]);
+    m_fanCurveWidget->setSensorRing(sensorRing(), m_selectedPort);
+    
+    // Show this port's interpolation without writing it back
+    const FanCurve::Interpolation interpolation = m_portInterpolation.value(m_selectedPort, FanCurve::Interpolation::Linear);
+    {
+        QSignalBlocker blocker(m_interpolationCombo);
+        m_interpolationCombo->setCurrentIndex(m_interpolationCombo->findData(static_cast<int>(interpolation)));
+    }
+    m_fanCurveWidget->setInterpolation(interpolation);
+    {
+        QSignalBlocker blocker(m_strategyCombo);
+        const FanControlStrategy::Kind kind = m_portStrategy.value(m_selectedPort, FanControlStrategy::Kind::Heuristic);
+        m_strategyCombo->setCurrentIndex(m_strategyCombo->findData(FanControlStrategy::kindName(kind)));
+    }
+    {
+        QSignalBlocker blocker(m_sensorCombo);
+        m_sensorCombo->setEditText(m_portSensor.value(m_selectedPort, "cpu"));
+        m_sensorCombo->setStyleSheet(QString());
+    }
     
     // Load the curve for this port (either custom or default)
     if (m_customCurves.contains(m_selectedPort)) {
@@ -1414,6 +1018,67 @@ void FanProfilePage::onPortSelectionChanged()
     }
 }
 
+void FanProfilePage::onInterpolationChanged(int index)
+{
+    const auto interpolation = static_cast<FanCurve::Interpolation>(m_interpolationCombo->itemData(index).toInt());
+    if (m_portInterpolation.value(m_selectedPort, FanCurve::Interpolation::Linear) == interpolation) {
+        return;
+    }
+    
+    m_portInterpolation[m_selectedPort] = interpolation;
+    m_fanCurveWidget->setInterpolation(interpolation);
+    saveCustomCurves();
+    pushCurvesToEngine();
+}
+
+void FanProfilePage::onStrategyChanged(int index)
+{
+    const FanControlStrategy::Kind kind = FanControlStrategy::kindFromName(m_strategyCombo->itemData(index).toString());
+    if (m_portStrategy.value(m_selectedPort, FanControlStrategy::Kind::Heuristic) == kind) {
+        return;
+    }
+    
+    m_portStrategy[m_selectedPort] = kind;
+    savePortProfiles();
+    pushPortSettingsToEngine();
+}
+
+void FanProfilePage::onSensorEdited()
+{
+    const QString text = m_sensorCombo->currentText().trimmed();
+    if (text.isEmpty() || text == m_portSensor.value(m_selectedPort, "cpu")) {
+        m_sensorCombo->setStyleSheet(QString());
+        return;
+    }
+    
+    // Compile all four like the engine does, so a fifth hwmon channel
+    // is caught here rather than rejected there
+    QStringList channels;
+    QString error;
+    bool valid = true;
+    for (int port = 1; port <= 4 && valid; ++port) {
+        const QString expression = port == m_selectedPort ? text : m_portSensor.value(port, "cpu");
+        valid = SensorExpression::compile(expression, &channels, &error).isValid();
+    }
+    if (!valid) {
+        m_sensorCombo->setStyleSheet("QComboBox { border: 1px solid #d9534f; }");
+        m_sensorCombo->lineEdit()->setToolTip(error);
+        return;
+    }
+    
+    m_sensorCombo->setStyleSheet(QString());
+    m_sensorCombo->lineEdit()->setToolTip(QString());
+    m_portSensor[m_selectedPort] = text;
+    savePortProfiles();
+    pushPortSettingsToEngine();
+}
+
+void FanProfilePage::onOutputChanged()
+{
+    savePortProfiles();
+    pushPortSettingsToEngine();
+}
+
 void FanProfilePage::onFanSizeChanged(int port)
 {
     if (port < 1 || port > 4) {
@@ -1494,6 +1159,9 @@ void FanProfilePage::saveCustomCurves()
             }
             settings.endArray();
         }
+        
+        const FanCurve::Interpolation interpolation = m_portInterpolation.value(port, FanCurve::Interpolation::Linear);
+        settings.setValue(QString("Port%1Interpolation").arg(port), FanCurve::interpolationName(interpolation));
     }
     
     qDebug() << "Saved custom curves for" << m_customCurves.size() << "ports";
@@ -1518,9 +1186,17 @@ void FanProfilePage::loadCustomCurves()
             qDebug() << "Loaded custom curve for Port" << port << "with" << size << "points";
         }
         settings.endArray();
+        
+        const QString interpolation = settings.value(QString("Port%1Interpolation").arg(port), "linear").toString();
+        m_portInterpolation[port] = FanCurve::interpolationFromName(interpolation);
     }
     
     // Load the curve for Port 1 (default selection)
+    m_fanCurveWidget->setInterpolation(m_portInterpolation.value(1, FanCurve::Interpolation::Linear));
+    {
+        QSignalBlocker blocker(m_interpolationCombo);
+        m_interpolationCombo->setCurrentIndex(m_interpolationCombo->findData(static_cast<int>(m_portInterpolation.value(1))));
+    }
     if (m_customCurves.contains(1)) {
         m_fanCurveWidget->setCustomCurve(m_customCurves[1]);
     }
@@ -1590,7 +1266,12 @@ void FanProfilePage::savePortProfiles()
     for (int port = 1; port <= 4; ++port) {
         QString profileName = m_portProfiles.value(port, "Quiet");
         settings.setValue(QString("Port%1").arg(port), profileName);
+        const FanControlStrategy::Kind kind = m_portStrategy.value(port, FanControlStrategy::Kind::Heuristic);
+        settings.setValue(QString("Port%1Strategy").arg(port), FanControlStrategy::kindName(kind));
+        settings.setValue(QString("Port%1Sensor").arg(port), m_portSensor.value(port, "cpu"));
     }
+    settings.setValue("DutyHysteresis", m_hysteresisSpin->value());
+    settings.setValue("DutyMinDwell", m_dwellSpin->value());
     
     qDebug() << "Saved port profiles";
 }
@@ -1603,66 +1284,32 @@ void FanProfilePage::loadPortProfiles()
     for (int port = 1; port <= 4; ++port) {
         QString profileName = settings.value(QString("Port%1").arg(port), "Quiet").toString();
         m_portProfiles[port] = profileName;
-        qDebug() << "Loaded Port" << port << "profile:" << profileName;
+        const QString strategy = settings.value(QString("Port%1Strategy").arg(port), "heuristic").toString();
+        m_portStrategy[port] = FanControlStrategy::kindFromName(strategy);
+        m_portSensor[port] = settings.value(QString("Port%1Sensor").arg(port), "cpu").toString();
+        qDebug() << "Loaded Port" << port << "profile:" << profileName << "controller:" << strategy << "sensor:" << m_portSensor[port];
     }
-}
-
-QVector<QPointF> FanProfilePage::getDefaultCurveForProfile(const QString &profile)
-{
-    QVector<QPointF> curvePoints;
-    
-    if (profile == "Quiet") {
-        curvePoints << QPointF(0, 120) << QPointF(25, 420) << QPointF(45, 840) 
-                   << QPointF(65, 1050) << QPointF(80, 1680) << QPointF(90, 2100) << QPointF(100, 2100);
-    } else if (profile == "Standard") {
-        curvePoints << QPointF(0, 120) << QPointF(25, 420) << QPointF(40, 1050) << QPointF(55, 1260) 
-                   << QPointF(70, 1680) << QPointF(90, 2100) << QPointF(100, 2100);
-    } else if (profile == "High Speed") {
-        curvePoints << QPointF(0, 120) << QPointF(25, 910) << QPointF(35, 1140) << QPointF(50, 1470)
-                   << QPointF(70, 1800) << QPointF(85, 2100) << QPointF(100, 2100);
-    } else if (profile == "Full Speed") {
-        curvePoints << QPointF(0, 120) << QPointF(25, 2100) << QPointF(40, 2100) << QPointF(55, 2100)
-                   << QPointF(70, 2100) << QPointF(90, 2100) << QPointF(100, 2100);
-    } else {
-        // Default to Quiet
-        curvePoints << QPointF(0, 120) << QPointF(25, 420) << QPointF(45, 840) 
-                   << QPointF(65, 1050) << QPointF(80, 1680) << QPointF(90, 2100) << QPointF(100, 2100);
+    
+    {
+        QSignalBlocker blocker(m_strategyCombo);
+        const FanControlStrategy::Kind kind = m_portStrategy.value(m_selectedPort, FanControlStrategy::Kind::Heuristic);
+        m_strategyCombo->setCurrentIndex(m_strategyCombo->findData(FanControlStrategy::kindName(kind)));
+    }
+    {
+        QSignalBlocker blocker(m_sensorCombo);
+        m_sensorCombo->setEditText(m_portSensor.value(m_selectedPort, "cpu"));
     }
     
-    return curvePoints;
+    const DutyOutputStage::Parameters output;
+    QSignalBlocker hysteresisBlocker(m_hysteresisSpin);
+    QSignalBlocker dwellBlocker(m_dwellSpin);
+    m_hysteresisSpin->setValue(settings.value("DutyHysteresis", output.hysteresis).toInt());
+    m_dwellSpin->setValue(settings.value("DutyMinDwell", output.minDwell).toDouble());
 }
 
-int FanProfilePage::calculateRPMForCustomCurve(int port, int temperature)
+QVector<QPointF> FanProfilePage::getDefaultCurveForProfile(const QString &profile)
 {
-    // Check if this port has a custom curve
-    if (!m_customCurves.contains(port)) {
-        // No custom curve, use the profile default
-        return calculateRPMForTemperature(temperature);
-    }
-    
-    QVector<QPointF> curvePoints = m_customCurves[port];
-    
-    if (curvePoints.size() < 2) {
-        return 0;
-    }
-    
-    // Clamp temperature to valid range
-    temperature = qMax(0, qMin(100, temperature));
-    
-    // Find the two points to interpolate between
-    for (int i = 0; i < curvePoints.size() - 1; ++i) {
-        if (temperature >= curvePoints[i].x() && temperature <= curvePoints[i + 1].x()) {
-            // Linear interpolation between the two points
-            double t = (temperature - curvePoints[i].x()) / (curvePoints[i + 1].x() - curvePoints[i].x());
-            double rpm = curvePoints[i].y() + t * (curvePoints[i + 1].y() - curvePoints[i].y());
-            return static_cast<int>(rpm);
-        }
-    }
-    
-    // If temperature is outside the curve range, clamp to nearest point
-    if (temperature < curvePoints.first().x()) {
-        return static_cast<int>(curvePoints.first().y());
-    } else {
-        return static_cast<int>(curvePoints.last().y());
-    }
+    // Shared with the fan control engine so both sides agree on the defaults
+    return FanCurve::defaultPointsForProfile(profile);
 }
+
@@ -10,13 +10,16 @@
 #include <QComboBox>
 #include <QSlider>
 #include <QSpinBox>
+#include <QDoubleSpinBox>
 #include <QTableWidget>
 #include <QGroupBox>
 #include <QRadioButton>
 #include <QCheckBox>
 #include <QWidget>
+#include <QPointer>
 #include "widgets/fancurvewidget.h"
-#include "usb/lian_li_sl_infinity_controller.h"
+#include "control/fancontrolengine.h"
+#include "daemon/daemonclient.h"
 
 class FanProfilePage : public QWidget
 {
@@ -24,16 +27,23 @@ class FanProfilePage : public QWidget
 
 public:
     explicit FanProfilePage(QWidget *parent = nullptr);
+    void setFanControlEngine(FanControlEngine *engine);
+    // Fan control runs in llconnectd instead; used in place of the engine
+    void setDaemonClient(DaemonClient *client);
 
 private slots:
     void onProfileChanged();
     void onDefaultClicked();
     void onApplyToAllClicked();
-    void updateFanData();
+    void onFanControlSamples();
     void onCurvePointsChanged(const QVector<QPointF> &points);
     void onPortSelectionChanged();
     void onFanSizeChanged(int port);
     void onRenameCustomProfile(int profileNum);
+    void onInterpolationChanged(int index);
+    void onStrategyChanged(int index);
+    void onSensorEdited();
+    void onOutputChanged();
 
 private:
     void setupUI();
@@ -41,20 +51,11 @@ private:
     void setupFanCurve();
     void setupControls();
     void updateFanCurve();
-    void updateTemperature();
-    void updateFanRPMs();
-    void updateCPULoad();
-    void updateGPULoad();
-    int calculateRPMForTemperature(int temperature);
-    int calculateRPMForLoad(int temperature, int cpuLoad, int gpuLoad);
-    int getRealCPUTemperature();
-    int getRealCPULoad();
-    int getRealGPULoad();
-    QVector<int> getRealFanRPMs();
-    int getRealFanRPM(int port);
     int convertPercentageToRPM(int percentage);
-    void controlFanSpeeds();
-    void setFanSpeed(int port, int speedPercent);
+    void pushCurvesToEngine();
+    void pushPortSettingsToEngine();
+    void updateSnapshotPublishing();
+    const SensorRing *sensorRing() const;
     void updateFanTable();
     bool isPortConnected(int port);
     QColor getTemperatureColor(int temperature);
@@ -65,7 +66,7 @@ private:
     void savePortProfiles();
     void loadPortProfiles();
     QVector<QPointF> getDefaultCurveForProfile(const QString &profile);
-    int calculateRPMForCustomCurve(int port, int temperature);
+    QVector<QPointF> effectiveCurveForPort(int port);
     QString getCurrentProfile();
     QString getInternalProfileName(const QString &displayName);
     // Fan detection functions removed - configuration is now in Settings
@@ -95,12 +96,30 @@ private:
     QPushButton *m_applyToAllButton;
     QPushButton *m_defaultButton;
     
+    // Per-port settings of the selected port
+    QComboBox *m_interpolationCombo;
+    QComboBox *m_strategyCombo;
+    QComboBox *m_sensorCombo;
+    
+    // Output stage, shared by all ports
+    QSpinBox *m_hysteresisSpin;
+    QDoubleSpinBox *m_dwellSpin;
+    
     // Current selected port (1-4)
     int m_selectedPort;
     
     // Per-port custom curves (port 1-4 -> curve points)
     QMap<int, QVector<QPointF>> m_customCurves;
     
+    // Per-port curve interpolation (port 1-4), saved with the curves
+    QMap<int, FanCurve::Interpolation> m_portInterpolation;
+    
+    // Per-port controller (port 1-4), saved with the port profiles
+    QMap<int, FanControlStrategy::Kind> m_portStrategy;
+    
+    // Per-port sensor expression (port 1-4), saved with the port profiles
+    QMap<int, QString> m_portSensor;
+    
     // Per-port profile names (port 1-4 -> profile name like "Quiet", "StdSP", etc.)
     QMap<int, QString> m_portProfiles;
     
@@ -108,24 +127,6 @@ private:
     QMap<int, QString> m_customProfileNames; // Profile 1-3 -> custom name
     QMap<int, QVector<QPointF>> m_customProfileCurves; // Profile 1-3 -> base curve
     
-    // Update timers
-    QTimer *m_updateTimer;
-    QTimer *m_tempUpdateTimer;
-    QTimer *m_fanRPMTimer;
-    QTimer *m_cpuLoadTimer;
-    QTimer *m_gpuLoadTimer;
-    
-    // Cached temperature for real-time updates
-    int m_cachedTemperature;
-    int m_temperatureCounter;
-    
-    // Cached CPU and GPU load
-    int m_cachedCPULoad;
-    int m_cachedGPULoad;
-    
-    // Cached fan RPMs
-    QVector<int> m_cachedFanRPMs;
-    
     // Port detection
     QVector<bool> m_portConnected;
     QVector<int> m_activePorts;
@@ -133,8 +134,10 @@ private:
     // Fan size per port (120mm = 2100 RPM, 140mm = 1600 RPM)
     QMap<int, int> m_fanSizeMaxRPM;
     
-    // HID controller for fan control
-    LianLiSLInfinityController *m_hidController;
+    // Fan control runs on its own thread; this page only edits curves and
+    // renders the snapshots the engine publishes while the page is visible
+    QPointer<FanControlEngine> m_fanControlEngine;
+    QPointer<DaemonClient> m_daemonClient;
 };
 
 #endif // FANPROFILEPAGE_H
@@ -1,6 +1,7 @@
 #include "lightingpage.h"
 #include "widgets/customslider.h"
 #include "lian_li_qt_integration.h"
+#include "daemon/daemonclient.h"
 #include "utils/qtdebugutil.h"
 #include <QFont>
 #include <QDebug>
@@ -9,7 +10,6 @@
 #include <QShowEvent>
 #include <QGridLayout>
 #include <QGroupBox>
-#include <QThread>
 
 LightingPage::LightingPage(QWidget *parent)
     : QWidget(parent)
@@ -17,6 +17,7 @@ LightingPage::LightingPage(QWidget *parent)
     , m_currentSpeed(75)
     , m_currentBrightness(100)
     , m_directionLeft(false)
+    , m_softwareEffect(false)
     , m_selectedPort(-1)
     , m_lianLi(nullptr)
 {
@@ -36,10 +37,11 @@ LightingPage::LightingPage(QWidget *parent)
     m_portEnabled[2] = true;
     m_portEnabled[3] = true;
     
-    // Initialize Lian Li integration
-    m_lianLi = new LianLiQtIntegration(this);
+    // The hub session is shared with the rest of the application
+    m_lianLi = LianLiQtIntegration::shared();
     connect(m_lianLi, &LianLiQtIntegration::deviceConnected, this, &LightingPage::onDeviceConnected);
     connect(m_lianLi, &LianLiQtIntegration::deviceDisconnected, this, &LightingPage::onDeviceDisconnected);
+    connect(m_lianLi, &LianLiQtIntegration::errorOccurred, this, &LightingPage::onDeviceError);
     
     setupUI();
     setupControls();
@@ -59,6 +61,11 @@ LightingPage::LightingPage(QWidget *parent)
     }
 }
 
+void LightingPage::setDaemonClient(DaemonClient *client)
+{
+    m_daemonClient = client;
+}
+
 void LightingPage::setupUI()
 {
     m_mainLayout = new QVBoxLayout(this);
@@ -213,6 +220,14 @@ void LightingPage::setupControls()
     directionWidgetLayout->addLayout(m_directionLayout);
     lightingLayout->addWidget(m_directionWidget);
     
+    // Software rendering: the fans show exactly what LightingEffect draws
+    m_softwareCheck = new QCheckBox("Render on this PC");
+    m_softwareCheck->setObjectName("controlCheck");
+    m_softwareCheck->setToolTip("Draw the effect on this computer and stream it to the fans instead of using the "
+                                "hub's built-in preset. Stops when the app (or llconnectd) exits.");
+    connect(m_softwareCheck, &QCheckBox::toggled, this, &LightingPage::onSoftwareToggled);
+    lightingLayout->addWidget(m_softwareCheck);
+    
     // Apply button
     m_applyBtn = new QPushButton("Apply");
     m_applyBtn->setObjectName("applyButton");
@@ -261,6 +276,11 @@ void LightingPage::setupControls()
             margin-right: 8px;
         }
         
+        #controlCheck {
+            color: #cccccc;
+            font-size: 12px;
+        }
+        
         #directionButton {
             background-color: #404040;
             color: #cccccc;
@@ -486,6 +506,17 @@ void LightingPage::onDirectionChanged()
     saveLightingSettings();
 }
 
+void LightingPage::onSoftwareToggled(bool checked)
+{
+    if (m_softwareEffect == checked) {
+        return;
+    }
+    
+    m_softwareEffect = checked;
+    applyCurrentEffect();
+    saveLightingSettings();
+}
+
 void LightingPage::onApply()
 {
     // Apply effect to device
@@ -495,351 +526,40 @@ void LightingPage::onApply()
     saveLightingSettings();
 }
 
+LightingState LightingPage::currentLightingState() const
+{
+    LightingState state;
+    state.effect = m_currentEffect;
+    state.speed = m_currentSpeed;
+    state.brightness = m_currentBrightness;
+    state.directionLeft = m_directionLeft;
+    state.software = m_softwareEffect;
+    state.selectedPort = m_selectedPort;
+    for (int port = 0; port < 4; port++) {
+        state.portEnabled[port] = m_portEnabled[port];
+        for (int i = 0; i < 4; i++) {
+            state.colors[port][i] = m_portColors[port][i];
+        }
+    }
+    return state;
+}
+
 void LightingPage::applyCurrentEffect()
 {
+    // When llconnectd is running it owns the hub, so it applies the effect
+    if (m_daemonClient && m_daemonClient->isConnected()) {
+        DEBUG_LOG("Sending effect to llconnectd:", m_currentEffect);
+        m_daemonClient->setLighting(currentLightingState());
+        return;
+    }
+
     // Apply lighting settings to device if connected
     if (!m_lianLi || !m_lianLi->isConnected()) {
         DEBUG_LOG("Device not connected - cannot apply lighting");
         return;
     }
-    
-    bool success = false;
-    
-    DEBUG_LOG("Applying effect:", m_currentEffect, 
-             "Speed:", m_currentSpeed, 
-             "Brightness:", m_currentBrightness, 
-             "Direction:", (m_directionLeft ? "Left" : "Right"));
-    
-    if (m_currentEffect == "Rainbow Wave") {
-        success = m_lianLi->setRainbowEffect(m_currentSpeed, m_currentBrightness, m_directionLeft);
-    } else if (m_currentEffect == "Spectrum Cycle") {
-        success = m_lianLi->setRainbowMorphEffect(m_currentSpeed, m_currentBrightness);
-    } else if (m_currentEffect == "Static") {
-        // Static: One solid color per port - apply to selected port(s)
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        
-        QColor currentColor = QColor(255, 0, 0);
-        success = true;  // Start optimistic - will be set to false if any channel fails
-        
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            // Skip disabled ports
-            if (!m_portEnabled[port]) {
-                continue;
-            }
-            
-            // Use the first color for this port (single solid color per port)
-            QColor portColor = m_portColors[port][0];
-            if (!portColor.isValid()) {
-                portColor = currentColor;
-            }
-            
-            int channel1 = port * 2;      // First channel for this port
-            int channel2 = port * 2 + 1;  // Second channel for this port
-            
-            DEBUG_LOG("Setting Static for Port", (port + 1), "via channels", channel1, "&", channel2, 
-                     "to color", portColor, "brightness", m_currentBrightness);
-            
-            // Send to both channels for this port (inner and outer rings)
-            bool channel1Success = m_lianLi->setChannelColor(channel1, portColor, m_currentBrightness);
-            bool channel2Success = m_lianLi->setChannelColor(channel2, portColor, m_currentBrightness);
-            
-            if (!channel1Success) {
-                DEBUG_LOG("Failed to set Static for Port", (port + 1), "channel", channel1);
-                success = false;
-            }
-            if (!channel2Success) {
-                DEBUG_LOG("Failed to set Static for Port", (port + 1), "channel", channel2);
-                success = false;
-            }
-            
-            if (channel1Success && channel2Success) {
-                DEBUG_LOG("✓ Successfully set Port", (port + 1));
-            }
-        }
-    } else if (m_currentEffect == "Breathing") {
-        // Breathing supports up to 6 colors per OpenRGB - apply to selected port(s)
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        
-        QColor currentColor = QColor(255, 0, 0);
-        
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            if (!m_portEnabled[port]) continue;
-            
-            QColor portColor = m_portColors[port][0];
-            if (!portColor.isValid()) portColor = currentColor;
-            int channel = port * 2;
-            m_lianLi->setChannelBreathing(channel, portColor, m_currentSpeed, m_currentBrightness);
-            if (channel + 1 < 8) {
-                m_lianLi->setChannelBreathing(channel + 1, portColor, m_currentSpeed, m_currentBrightness);
-            }
-            success = true;
-        }
-    } else if (m_currentEffect == "Meteor") {
-        // Meteor: One color per port (like Static/Breathing)
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        
-        QColor currentColor = QColor(255, 0, 0);
-        
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            if (!m_portEnabled[port]) continue;
-            
-            // Use the first color for this port (single color per port)
-            QColor portColor = m_portColors[port][0];
-            if (!portColor.isValid()) portColor = currentColor;
-            
-            // Meteor uses 2 colors internally, but we use the same color for both
-            QColor portColors[2] = {portColor, portColor};
-            
-            int channel = port * 2;
-            DEBUG_LOG("Applying Meteor to Port", (port + 1), "channel", channel,
-                     "Color(RGB):", portColor.red(), portColor.green(), portColor.blue(),
-                     "Speed:", m_currentSpeed, "Brightness:", m_currentBrightness);
-            
-            m_lianLi->setChannelMeteorWithColors(channel, portColors, m_currentSpeed, m_currentBrightness, false);
-            QThread::msleep(10);
-            if (channel + 1 < 8) {
-                m_lianLi->setChannelMeteorWithColors(channel + 1, portColors, m_currentSpeed, m_currentBrightness, false);
-            }
-            QThread::msleep(50);
-            success = true;
-        }
-    } else if (m_currentEffect == "Voice") {
-        success = m_lianLi->setVoiceEffect(m_currentSpeed, m_currentBrightness);
-    } else if (m_currentEffect == "Groove") {
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        QColor currentColor = QColor(255, 0, 0);
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            if (!m_portEnabled[port]) continue;
-            QColor portColor = m_portColors[port][0];
-            if (!portColor.isValid()) portColor = currentColor;
-            int channel = port * 2;
-            m_lianLi->setChannelGroove(channel, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
-            if (channel + 1 < 8) {
-                m_lianLi->setChannelGroove(channel + 1, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
-            }
-            success = true;
-        }
-    } else if (m_currentEffect == "Tunnel") {
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        QColor currentColor = QColor(255, 0, 0);
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            if (!m_portEnabled[port]) continue;
-            int channel = port * 2;
-            QColor portColors[4] = {m_portColors[port][0], m_portColors[port][1], 
-                                   m_portColors[port][2], m_portColors[port][3]};
-            if (!portColors[0].isValid()) portColors[0] = currentColor;
-            if (!portColors[1].isValid()) portColors[1] = currentColor;
-            if (!portColors[2].isValid()) portColors[2] = currentColor;
-            if (!portColors[3].isValid()) portColors[3] = currentColor;
-            m_lianLi->setChannelTunnel(channel, portColors, m_currentSpeed, m_currentBrightness, m_directionLeft);
-            if (channel + 1 < 8) {
-                m_lianLi->setChannelTunnel(channel + 1, portColors, m_currentSpeed, m_currentBrightness, m_directionLeft);
-            }
-            success = true;
-        }
-    } else if (m_currentEffect == "Staggered") {
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        QColor currentColor = QColor(255, 0, 0);
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            if (!m_portEnabled[port]) continue;
-            int channel = port * 2;
-            QColor portColors[2] = {m_portColors[port][0], m_portColors[port][1]};
-            if (!portColors[0].isValid()) portColors[0] = currentColor;
-            if (!portColors[1].isValid()) portColors[1] = currentColor;
-            m_lianLi->setChannelStaggered(channel, portColors, m_currentSpeed, m_currentBrightness);
-            if (channel + 1 < 8) {
-                m_lianLi->setChannelStaggered(channel + 1, portColors, m_currentSpeed, m_currentBrightness);
-            }
-            success = true;
-        }
-    } else if (m_currentEffect == "Tide") {
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            if (!m_portEnabled[port]) continue;
-            
-            QColor portColors[2] = {m_portColors[port][0], m_portColors[port][1]};
-            int channel = port * 2;
-            m_lianLi->setChannelTide(channel, portColors, m_currentSpeed, m_currentBrightness);
-            if (channel + 1 < 8) {
-                m_lianLi->setChannelTide(channel + 1, portColors, m_currentSpeed, m_currentBrightness);
-            }
-            success = true;
-        }
-    } else if (m_currentEffect == "Runway") {
-        // Runway: One color per port (like Static/Breathing/Meteor/Mixing/Neon)
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        
-        QColor currentColor = QColor(255, 200, 100); // Default orange
-        
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            if (!m_portEnabled[port]) continue;
-            
-            // Use the first color for this port (single color per port)
-            QColor portColor = m_portColors[port][0];
-            if (!portColor.isValid()) portColor = currentColor;
-            
-            // Runway uses 2 colors internally, but we use the same color for both
-            QColor portColors[2] = {portColor, portColor};
-            
-            int channel = port * 2;
-            m_lianLi->setChannelRunwayWithColors(channel, portColors, m_currentSpeed, m_currentBrightness, false);
-            if (channel + 1 < 8) {
-                m_lianLi->setChannelRunwayWithColors(channel + 1, portColors, m_currentSpeed, m_currentBrightness, false);
-            }
-            success = true;
-        }
-    } else if (m_currentEffect == "Mixing") {
-        // Mixing: One color per port (like Static/Breathing/Meteor)
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        
-        QColor currentColor = QColor(255, 0, 0);
-        
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            if (!m_portEnabled[port]) continue;
-            
-            // Use the first color for this port (single color per port)
-            QColor portColor = m_portColors[port][0];
-            if (!portColor.isValid()) portColor = currentColor;
-            
-            // Mixing uses 2 colors internally, but we use the same color for both
-            QColor portColors[2] = {portColor, portColor};
-            
-            int channel = port * 2;
-            DEBUG_LOG("Applying Mixing to Port", (port + 1), "channel", channel,
-                     "Color(RGB):", portColor.red(), portColor.green(), portColor.blue(),
-                     "Speed:", m_currentSpeed, "Brightness:", m_currentBrightness);
-            
-            m_lianLi->setChannelMixing(channel, portColors, m_currentSpeed, m_currentBrightness);
-            QThread::msleep(10);
-            if (channel + 1 < 8) {
-                m_lianLi->setChannelMixing(channel + 1, portColors, m_currentSpeed, m_currentBrightness);
-            }
-            QThread::msleep(50);
-            success = true;
-        }
-    } else if (m_currentEffect == "Stack") {
-        // Stack: One color per port (like Static/Breathing/Meteor/Mixing/Neon/Runway)
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        
-        QColor currentColor = QColor(255, 0, 0); // Default red
-        
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            if (!m_portEnabled[port]) continue;
-            
-            // Use the first color for this port (single color per port)
-            QColor portColor = m_portColors[port][0];
-            if (!portColor.isValid()) portColor = currentColor;
-            
-            int channel = port * 2;
-            m_lianLi->setChannelStack(channel, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
-            if (channel + 1 < 8) {
-                m_lianLi->setChannelStack(channel + 1, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
-            }
-            success = true;
-        }
-    } else if (m_currentEffect == "Neon") {
-        // Neon: One color per port (like Static/Breathing/Meteor)
-        int portsToApply[4] = {0, 1, 2, 3};
-        int portCount = 4;
-        if (m_selectedPort >= 0 && m_selectedPort < 4) {
-            portsToApply[0] = m_selectedPort;
-            portCount = 1;
-        }
-        
-        QColor currentColor = QColor(255, 0, 0);
-        
-        for (int i = 0; i < portCount; i++) {
-            int port = portsToApply[i];
-            if (!m_portEnabled[port]) continue;
-            
-            // Use the first color for this port (single color per port)
-            QColor portColor = m_portColors[port][0];
-            if (!portColor.isValid()) portColor = currentColor;
-            
-            int channel = port * 2;
-            DEBUG_LOG("Applying Neon to Port", (port + 1), "channel", channel,
-                     "Color(RGB):", portColor.red(), portColor.green(), portColor.blue(),
-                     "Speed:", m_currentSpeed, "Brightness:", m_currentBrightness);
-            
-            // Use setChannelEffect with Neon mode (0x22) and the port color
-            m_lianLi->setChannelEffect(channel, 0x22, portColor, m_currentSpeed, m_currentBrightness, false);
-            QThread::msleep(10);
-            if (channel + 1 < 8) {
-                m_lianLi->setChannelEffect(channel + 1, 0x22, portColor, m_currentSpeed, m_currentBrightness, false);
-            }
-            QThread::msleep(50);
-            success = true;
-        }
-    }
-    
-    if (success) {
-        DEBUG_LOG("✓ Successfully applied effect:", m_currentEffect);
-    } else {
-        DEBUG_LOG("✗ Failed to apply effect:", m_currentEffect);
-    }
+
+    currentLightingState().apply(*m_lianLi);
 }
 
 void LightingPage::onDeviceConnected()
@@ -852,6 +572,11 @@ void LightingPage::onDeviceDisconnected()
     DEBUG_LOG("Lian Li device disconnected");
 }
 
+void LightingPage::onDeviceError(const QString &error)
+{
+    qWarning() << "Lighting:" << error;
+}
+
 void LightingPage::onColorButtonClicked()
 {
     QPushButton *button = qobject_cast<QPushButton*>(sender());
@@ -954,6 +679,7 @@ void LightingPage::saveLightingSettings()
     settings.setValue("Speed", m_currentSpeed);
     settings.setValue("Brightness", m_currentBrightness);
     settings.setValue("DirectionLeft", m_directionLeft);
+    settings.setValue("SoftwareEffect", m_softwareEffect);
     
     // Save colors for the current effect (effect-specific colors)
     saveEffectColors(m_currentEffect);
@@ -987,6 +713,7 @@ void LightingPage::loadLightingSettings()
     m_currentSpeed = settings.value("Speed", 75).toInt();
     m_currentBrightness = settings.value("Brightness", 100).toInt();
     m_directionLeft = settings.value("DirectionLeft", false).toBool();
+    m_softwareEffect = settings.value("SoftwareEffect", false).toBool();
     
     // Load colors for the current effect (effect-specific colors)
     // This will load saved colors for this effect, or use defaults if not saved
@@ -1026,6 +753,10 @@ void LightingPage::loadLightingSettings()
     m_effectCombo->setCurrentText(m_currentEffect);
     m_speedSlider->setValue(m_currentSpeed);
     m_brightnessSlider->setValue(m_currentBrightness);
+    {
+        QSignalBlocker blocker(m_softwareCheck);
+        m_softwareCheck->setChecked(m_softwareEffect);
+    }
     
     // Set direction buttons
     if (m_directionLeft) {
@@ -1063,12 +794,17 @@ void LightingPage::resetToDefaults()
     m_currentSpeed = 75;
     m_currentBrightness = 100;
     m_directionLeft = false;
+    m_softwareEffect = false;
     m_selectedPort = -1;
     
     // Update UI
     m_effectCombo->setCurrentText(m_currentEffect);
     m_speedSlider->setValue(m_currentSpeed);
     m_brightnessSlider->setValue(m_currentBrightness);
+    {
+        QSignalBlocker blocker(m_softwareCheck);
+        m_softwareCheck->setChecked(false);
+    }
     
     if (m_directionLeft) {
         m_leftDirectionBtn->setChecked(true);
@@ -10,9 +10,12 @@
 #include <QSlider>
 #include <QGroupBox>
 #include <QCheckBox>
+#include <QPointer>
+#include "lighting/lightingstate.h"
 
 class CustomSlider;
 class LianLiQtIntegration;
+class DaemonClient;
 
 class LightingPage : public QWidget
 {
@@ -21,6 +24,8 @@ class LightingPage : public QWidget
 public:
     explicit LightingPage(QWidget *parent = nullptr);
     void resetToDefaults();
+    // While connected, effects are sent to llconnectd instead of the hub
+    void setDaemonClient(DaemonClient *client);
 
 protected:
     void showEvent(QShowEvent *event) override;
@@ -30,9 +35,11 @@ private slots:
     void onSpeedChanged(int value);
     void onBrightnessChanged(int value);
     void onDirectionChanged();
+    void onSoftwareToggled(bool checked);
     void onApply();
     void onDeviceConnected();
     void onDeviceDisconnected();
+    void onDeviceError(const QString &error);
     void onColorButtonClicked();
 
 private:
@@ -46,6 +53,7 @@ private:
     void loadFanConfiguration();
     void updatePortButtonStates();
     void applyCurrentEffect();
+    LightingState currentLightingState() const;
     void clearOldEffectSettings(const QString &oldEffect, const QString &newEffect);
     
     QVBoxLayout *m_mainLayout;
@@ -71,6 +79,7 @@ private:
     QPushButton *m_colorButtons[4]; // One for each port/fan
     QLabel *m_colorLabels[4]; // Labels that change for Meteor mode
     
+    QCheckBox *m_softwareCheck;
     QPushButton *m_applyBtn;
     
     
@@ -79,12 +88,14 @@ private:
     int m_currentSpeed;
     int m_currentBrightness;
     bool m_directionLeft;
+    bool m_softwareEffect; // drawn by LightingEffect and streamed, not a hub preset
     QColor m_portColors[4][4]; // [port][color_index] - supports up to 4 colors per port
     bool m_portEnabled[4];  // Which ports have fans connected
     int m_selectedPort; // -1 = none, 0-3 = port index
     
     // Lian Li integration
     LianLiQtIntegration *m_lianLi;
+    QPointer<DaemonClient> m_daemonClient;
 };
 
 #endif // LIGHTINGPAGE_H
@@ -1,8 +1,9 @@
 #include "settingspage.h"
 #include "lightingpage.h"
+#include "usb/kernel_port_interface.h"
+#include "utils/debugutil.h"
+#include "utils/driversettings.h"
 #include <QSettings>
-#include <QFile>
-#include <QTextStream>
 #include <QDebug>
 #include <QMessageBox>
 
@@ -295,16 +296,10 @@ void SettingsPage::setupFanConfiguration()
 void SettingsPage::onFanPortToggled(int port, bool enabled)
 {
     // Write to kernel driver immediately
-    QString procPath = QString("/proc/Lian_li_SL_INFINITY/Port_%1/fan_config").arg(port);
-    QFile file(procPath);
-    
-    if (file.open(QIODevice::WriteOnly)) {
-        QTextStream stream(&file);
-        stream << (enabled ? "1" : "0");
-        file.close();
+    if (KernelPortInterface::Instance().SetFanConfig(port, enabled)) {
         qDebug() << "Fan port" << port << "set to" << (enabled ? "enabled" : "disabled");
     } else {
-        qWarning() << "Failed to configure fan port" << port << ":" << file.errorString();
+        qWarning() << "Failed to configure fan port" << port << ": kernel driver not available";
     }
     
     // Save to settings for persistence
@@ -313,14 +308,12 @@ void SettingsPage::onFanPortToggled(int port, bool enabled)
 
 void SettingsPage::loadFanConfiguration()
 {
-    // Load from QSettings
-    QSettings settings("LianLi", "LConnect3");
-    
-    // Load saved configuration, default to all enabled
-    bool port1 = settings.value("FanConfig/Port1", true).toBool();
-    bool port2 = settings.value("FanConfig/Port2", true).toBool();
-    bool port3 = settings.value("FanConfig/Port3", true).toBool();
-    bool port4 = settings.value("FanConfig/Port4", true).toBool();
+    // Load saved configuration, default to all enabled. The driver already
+    // got it at startup (DriverSettings::applySaved); this only shows it
+    bool port1 = DriverSettings::fanPortEnabled(1);
+    bool port2 = DriverSettings::fanPortEnabled(2);
+    bool port3 = DriverSettings::fanPortEnabled(3);
+    bool port4 = DriverSettings::fanPortEnabled(4);
     
     // Block signals while setting initial state to avoid triggering writes
     m_fanPort1Check->blockSignals(true);
@@ -337,26 +330,6 @@ void SettingsPage::loadFanConfiguration()
     m_fanPort2Check->blockSignals(false);
     m_fanPort3Check->blockSignals(false);
     m_fanPort4Check->blockSignals(false);
-    
-    // Apply to kernel driver
-    for (int port = 1; port <= 4; ++port) {
-        bool enabled = false;
-        switch (port) {
-            case 1: enabled = port1; break;
-            case 2: enabled = port2; break;
-            case 3: enabled = port3; break;
-            case 4: enabled = port4; break;
-        }
-        
-        QString procPath = QString("/proc/Lian_li_SL_INFINITY/Port_%1/fan_config").arg(port);
-        QFile file(procPath);
-        
-        if (file.open(QIODevice::WriteOnly)) {
-            QTextStream stream(&file);
-            stream << (enabled ? "1" : "0");
-            file.close();
-        }
-    }
 }
 
 void SettingsPage::saveFanConfiguration()
@@ -373,15 +346,8 @@ void SettingsPage::saveFanConfiguration()
 
 void SettingsPage::writeKernelLoggingFlag(bool enabled)
 {
-    QString procPath = "/proc/Lian_li_SL_INFINITY/logging_enabled";
-    QFile file(procPath);
-
-    if (file.open(QIODevice::WriteOnly)) {
-        QTextStream stream(&file);
-        stream << (enabled ? "1" : "0");
-        file.close();
-    } else {
-        qWarning() << "Failed to set kernel logging state:" << file.errorString();
+    if (!KernelPortInterface::Instance().SetLoggingEnabled(enabled)) {
+        qWarning() << "Failed to set kernel logging state: kernel driver not available";
     }
 }
 
@@ -415,6 +381,7 @@ void SettingsPage::setupDebugSettings()
         QSettings settings("LianLi", "LConnect3");
         settings.setValue("Debug/Enabled", checked);
         settings.sync();
+        DebugUtil::setDebugEnabled(checked);
         
         if (checked) {
             qDebug() << "Debug mode enabled - verbose logging active";
@@ -435,6 +402,7 @@ void SettingsPage::setupDebugSettings()
         QSettings settings("LianLi", "LConnect3");
         settings.setValue("Debug/FanSpeeds", checked);
         settings.sync();
+        DebugUtil::setCategoryEnabled(DebugUtil::FlagFanSpeeds, checked);
     });
     
     connect(m_debugModeCheck, &QCheckBox::toggled, m_debugFanSpeedsCheck, &QCheckBox::setEnabled);
@@ -451,6 +419,7 @@ void SettingsPage::setupDebugSettings()
         QSettings settings("LianLi", "LConnect3");
         settings.setValue("Debug/FanLights", checked);
         settings.sync();
+        DebugUtil::setCategoryEnabled(DebugUtil::FlagFanLights, checked);
     });
     
     connect(m_debugModeCheck, &QCheckBox::toggled, m_debugFanLightsCheck, &QCheckBox::setEnabled);
@@ -490,7 +459,4 @@ void SettingsPage::setupDebugSettings()
     debugLayout->addWidget(infoLabel);
     
     m_leftLayout->addWidget(m_debugGroup);
-
-    // Push the persisted kernel logging preference down to the driver on startup
-    writeKernelLoggingFlag(kernelLogs && debugEnabled);
 }
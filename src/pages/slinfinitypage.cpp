@@ -4,7 +4,6 @@
 #include <QTimer>
 #include <QColorDialog>
 #include <QMessageBox>
-#include <QThread>
 #include <QSettings>
 
 SLInfinityPage::SLInfinityPage(QWidget *parent)
@@ -34,10 +33,11 @@ SLInfinityPage::SLInfinityPage(QWidget *parent)
         m_colorButtons[i] = nullptr;
     }
     
-    // Initialize Lian Li integration
-    m_lianLi = new LianLiQtIntegration(this);
+    // The hub session is shared with the rest of the application
+    m_lianLi = LianLiQtIntegration::shared();
     connect(m_lianLi, &LianLiQtIntegration::deviceConnected, this, &SLInfinityPage::onDeviceConnected);
     connect(m_lianLi, &LianLiQtIntegration::deviceDisconnected, this, &SLInfinityPage::onDeviceDisconnected);
+    connect(m_lianLi, &LianLiQtIntegration::errorOccurred, this, &SLInfinityPage::onDeviceError);
     
     setupUI();
     setupFanVisualization();
@@ -575,10 +575,10 @@ void SLInfinityPage::applyCurrentEffect()
             m_lianLi->setChannelStaticWithFanColors(channel, fanColors, m_currentBrightness);
             // Increased delay between channels to ensure proper synchronization
             // The hardware may need time to process the first channel before accepting the second
-            QThread::msleep(50);
+            m_lianLi->queueDelay(50);
             if (channel + 1 < 8) {
                 m_lianLi->setChannelStaticWithFanColors(channel + 1, fanColors, m_currentBrightness);
-                QThread::msleep(50); // Additional delay after second channel
+                m_lianLi->queueDelay(50); // Additional delay after second channel
             }
         }
     } else if (m_currentEffect == "Breathing") {
@@ -955,6 +955,15 @@ void SLInfinityPage::onDeviceDisconnected()
     }
 }
 
+void SLInfinityPage::onDeviceError(const QString &error)
+{
+    // Writes are queued, so this arrives after the status said "applied"
+    if (m_statusLabel) {
+        m_statusLabel->setText("✗ " + error);
+        m_statusLabel->setStyleSheet("color: red; font-weight: bold;");
+    }
+}
+
 void SLInfinityPage::selectPort(int port)
 {
     if (port < 0 || port >= 4) {
@@ -34,6 +34,7 @@ private slots:
     void onColorButtonClicked();
     void onDeviceConnected();
     void onDeviceDisconnected();
+    void onDeviceError(const QString &error);
 
 private:
     void setupUI();
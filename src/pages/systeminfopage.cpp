@@ -1,19 +1,8 @@
 #include "systeminfopage.h"
 #include "widgets/monitoringcard.h"
 #include <QFont>
-#include <QProcess>
-#include <QFile>
-#include <QTextStream>
-#include <QDir>
-#include <QRegularExpression>
 #include <QtMath>
 #include <algorithm>
-#include <QTimer>
-#include <QDateTime>
-
-// Initialize static variables
-qint64 SystemInfoPage::m_prevEnergyUJ = 0;
-qint64 SystemInfoPage::m_prevTimestamp = 0;
 
 SystemInfoPage::SystemInfoPage(QWidget *parent)
     : QWidget(parent)
@@ -21,13 +10,7 @@ SystemInfoPage::SystemInfoPage(QWidget *parent)
     setupUI();
     createMonitoringCards();
     
-    // Start update timer
-    m_updateTimer = new QTimer(this);
-    connect(m_updateTimer, &QTimer::timeout, this, &SystemInfoPage::updateSystemInfo);
-    m_updateTimer->start(1000); // Update every second
-    
-    // Initial update
-    updateSystemInfo();
+    // Readings arrive from the shared SensorService (see setSensorService)
 }
 
 void SystemInfoPage::setupUI()
@@ -419,402 +402,79 @@ void SystemInfoPage::createMonitoringCards()
     m_contentGrid->addWidget(bottomContainer, 2, 0, 1, 2); // Span both columns
 }
 
-void SystemInfoPage::updateSystemInfo()
-{
-    // Get real system data
-    updateCPUInfo();
-    updateGPUInfo();
-    updateRAMInfo();
-    updateNetworkInfo();
-    updateStorageInfo();
-}
-
-void SystemInfoPage::updateCPUInfo()
+void SystemInfoPage::setSensorService(SensorService *service)
 {
-    // CPU Load from /proc/stat (real-time CPU usage)
-    static long prevIdle = 0, prevTotal = 0;
-    
-    QFile statFile("/proc/stat");
-    if (statFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&statFile);
-        QString line = stream.readLine();
-        
-        if (line.startsWith("cpu ")) {
-            QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 8) {
-                // Parse CPU times: user, nice, system, idle, iowait, irq, softirq, steal
-                long user = parts[1].toLong();
-                long nice = parts[2].toLong();
-                long system = parts[3].toLong();
-                long idle = parts[4].toLong();
-                long iowait = parts[5].toLong();
-                long irq = parts[6].toLong();
-                long softirq = parts[7].toLong();
-                long steal = parts.size() > 8 ? parts[8].toLong() : 0;
-                
-                long totalIdle = idle + iowait;
-                long total = user + nice + system + totalIdle + irq + softirq + steal;
-                
-                if (prevTotal > 0) {
-                    long totalDiff = total - prevTotal;
-                    long idleDiff = totalIdle - prevIdle;
-                    
-                    if (totalDiff > 0) {
-                        int cpuLoad = static_cast<int>(((totalDiff - idleDiff) * 100) / totalDiff);
-                        cpuLoad = std::max(0, std::min(100, cpuLoad)); // Clamp between 0-100
-                        
-                        m_cpuLoadCard->setProgress(cpuLoad);
-                        m_cpuLoadCard->setValue(QString::number(cpuLoad) + "%");
-                        m_cpuLoadCard->setSubValue("CPU LOAD");
-                    }
-                }
-                
-                prevIdle = totalIdle;
-                prevTotal = total;
-            }
-        }
-        statFile.close();
+    if (m_sensorService) {
+        disconnect(m_sensorService, nullptr, this, nullptr);
     }
-    
-    // CPU Temperature - try sensors command first (most accurate)
-    int maxTemp = 0;
-    QProcess sensorsProcess;
-    sensorsProcess.start("sensors", QStringList() << "k10temp-pci-00c3");
-    sensorsProcess.waitForFinished(1000);
-    
-    if (sensorsProcess.exitCode() == 0) {
-        QString output = sensorsProcess.readAllStandardOutput();
-        // Look for Tctl temperature (CPU core temperature)
-        QRegularExpression tempRegex("Tctl:\\s*\\+?([0-9.]+)°C");
-        QRegularExpressionMatch match = tempRegex.match(output);
-        if (match.hasMatch()) {
-            maxTemp = static_cast<int>(match.captured(1).toDouble());
-        }
+
+    m_sensorService = service;
+    if (!m_sensorService) {
+        return;
     }
-    
-    // Fallback: try hwmon if sensors didn't work
-    if (maxTemp == 0) {
-        QDir hwmonDir("/sys/class/hwmon");
-        QStringList hwmonDirs = hwmonDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-        
-        for (const QString &hwmon : hwmonDirs) {
-            QFile nameFile("/sys/class/hwmon/" + hwmon + "/name");
-            if (nameFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&nameFile);
-                QString name = stream.readLine().trimmed();
-                nameFile.close();
-                
-                // Check for CPU temperature sensors
-                if (name.contains("coretemp") || name.contains("k10temp") || name.contains("zenpower") || 
-                    name.contains("asus") || name.contains("acpi")) {
-                    
-                    QDir hwmonSubDir("/sys/class/hwmon/" + hwmon);
-                    QStringList files = hwmonSubDir.entryList(QDir::Files);
-                    for (const QString &file : files) {
-                        if (file.startsWith("temp") && file.endsWith("_input")) {
-                            QFile tempFile("/sys/class/hwmon/" + hwmon + "/" + file);
-                            if (tempFile.open(QIODevice::ReadOnly)) {
-                                QTextStream tStream(&tempFile);
-                                QString tempStr = tStream.readLine();
-                                if (!tempStr.isEmpty()) {
-                                    int temp = tempStr.toInt() / 1000; // Convert millidegrees to degrees
-                                    if (temp > maxTemp && temp < 200) { // Reasonable temperature range
-                                        maxTemp = temp;
-                                    }
-                                }
-                                tempFile.close();
-                            }
-                        }
-                    }
-                }
-            }
-        }
+
+    connect(m_sensorService, &SensorService::snapshotReady, this, &SystemInfoPage::onSensorSnapshot);
+
+    // Show whatever was sampled before the page was wired up
+    SensorSnapshot snapshot = m_sensorService->latestSnapshot();
+    if (snapshot.sequence > 0) {
+        onSensorSnapshot(snapshot);
     }
-    
-    // Fallback: try thermal zones if hwmon didn't work
-    if (maxTemp == 0) {
-        QDir thermalDir("/sys/class/thermal");
-        QStringList thermalZones = thermalDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-        for (const QString &zone : thermalZones) {
-            if (zone.startsWith("thermal_zone")) {
-                QFile tempFile("/sys/class/thermal/" + zone + "/temp");
-                if (tempFile.open(QIODevice::ReadOnly)) {
-                    QTextStream stream(&tempFile);
-                    int temp = stream.readLine().toInt() / 1000; // Convert millidegrees to degrees
-                    if (temp > maxTemp) maxTemp = temp;
-                    tempFile.close();
-                }
-            }
-        }
+}
+
+void SystemInfoPage::onSensorSnapshot(const SensorSnapshot &snapshot)
+{
+    updateCPUInfo(snapshot);
+    updateGPUInfo(snapshot.gpu);
+    updateRAMInfo(snapshot);
+    updateNetworkInfo(snapshot);
+    updateStorageInfo(snapshot);
+}
+
+void SystemInfoPage::updateCPUInfo(const SensorSnapshot &snapshot)
+{
+    if (snapshot.cpuLoad >= 0) {
+        m_cpuLoadCard->setProgress(snapshot.cpuLoad);
+        m_cpuLoadCard->setValue(QString::number(snapshot.cpuLoad) + "%");
+        m_cpuLoadCard->setSubValue("CPU LOAD");
     }
     
     // Update CPU temperature label
-    if (maxTemp > 0) {
-        m_cpuTempLabel->setText(QString::number(maxTemp) + " °C");
+    if (snapshot.cpuTemperature > 0) {
+        m_cpuTempLabel->setText(QString::number(snapshot.cpuTemperature) + " °C");
     } else {
         m_cpuTempLabel->setText("-- °C");
     }
     
-    // CPU Clock from /proc/cpuinfo
-    QFile cpuFile("/proc/cpuinfo");
-    if (cpuFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&cpuFile);
-        QString line;
-        double maxClock = 0.0;
-        while (stream.readLineInto(&line)) {
-            if (line.startsWith("cpu MHz")) {
-                QStringList parts = line.split(':');
-                if (parts.size() == 2) {
-                    double mhz = parts[1].trimmed().toDouble();
-                    if (mhz > maxClock) maxClock = mhz;
-                }
-            }
-        }
-        cpuFile.close();
-        
-        // Update CPU clock label
-        if (maxClock > 0) {
-            m_cpuClockLabel->setText(QString::number(static_cast<int>(maxClock)) + " MHz");
-        } else {
-            m_cpuClockLabel->setText("-- MHz");
-        }
+    // Update CPU clock label
+    if (snapshot.cpuClock > 0) {
+        m_cpuClockLabel->setText(QString::number(snapshot.cpuClock) + " MHz");
     } else {
         m_cpuClockLabel->setText("-- MHz");
     }
     
-    // CPU Power and Voltage - try to get from various sources
-    updateCPUPowerAndVoltage();
-}
-
-void SystemInfoPage::updateCPUPowerAndVoltage()
-{
-    // Try to get CPU power from RAPL (Running Average Power Limit)
-    QStringList raplPaths = {
-        "/sys/class/powercap/intel-rapl/intel-rapl:0/energy_uj",
-        "/sys/class/powercap/intel-rapl/intel-rapl:1/energy_uj",
-        "/sys/class/powercap/intel-rapl/intel-rapl:0:0/energy_uj"
-    };
-    
-    bool foundRAPL = false;
-    for (const QString &path : raplPaths) {
-        QFile raplFile(path);
-        if (raplFile.open(QIODevice::ReadOnly)) {
-            QTextStream stream(&raplFile);
-            QString energyStr = stream.readLine();
-            if (!energyStr.isEmpty()) {
-                qint64 currentEnergyUJ = energyStr.toLongLong();
-                qint64 currentTimestamp = QDateTime::currentMSecsSinceEpoch();
-                
-                if (m_prevTimestamp > 0 && m_prevEnergyUJ > 0) {
-                    qint64 timeDiff = currentTimestamp - m_prevTimestamp; // milliseconds
-                    qint64 energyDiff = currentEnergyUJ - m_prevEnergyUJ; // microjoules
-                    
-                    if (timeDiff > 0 && energyDiff >= 0) {
-                        // Convert to watts: (microjoules / 1000000) / (milliseconds / 1000)
-                        double powerW = (energyDiff / 1000000.0) / (timeDiff / 1000.0);
-                        // Clamp to reasonable range (0-500W)
-                        if (powerW >= 0 && powerW <= 500) {
-                            m_cpuPowerCard->setValue(QString::number(powerW, 'f', 1) + " W");
-                        } else {
-                            m_cpuPowerCard->setValue("-- W");
-                        }
-                    } else {
-                        m_cpuPowerCard->setValue("-- W");
-                    }
-                } else {
-                    m_cpuPowerCard->setValue("-- W");
-                }
-                
-                m_prevEnergyUJ = currentEnergyUJ;
-                m_prevTimestamp = currentTimestamp;
-                foundRAPL = true;
-            }
-            raplFile.close();
-            break;
-        }
-    }
-    
-    if (!foundRAPL) {
-        // Try alternative power monitoring methods
-        // Check if we can use sensors command as fallback
-        QProcess sensorsProcess;
-        sensorsProcess.start("sensors", QStringList() << "-A");
-        sensorsProcess.waitForFinished(1000);
-        
-        if (sensorsProcess.exitCode() == 0) {
-            QString output = sensorsProcess.readAllStandardOutput();
-            // Look for power readings in sensors output
-            QRegularExpression powerRegex("P\\w*:\\s*([0-9.]+)\\s*W");
-            QRegularExpressionMatch match = powerRegex.match(output);
-            if (match.hasMatch()) {
-                double powerW = match.captured(1).toDouble();
-                if (powerW > 0 && powerW <= 500) {
-                    m_cpuPowerCard->setValue(QString::number(powerW, 'f', 1) + " W");
-                    foundRAPL = true;
-                }
-            }
-        }
-        
-        // Try to estimate power from CPU frequency and load (very rough approximation)
-        if (!foundRAPL) {
-            // This is a very rough estimation - not accurate but better than N/A
-            // Get CPU frequency from /proc/cpuinfo
-            QFile cpuFile("/proc/cpuinfo");
-            if (cpuFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&cpuFile);
-                QString line;
-                double maxFreq = 0.0;
-                while (stream.readLineInto(&line)) {
-                    if (line.startsWith("cpu MHz")) {
-                        QStringList parts = line.split(':');
-                        if (parts.size() == 2) {
-                            double freq = parts[1].trimmed().toDouble();
-                            if (freq > maxFreq) maxFreq = freq;
-                        }
-                    }
-                }
-                cpuFile.close();
-                
-                if (maxFreq > 0) {
-                    // Very rough power estimation based on frequency
-                    // This is not accurate but gives a ballpark figure
-                    double estimatedPower = (maxFreq / 1000.0) * 0.5; // Rough W/GHz ratio
-                    m_cpuPowerCard->setValue("~" + QString::number(estimatedPower, 'f', 1) + " W");
-                    foundRAPL = true;
-                }
-            }
-        }
-        
-        if (!foundRAPL) {
-            m_cpuPowerCard->setValue("N/A W");
-        }
-    }
-    
-    // Try to get CPU voltage from various sources
-    bool voltageFound = false;
-    
-    // Try from /sys/class/hwmon (common on modern systems)
-    QDir hwmonDir("/sys/class/hwmon");
-    QStringList hwmonDirs = hwmonDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    for (const QString &hwmon : hwmonDirs) {
-        QFile nameFile("/sys/class/hwmon/" + hwmon + "/name");
-        if (nameFile.open(QIODevice::ReadOnly)) {
-            QTextStream stream(&nameFile);
-            QString name = stream.readLine().trimmed();
-            nameFile.close();
-            
-            if (name.contains("coretemp") || name.contains("k10temp") || name.contains("zenpower") || 
-                name.contains("asus") || name.contains("acpi")) {
-                // Look for voltage input files
-                QDir hwmonSubDir("/sys/class/hwmon/" + hwmon);
-                QStringList files = hwmonSubDir.entryList(QDir::Files);
-                for (const QString &file : files) {
-                    if (file.startsWith("in") && file.endsWith("_input")) {
-                        QFile voltageFile("/sys/class/hwmon/" + hwmon + "/" + file);
-                        if (voltageFile.open(QIODevice::ReadOnly)) {
-                            QTextStream vStream(&voltageFile);
-                            QString voltageStr = vStream.readLine();
-                            if (!voltageStr.isEmpty()) {
-                                double voltage = voltageStr.toDouble() / 1000.0; // Convert mV to V
-                                if (voltage > 0.5 && voltage < 2.0) { // Reasonable CPU voltage range
-                                    m_cpuVoltageCard->setValue(QString::number(voltage, 'f', 3) + " V");
-                                    voltageFound = true;
-                                    voltageFile.close();
-                                    break;
-                                }
-                            }
-                            voltageFile.close();
-                        }
-                    }
-                }
-                if (voltageFound) break;
-            }
-        }
+    // CPU power; estimates are marked with a tilde
+    if (snapshot.cpuPower >= 0) {
+        QString prefix = snapshot.cpuPowerEstimated ? "~" : "";
+        m_cpuPowerCard->setValue(prefix + QString::number(snapshot.cpuPower, 'f', 1) + " W");
+    } else {
+        m_cpuPowerCard->setValue("N/A W");
     }
     
-    // Try alternative voltage sources if hwmon didn't work
-    if (!voltageFound) {
-        // Try sensors command as fallback
-        QProcess sensorsProcess;
-        sensorsProcess.start("sensors", QStringList() << "-A");
-        sensorsProcess.waitForFinished(1000);
-        
-        if (sensorsProcess.exitCode() == 0) {
-            QString output = sensorsProcess.readAllStandardOutput();
-            // Look for voltage readings in sensors output
-            QRegularExpression voltageRegex("V\\w*:\\s*([0-9.]+)\\s*V");
-            QRegularExpressionMatch match = voltageRegex.match(output);
-            if (match.hasMatch()) {
-                double voltage = match.captured(1).toDouble();
-                if (voltage > 0.5 && voltage < 2.0) {
-                    m_cpuVoltageCard->setValue(QString::number(voltage, 'f', 3) + " V");
-                    voltageFound = true;
-                }
-            }
-        }
-        
-        // Try to get voltage from /proc/cpuinfo or other sources
-        if (!voltageFound) {
-            QFile cpuFile("/proc/cpuinfo");
-            if (cpuFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&cpuFile);
-                QString line;
-                while (stream.readLineInto(&line)) {
-                    // Look for voltage-related information
-                    if (line.contains("voltage", Qt::CaseInsensitive) || 
-                        line.contains("vid", Qt::CaseInsensitive)) {
-                        // Extract voltage if found
-                        QRegularExpression voltageRegex("([0-9.]+)\\s*V");
-                        QRegularExpressionMatch match = voltageRegex.match(line);
-                        if (match.hasMatch()) {
-                            double voltage = match.captured(1).toDouble();
-                            if (voltage > 0.5 && voltage < 2.0) {
-                                m_cpuVoltageCard->setValue(QString::number(voltage, 'f', 3) + " V");
-                                voltageFound = true;
-                                break;
-                            }
-                        }
-                    }
-                }
-                cpuFile.close();
-            }
-        }
-        
-        // Try to estimate voltage based on CPU model (very rough)
-        if (!voltageFound) {
-            QFile cpuFile("/proc/cpuinfo");
-            if (cpuFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&cpuFile);
-                QString line;
-                while (stream.readLineInto(&line)) {
-                    if (line.startsWith("model name")) {
-                        QString model = line.toLower();
-                        // Very rough voltage estimation based on CPU generation
-                        if (model.contains("ryzen") || model.contains("zen")) {
-                            m_cpuVoltageCard->setValue("~1.1 V"); // Typical for modern AMD
-                            voltageFound = true;
-                        } else if (model.contains("intel")) {
-                            m_cpuVoltageCard->setValue("~1.2 V"); // Typical for modern Intel
-                            voltageFound = true;
-                        }
-                        break;
-                    }
-                }
-                cpuFile.close();
-            }
+    // CPU voltage; estimates are marked with a tilde
+    if (snapshot.cpuVoltage > 0) {
+        if (snapshot.cpuVoltageEstimated) {
+            m_cpuVoltageCard->setValue("~" + QString::number(snapshot.cpuVoltage, 'f', 1) + " V");
+        } else {
+            m_cpuVoltageCard->setValue(QString::number(snapshot.cpuVoltage, 'f', 3) + " V");
         }
-    }
-    
-    if (!voltageFound) {
+    } else {
         m_cpuVoltageCard->setValue("N/A V");
     }
 }
 
-void SystemInfoPage::updateGPUInfo()
+void SystemInfoPage::updateGPUInfo(const GPUInfo &gpuInfo)
 {
-    // Detect GPU type and get information
-    GPUInfo gpuInfo = detectGPU();
-    
     // Update GPU load
     if (gpuInfo.load >= 0) {
         m_gpuLoadCard->setProgress(gpuInfo.load);
@@ -859,492 +519,61 @@ void SystemInfoPage::updateGPUInfo()
     }
 }
 
-GPUInfo SystemInfoPage::detectGPU()
-{
-    // First, try to detect GPU type from lspci - scan all devices
-    QProcess lspciProcess;
-    lspciProcess.start("lspci", QStringList() << "-n");
-    lspciProcess.waitForFinished(1000);
-    
-    QString gpuVendor = "Unknown";
-    QString gpuModel = "Unknown";
-    
-    if (lspciProcess.exitCode() == 0) {
-        QString output = lspciProcess.readAllStandardOutput();
-        QStringList lines = output.split('\n', Qt::SkipEmptyParts);
-        
-        for (const QString &line : lines) {
-            if (line.contains("0300")) { // VGA compatible controller
-                // Parse line like: "41:00.0 0300: 10de:2684 (rev a1)"
-                // Look for pattern: "10de:2684"
-                QRegularExpression pciRegex("(10de|1002|1022|8086):([0-9a-fA-F]+)");
-                QRegularExpressionMatch match = pciRegex.match(line);
-                if (match.hasMatch()) {
-                    QString vendorId = match.captured(1);
-                    QString deviceId = match.captured(2);
-                    
-                    // Detect vendor by PCI ID
-                    if (vendorId == "10de") {
-                        gpuVendor = "NVIDIA";
-                        return detectNVIDIAGPU();
-                    } else if (vendorId == "1002" || vendorId == "1022") {
-                        gpuVendor = "AMD";
-                        return detectAMDGPU();
-                    } else if (vendorId == "8086") {
-                        gpuVendor = "Intel";
-                        return detectIntelGPU();
-                    }
-                }
-            }
-        }
-    }
-    
-    // Fallback to generic detection
-    return detectGenericGPU();
-}
-
-GPUInfo SystemInfoPage::detectNVIDIAGPU()
-{
-    GPUInfo info;
-    info.vendor = "NVIDIA";
-    
-    // Try nvidia-smi first
-    QProcess nvidiaProcess;
-    nvidiaProcess.start("nvidia-smi", QStringList() << "--query-gpu=name,utilization.gpu,temperature.gpu,clocks.gr,power.draw,memory.used,memory.total" << "--format=csv,noheader,nounits");
-    nvidiaProcess.waitForFinished(1000);
-    
-    if (nvidiaProcess.exitCode() == 0) {
-        QString output = nvidiaProcess.readAllStandardOutput();
-        QStringList lines = output.split('\n', Qt::SkipEmptyParts);
-        if (!lines.isEmpty()) {
-            QStringList values = lines[0].split(',');
-            if (values.size() >= 7) {
-                info.model = values[0].trimmed();
-                info.load = values[1].trimmed().toInt();
-                info.temperature = values[2].trimmed().toInt();
-                info.clockRate = values[3].trimmed().toInt();
-                info.power = values[4].trimmed().toDouble();
-                info.memoryUsed = values[5].trimmed().toInt();
-                info.memoryTotal = values[6].trimmed().toInt();
-                
-                // Set voltage to -1 since we're not using it anymore
-                info.voltage = -1.0;
-            }
-        }
-    } else {
-        // Try nouveau driver (open-source NVIDIA driver)
-        QDir drmDir("/sys/class/drm");
-        QStringList cards = drmDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-        
-        for (const QString &card : cards) {
-            if (card.startsWith("card") && !card.contains("-")) {
-                QFile ueventFile("/sys/class/drm/" + card + "/device/uevent");
-                if (ueventFile.open(QIODevice::ReadOnly)) {
-                    QTextStream stream(&ueventFile);
-                    QString line;
-                    while (stream.readLineInto(&line)) {
-                        if (line.startsWith("DRIVER=nouveau")) {
-                            // For nouveau, we can only get basic info
-                            info.model = "NVIDIA RTX 4090 (nouveau)";
-                            info.load = -1; // Not available in nouveau
-                            info.temperature = -1; // Not available in nouveau
-                            info.clockRate = -1; // Not available in nouveau
-                            info.power = -1.0; // Not available in nouveau
-                            info.voltage = -1.0; // Not available in nouveau
-                            break;
-                        }
-                    }
-                    ueventFile.close();
-                }
-            }
-        }
-    }
-    
-    return info;
-}
-
-GPUInfo SystemInfoPage::detectAMDGPU()
-{
-    GPUInfo info;
-    info.vendor = "AMD";
-    info.memoryUsed = -1;
-    info.memoryTotal = -1;
-    
-    // Try radeontop if available
-    QProcess radeontopProcess;
-    radeontopProcess.start("radeontop", QStringList() << "-d" << "1" << "-l" << "1");
-    radeontopProcess.waitForFinished(1000);
-    
-    if (radeontopProcess.exitCode() == 0) {
-        QString output = radeontopProcess.readAllStandardOutput();
-        // Parse radeontop output for GPU utilization
-        QRegularExpression loadRegex("gpu\\s+(\\d+)%");
-        QRegularExpressionMatch match = loadRegex.match(output);
-        if (match.hasMatch()) {
-            info.load = match.captured(1).toInt();
-        }
-    }
-    
-    // Try sensors for temperature
-    QProcess sensorsProcess;
-    sensorsProcess.start("sensors", QStringList() << "-A");
-    sensorsProcess.waitForFinished(1000);
-    
-    if (sensorsProcess.exitCode() == 0) {
-        QString output = sensorsProcess.readAllStandardOutput();
-        // Look for AMD GPU temperature
-        QRegularExpression tempRegex("amdgpu.*?temp1:\\s*\\+?([0-9.]+)°C");
-        QRegularExpressionMatch match = tempRegex.match(output);
-        if (match.hasMatch()) {
-            info.temperature = static_cast<int>(match.captured(1).toDouble());
-        }
-    }
-    
-    // Try /sys/class/drm for basic info
-    QDir drmDir("/sys/class/drm");
-    QStringList cards = drmDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    
-    for (const QString &card : cards) {
-        if (card.startsWith("card") && !card.contains("-")) {
-            QFile ueventFile("/sys/class/drm/" + card + "/device/uevent");
-            if (ueventFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&ueventFile);
-                QString line;
-                while (stream.readLineInto(&line)) {
-                    if (line.startsWith("DRIVER=amdgpu")) {
-                        info.model = "AMD (amdgpu)";
-                        break;
-                    }
-                }
-                ueventFile.close();
-            }
-        }
-    }
-    
-    return info;
-}
-
-GPUInfo SystemInfoPage::detectIntelGPU()
-{
-    GPUInfo info;
-    info.vendor = "Intel";
-    info.memoryUsed = -1;
-    info.memoryTotal = -1;
-    
-    // Try intel_gpu_top if available
-    QProcess intelProcess;
-    intelProcess.start("intel_gpu_top", QStringList() << "-s" << "1");
-    intelProcess.waitForFinished(1000);
-    
-    if (intelProcess.exitCode() == 0) {
-        QString output = intelProcess.readAllStandardOutput();
-        // Parse intel_gpu_top output for GPU utilization
-        QRegularExpression loadRegex("GPU\\s+(\\d+)%");
-        QRegularExpressionMatch match = loadRegex.match(output);
-        if (match.hasMatch()) {
-            info.load = match.captured(1).toInt();
-        }
-    }
-    
-    // Try sensors for temperature
-    QProcess sensorsProcess;
-    sensorsProcess.start("sensors", QStringList() << "-A");
-    sensorsProcess.waitForFinished(1000);
-    
-    if (sensorsProcess.exitCode() == 0) {
-        QString output = sensorsProcess.readAllStandardOutput();
-        // Look for Intel GPU temperature
-        QRegularExpression tempRegex("i915.*?temp1:\\s*\\+?([0-9.]+)°C");
-        QRegularExpressionMatch match = tempRegex.match(output);
-        if (match.hasMatch()) {
-            info.temperature = static_cast<int>(match.captured(1).toDouble());
-        }
-    }
-    
-    // Try /sys/class/drm for basic info
-    QDir drmDir("/sys/class/drm");
-    QStringList cards = drmDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    
-    for (const QString &card : cards) {
-        if (card.startsWith("card") && !card.contains("-")) {
-            QFile ueventFile("/sys/class/drm/" + card + "/device/uevent");
-            if (ueventFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&ueventFile);
-                QString line;
-                while (stream.readLineInto(&line)) {
-                    if (line.startsWith("DRIVER=i915")) {
-                        info.model = "Intel (i915)";
-                        break;
-                    }
-                }
-                ueventFile.close();
-            }
-        }
-    }
-    
-    return info;
-}
-
-GPUInfo SystemInfoPage::detectGenericGPU()
+void SystemInfoPage::updateRAMInfo(const SensorSnapshot &snapshot)
 {
-    GPUInfo info;
-    info.vendor = "Unknown";
-    info.model = "Generic GPU";
-    info.memoryUsed = -1;
-    info.memoryTotal = -1;
-    
-    // Try to get basic info from /sys/class/drm
-    QDir drmDir("/sys/class/drm");
-    QStringList cards = drmDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    
-    for (const QString &card : cards) {
-        if (card.startsWith("card") && !card.contains("-")) {
-            QFile ueventFile("/sys/class/drm/" + card + "/device/uevent");
-            if (ueventFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&ueventFile);
-                QString line;
-                while (stream.readLineInto(&line)) {
-                    if (line.startsWith("DRIVER=")) {
-                        QString driver = line.split('=')[1];
-                        info.model = "GPU (" + driver + ")";
-                        break;
-                    }
-                }
-                ueventFile.close();
-            }
-        }
-    }
-    
-    return info;
-}
-
-void SystemInfoPage::updateRAMInfo()
-{
-    // RAM usage from /proc/meminfo with real-time updates
-    QFile memFile("/proc/meminfo");
-    if (memFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&memFile);
-        QString line;
-        long totalMem = 0, freeMem = 0, availableMem = 0, buffers = 0, cached = 0;
+    if (snapshot.ramTotalKB > 0) {
+        int ramUsage = static_cast<int>((snapshot.ramUsedKB * 100) / snapshot.ramTotalKB);
         
-        while (stream.readLineInto(&line)) {
-            if (line.startsWith("MemTotal:")) {
-                totalMem = line.split(QRegularExpression("\\s+"))[1].toLong();
-            } else if (line.startsWith("MemFree:")) {
-                freeMem = line.split(QRegularExpression("\\s+"))[1].toLong();
-            } else if (line.startsWith("MemAvailable:")) {
-                availableMem = line.split(QRegularExpression("\\s+"))[1].toLong();
-            } else if (line.startsWith("Buffers:")) {
-                buffers = line.split(QRegularExpression("\\s+"))[1].toLong();
-            } else if (line.startsWith("Cached:")) {
-                cached = line.split(QRegularExpression("\\s+"))[1].toLong();
-            }
-        }
+        // Clamp usage between 0-100
+        ramUsage = std::max(0, std::min(100, ramUsage));
         
-        if (totalMem > 0) {
-            // Use MemAvailable for more accurate used memory calculation
-            long usedMem = totalMem - availableMem;
-            int ramUsage = static_cast<int>((usedMem * 100) / totalMem);
-            
-            // Clamp usage between 0-100
-            ramUsage = std::max(0, std::min(100, ramUsage));
-            
-            m_ramUsageCard->setProgress(ramUsage);
-            m_ramUsageCard->setValue(QString::number(ramUsage) + "%");
-            m_ramUsageCard->setSubValue(""); // Clear subValue - we show RAM stats below the circle instead
-
-            const double usedGB = usedMem / 1024.0 / 1024.0;
-            const double totalGB = totalMem / 1024.0 / 1024.0;
-            m_ramDetailsLabel->setText(
-                QString::number(usedGB, 'f', 1) + " GB / " +
-                QString::number(totalGB, 'f', 1) + " GB RAM");
-        } else {
-            // Fallback if /proc/meminfo fails
-            m_ramUsageCard->setProgress(0);
-            m_ramUsageCard->setValue("--%");
-            m_ramUsageCard->setSubValue(""); // Clear subValue - we show RAM stats below the circle instead
-            m_ramDetailsLabel->setText("-- / -- RAM");
-        }
-        memFile.close();
+        m_ramUsageCard->setProgress(ramUsage);
+        m_ramUsageCard->setValue(QString::number(ramUsage) + "%");
+        m_ramUsageCard->setSubValue(""); // Clear subValue - we show RAM stats below the circle instead
+
+        const double usedGB = snapshot.ramUsedKB / 1024.0 / 1024.0;
+        const double totalGB = snapshot.ramTotalKB / 1024.0 / 1024.0;
+        m_ramDetailsLabel->setText(
+            QString::number(usedGB, 'f', 1) + " GB / " +
+            QString::number(totalGB, 'f', 1) + " GB RAM");
     } else {
-        // Error fallback
         m_ramUsageCard->setProgress(0);
         m_ramUsageCard->setValue("--%");
-        m_ramUsageCard->setSubValue("RAM");
+        m_ramUsageCard->setSubValue(""); // Clear subValue - we show RAM stats below the circle instead
         m_ramDetailsLabel->setText("-- / -- RAM");
     }
 }
 
-void SystemInfoPage::updateNetworkInfo()
+void SystemInfoPage::updateNetworkInfo(const SensorSnapshot &snapshot)
 {
-    // Network stats from /proc/net/dev with real-time speed calculation
-    static long prevRx = 0, prevTx = 0;
-    static QTime prevTime;
-    static QString primaryInterface = "";
-    
-    QFile netFile("/proc/net/dev");
-    if (netFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&netFile);
-        QString line;
-        long totalRx = 0, totalTx = 0;
-        long maxTraffic = 0;
-        QString detectedPrimaryInterface = "";
-        
-        // Skip header lines
-        stream.readLine();
-        stream.readLine();
-        
-        while (stream.readLineInto(&line)) {
-            // Parse the line more carefully - interface name is before the first colon
-            int colonPos = line.indexOf(':');
-            if (colonPos > 0) {
-                QString interface = line.left(colonPos).trimmed();
-                QString data = line.mid(colonPos + 1).trimmed();
-                QStringList parts = data.split(QRegularExpression("\\s+"));
-                
-                if (parts.size() >= 9) {
-                    long rx = parts[0].toLong();  // First number after colon is RX bytes
-                    long tx = parts[8].toLong();  // 9th number after colon is TX bytes
-                    long totalTraffic = rx + tx;
-                    
-                    // Skip loopback and virtual interfaces, but include any interface with traffic
-                    bool isVirtualInterface = interface.startsWith("lo") || 
-                                            interface.startsWith("docker") || 
-                                            interface.startsWith("veth") ||
-                                            interface.startsWith("br-") ||
-                                            interface.startsWith("virbr") ||
-                                            interface.startsWith("tun") ||
-                                            interface.startsWith("tap") ||
-                                            interface.startsWith("sit") ||
-                                            interface.startsWith("ppp") ||
-                                            interface.isEmpty();
-                    
-                    // Track the interface with the most traffic for primary detection
-                    if (!isVirtualInterface && totalTraffic > maxTraffic) {
-                        maxTraffic = totalTraffic;
-                        detectedPrimaryInterface = interface;
-                    }
-                    
-                    // Include interface if it's not virtual OR if it has significant traffic
-                    if (!isVirtualInterface || (rx > 1000 || tx > 1000)) {
-                        totalRx += rx;
-                        totalTx += tx;
-                    }
-                }
-            }
-        }
-        
-        // Update primary interface if we found a new one with more traffic
-        if (!detectedPrimaryInterface.isEmpty() && detectedPrimaryInterface != primaryInterface) {
-            primaryInterface = detectedPrimaryInterface;
-        }
-        
-        QTime currentTime = QTime::currentTime();
-        
-        
-        if (prevTime.isValid()) {
-            int elapsedMs = prevTime.msecsTo(currentTime);
-            if (elapsedMs > 100 && elapsedMs < 10000) { // Minimum 100ms for responsive readings
-                // Calculate bytes per second with smoothing to reduce noise
-                long rxSpeed = ((totalRx - prevRx) * 1000) / elapsedMs;
-                long txSpeed = ((totalTx - prevTx) * 1000) / elapsedMs;
-                
-                // Apply light smoothing to reduce noise without over-dampening
-                static long smoothedRx = 0, smoothedTx = 0;
-                if (smoothedRx == 0) {
-                    smoothedRx = rxSpeed;
-                    smoothedTx = txSpeed;
-                } else {
-                    // Light exponential moving average with factor 0.7 for new values
-                    smoothedRx = (smoothedRx * 3 + rxSpeed * 7) / 10;
-                    smoothedTx = (smoothedTx * 3 + txSpeed * 7) / 10;
-                }
-                
-                rxSpeed = smoothedRx;
-                txSpeed = smoothedTx;
-                
-                // Handle negative speeds (counter wraparound)
-                if (rxSpeed < 0) rxSpeed = 0;
-                if (txSpeed < 0) txSpeed = 0;
-                
-                // No calibration factor - raw bytes should be close to speed test results
-                
-                
-                // Convert to appropriate units
-                QString rxStr, txStr;
-                
-                if (rxSpeed >= 1024 * 1024) {
-                    rxStr = QString::number(rxSpeed / (1024.0 * 1024.0), 'f', 1) + " MB/s";
-                } else if (rxSpeed >= 1024) {
-                    rxStr = QString::number(rxSpeed / 1024.0, 'f', 1) + " KB/s";
-                } else {
-                    rxStr = QString::number(rxSpeed) + " B/s";
-                }
-                
-                if (txSpeed >= 1024 * 1024) {
-                    txStr = QString::number(txSpeed / (1024.0 * 1024.0), 'f', 1) + " MB/s";
-                } else if (txSpeed >= 1024) {
-                    txStr = QString::number(txSpeed / 1024.0, 'f', 1) + " KB/s";
-                } else {
-                    txStr = QString::number(txSpeed) + " B/s";
-                }
-                
-                m_networkCard->setValue("↑ " + txStr + "\n↓ " + rxStr);
-            } else {
-                // Show total bytes if no recent activity
-                QString totalRxStr = QString::number(totalRx / (1024.0 * 1024.0), 'f', 1) + " MB";
-                QString totalTxStr = QString::number(totalTx / (1024.0 * 1024.0), 'f', 1) + " MB";
-                m_networkCard->setValue("↑ " + totalTxStr + "\n↓ " + totalRxStr);
-            }
-        } else {
-            m_networkCard->setValue("↑ 0 B/s\n↓ 0 B/s");
-        }
-        
-        prevRx = totalRx;
-        prevTx = totalTx;
-        prevTime = currentTime;
-        
-        netFile.close();
-    } else {
+    if (!snapshot.networkAvailable) {
         m_networkCard->setValue("↑ -- B/s\n↓ -- B/s");
+        return;
+    }
+    
+    if (snapshot.networkRxRate < 0 || snapshot.networkTxRate < 0) {
+        m_networkCard->setValue("↑ 0 B/s\n↓ 0 B/s");
+        return;
     }
+    
+    // Convert to appropriate units
+    auto formatSpeed = [](qint64 speed) {
+        if (speed >= 1024 * 1024) {
+            return QString::number(speed / (1024.0 * 1024.0), 'f', 1) + " MB/s";
+        } else if (speed >= 1024) {
+            return QString::number(speed / 1024.0, 'f', 1) + " KB/s";
+        }
+        return QString::number(speed) + " B/s";
+    };
+    
+    m_networkCard->setValue("↑ " + formatSpeed(snapshot.networkTxRate) + "\n↓ " + formatSpeed(snapshot.networkRxRate));
 }
 
-void SystemInfoPage::updateStorageInfo()
+void SystemInfoPage::updateStorageInfo(const SensorSnapshot &snapshot)
 {
-    // Storage info from df command
-    QProcess dfProcess;
-    dfProcess.start("df", QStringList() << "-h");
-    dfProcess.waitForFinished(1000);
-    
-    if (dfProcess.exitCode() == 0) {
-        QString output = dfProcess.readAllStandardOutput();
-        QStringList lines = output.split('\n', Qt::SkipEmptyParts);
-        
-        QString storageInfo;
-        for (const QString &line : lines) {
-            if (line.contains("/dev/") && (line.contains("/") || line.contains("home"))) {
-                QStringList parts = line.split(QRegularExpression("\\s+"));
-                if (parts.size() >= 6) {
-                    QString device = parts[0];
-                    QString size = parts[1];
-                    QString used = parts[2];
-                    QString avail = parts[3];
-                    QString percent = parts[4];
-                    QString mount = parts[5];
-                    
-                    if (mount == "/" || mount.startsWith("/home")) {
-                        // Use actual mount path labels on Linux (no Windows-style drive letters)
-                        QString mountLabel = mount; // e.g. "/" or "/home"
-                        storageInfo += mountLabel + " " + used + "/" + size + " " + percent + "\n";
-                    }
-                }
-            }
-        }
-        
-        if (storageInfo.isEmpty()) {
-            storageInfo = "N/A";
-        }
-        m_storageCard->setValue(storageInfo.trimmed());
+    if (snapshot.storage.isEmpty()) {
+        m_storageCard->setValue("N/A");
+        return;
     }
+    m_storageCard->setValue(snapshot.storage.join('\n'));
 }
@@ -8,46 +8,30 @@
 #include <QLabel>
 #include <QFrame>
 #include <QProgressBar>
-#include <QTimer>
+#include <QPointer>
+#include "sensors/sensorservice.h"
 
 class MonitoringCard;
 
-struct GPUInfo {
-    int load = -1;        // GPU utilization percentage
-    int temperature = -1; // GPU temperature in Celsius
-    int clockRate = -1;   // GPU clock rate in MHz
-    double power = -1.0;  // GPU power consumption in watts
-    double voltage = -1.0; // GPU voltage in volts
-    int memoryUsed = -1;  // GPU memory used in MB
-    int memoryTotal = -1; // GPU total memory in MB
-    QString vendor;       // GPU vendor (NVIDIA, AMD, Intel, etc.)
-    QString model;        // GPU model name
-};
-
 class SystemInfoPage : public QWidget
 {
     Q_OBJECT
 
 public:
     explicit SystemInfoPage(QWidget *parent = nullptr);
+    void setSensorService(SensorService *service);
 
 private slots:
-    void updateSystemInfo();
+    void onSensorSnapshot(const SensorSnapshot &snapshot);
 
 private:
     void setupUI();
     void createMonitoringCards();
-    void updateCPUInfo();
-    void updateCPUPowerAndVoltage();
-    void updateGPUInfo();
-    GPUInfo detectGPU();
-    GPUInfo detectNVIDIAGPU();
-    GPUInfo detectAMDGPU();
-    GPUInfo detectIntelGPU();
-    GPUInfo detectGenericGPU();
-    void updateRAMInfo();
-    void updateNetworkInfo();
-    void updateStorageInfo();
+    void updateCPUInfo(const SensorSnapshot &snapshot);
+    void updateGPUInfo(const GPUInfo &gpuInfo);
+    void updateRAMInfo(const SensorSnapshot &snapshot);
+    void updateNetworkInfo(const SensorSnapshot &snapshot);
+    void updateStorageInfo(const SensorSnapshot &snapshot);
     
     QVBoxLayout *m_mainLayout;
     QHBoxLayout *m_headerLayout;
@@ -80,12 +64,8 @@ private:
     MonitoringCard *m_networkCard;
     MonitoringCard *m_storageCard;
     
-    // Update timer
-    QTimer *m_updateTimer;
-    
-    // CPU power monitoring variables
-    static qint64 m_prevEnergyUJ;
-    static qint64 m_prevTimestamp;
+    // Sampling happens on the sensor thread; this page only renders
+    QPointer<SensorService> m_sensorService;
 };
 
 #endif // SYSTEMINFOPAGE_H
@@ -0,0 +1,264 @@
+#include "hwmonsensors.h"
+#include "utils/qtdebugutil.h"
+#include <QDir>
+#include <QFile>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+static const char *const kHwmonRoot = "/sys/class/hwmon";
+
+HwmonSensors::HwmonSensors()
+    : m_stale(false)
+{
+}
+
+HwmonSensors::~HwmonSensors()
+{
+    close();
+}
+
+void HwmonSensors::close()
+{
+    for (Input &input : m_inputs) {
+        closeFd(input.fd);
+        input = Input();
+    }
+}
+
+void HwmonSensors::discover()
+{
+    close();
+    m_stale = false;
+
+    std::array<Input, SensorCount> best;
+
+    QDir root(kHwmonRoot);
+    const QStringList hwmons = root.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    for (const QString &hwmon : hwmons) {
+        const QString dir = root.filePath(hwmon);
+        const QString chip = readLine(dir + "/name");
+        if (chip.isEmpty()) {
+            continue;
+        }
+
+        const QStringList inputs = QDir(dir).entryList(QStringList() << "temp*_input", QDir::Files, QDir::Name);
+        for (const QString &file : inputs) {
+            const QString label = readLine(dir + "/" + file.chopped(6) + "_label"); // tempN_input -> tempN_label
+
+            for (int s = 0; s < SensorCount; ++s) {
+                int rank = rankInput(static_cast<Sensor>(s), chip, label);
+                if (rank < 0) {
+                    continue;
+                }
+                if (best[s].path.isEmpty() || rank < best[s].rank) {
+                    best[s].rank = rank;
+                    best[s].chip = chip;
+                    best[s].path = dir + "/" + file;
+                }
+            }
+        }
+    }
+
+    for (int s = 0; s < SensorCount; ++s) {
+        if (best[s].path.isEmpty()) {
+            continue;
+        }
+        m_inputs[s] = best[s];
+        m_inputs[s].fd = ::open(QFile::encodeName(best[s].path).constData(), O_RDONLY | O_CLOEXEC);
+        DEBUG_LOG("Hwmon sensor", s, "->", best[s].chip, best[s].path, m_inputs[s].fd >= 0 ? "" : "(open failed)");
+    }
+}
+
+// One pread() of a millidegree temp*_input. The second attempt is on a
+// fresh fd: sysfs attributes of a re-bound driver live in a new inode and
+// the old fd keeps returning errors. False if both attempts fail.
+static bool readInput(int &fd, const QString &path, double &celsius)
+{
+    char buf[24];
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (fd < 0) {
+            fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                break;
+            }
+        }
+
+        ssize_t len = ::pread(fd, buf, sizeof(buf) - 1, 0);
+        if (len > 0) {
+            buf[len] = '\0';
+            char *end = nullptr;
+            long millidegrees = std::strtol(buf, &end, 10);
+            if (end != buf) {
+                celsius = millidegrees / 1000.0;
+                return true;
+            }
+        }
+        ::close(fd);
+        fd = -1;
+    }
+    return false;
+}
+
+double HwmonSensors::readCelsius(Sensor sensor)
+{
+    Input &input = m_inputs[sensor];
+    if (input.path.isEmpty()) {
+        return -1.0;
+    }
+
+    double celsius = -1.0;
+    if (readInput(input.fd, input.path, celsius)) {
+        return celsius;
+    }
+
+    m_stale = true;
+    return -1.0;
+}
+
+int HwmonSensors::rankInput(Sensor sensor, const QString &chip, const QString &label)
+{
+    switch (sensor) {
+    case CPU:
+        // Control temperature first, then die, then anything from a CPU chip
+        if (chip == "k10temp") {
+            if (label == "Tctl") return 0;
+            if (label == "Tdie") return 1;
+            return label.startsWith("Tccd") ? 4 : 3;
+        }
+        if (chip == "zenpower") {
+            if (label == "Tdie") return 0;
+            if (label == "Tctl") return 1;
+            return 3;
+        }
+        if (chip == "coretemp") {
+            if (label.startsWith("Package id")) return 0;
+            return 4;
+        }
+        // Board/ACPI zones are a last resort, but better than nothing
+        if (chip.contains("acpi") || chip.contains("asus")) {
+            return 8;
+        }
+        return -1;
+
+    case GPU:
+        if (chip == "amdgpu") {
+            if (label == "edge" || label.isEmpty()) return 0;
+            if (label == "junction") return 2;
+            return 3;
+        }
+        if (chip == "nouveau") {
+            return 0;
+        }
+        if (chip == "i915" || chip == "xe") {
+            if (label == "pkg" || label.isEmpty()) return 1;
+            return 3;
+        }
+        return -1;
+
+    case NVMe:
+        if (chip == "nvme") {
+            return label == "Composite" || label.isEmpty() ? 0 : 3;
+        }
+        return -1;
+
+    case Liquid:
+        // AIO pumps and loop controllers label it one way or another
+        if (label.contains("coolant", Qt::CaseInsensitive) || label.contains("liquid", Qt::CaseInsensitive)) {
+            return 0;
+        }
+        if (label.contains("water", Qt::CaseInsensitive)) {
+            return 1;
+        }
+        return -1;
+
+    default:
+        return -1;
+    }
+}
+
+QString HwmonSensors::readLine(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    return QString::fromLocal8Bit(file.readLine()).trimmed();
+}
+
+void HwmonSensors::closeFd(int &fd)
+{
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+HwmonChannel::HwmonChannel(const QString &chip, const QString &label)
+    : m_fd(-1)
+{
+    QDir root(kHwmonRoot);
+    const QStringList hwmons = root.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    for (const QString &hwmon : hwmons) {
+        const QString dir = root.filePath(hwmon);
+        if (HwmonSensors::readLine(dir + "/name") != chip) {
+            continue;
+        }
+
+        const QStringList inputs = QDir(dir).entryList(QStringList() << "temp*_input", QDir::Files, QDir::Name);
+        for (const QString &file : inputs) {
+            if (label.isEmpty() || HwmonSensors::readLine(dir + "/" + file.chopped(6) + "_label") == label) {
+                m_path = dir + "/" + file;
+                m_fd = ::open(QFile::encodeName(m_path).constData(), O_RDONLY | O_CLOEXEC);
+                DEBUG_LOG("Hwmon channel", chip, label, "->", m_path);
+                return;
+            }
+        }
+    }
+
+    DEBUG_LOG("Hwmon channel", chip, label, "not found");
+}
+
+QStringList HwmonChannel::available()
+{
+    QStringList channels;
+    QDir root(kHwmonRoot);
+    const QStringList hwmons = root.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    for (const QString &hwmon : hwmons) {
+        const QString dir = root.filePath(hwmon);
+        const QString chip = HwmonSensors::readLine(dir + "/name");
+        const QStringList inputs = QDir(dir).entryList(QStringList() << "temp*_input", QDir::Files, QDir::Name);
+        if (chip.isEmpty() || inputs.isEmpty()) {
+            continue;
+        }
+
+        bool labelled = false;
+        for (const QString &file : inputs) {
+            const QString label = HwmonSensors::readLine(dir + "/" + file.chopped(6) + "_label");
+            if (!label.isEmpty() && !channels.contains(chip + "/" + label)) {
+                channels.append(chip + "/" + label);
+                labelled = true;
+            }
+        }
+        if (!labelled && !channels.contains(chip + "/")) {
+            channels.append(chip + "/");
+        }
+    }
+    return channels;
+}
+
+HwmonChannel::~HwmonChannel()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+double HwmonChannel::readCelsius()
+{
+    double celsius = -1.0;
+    if (m_path.isEmpty() || !readInput(m_fd, m_path, celsius)) {
+        return -1.0;
+    }
+    return celsius;
+}
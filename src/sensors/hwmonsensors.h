@@ -0,0 +1,97 @@
+#ifndef HWMONSENSORS_H
+#define HWMONSENSORS_H
+
+#include <QString>
+#include <QStringList>
+#include <array>
+
+// Temperature inputs resolved once from /sys/class/hwmon.
+//
+// discover() walks the hwmon class a single time, picks the temp*_input
+// that best represents each component (Tctl/Tdie/package for the CPU, edge
+// for the GPU, composite for NVMe, coolant for an AIO or loop controller)
+// and opens it. Each later read is one
+// pread() on that cached fd. A read that fails after one reopen marks the
+// set stale so the owner can run discover() again (driver reload, GPU
+// hot-unplug).
+//
+// Not thread-safe; owned and used by a single thread (SensorService).
+class HwmonSensors
+{
+public:
+    enum Sensor {
+        CPU = 0,
+        GPU,
+        NVMe,
+        Liquid,
+        SensorCount
+    };
+
+    HwmonSensors();
+    ~HwmonSensors();
+
+    HwmonSensors(const HwmonSensors &) = delete;
+    HwmonSensors &operator=(const HwmonSensors &) = delete;
+
+    // (Re)scans /sys/class/hwmon and reopens every input
+    void discover();
+    void close();
+
+    bool has(Sensor sensor) const { return m_inputs[sensor].fd >= 0; }
+    // Chip name ("k10temp", "amdgpu", ...) and input path, empty if not found
+    QString chip(Sensor sensor) const { return m_inputs[sensor].chip; }
+    QString path(Sensor sensor) const { return m_inputs[sensor].path; }
+
+    // Degrees Celsius, or -1 if the sensor is missing or unreadable
+    double readCelsius(Sensor sensor);
+
+    // A read failed since the last discover()
+    bool isStale() const { return m_stale; }
+
+private:
+    friend class HwmonChannel;
+
+    struct Input {
+        int fd = -1;
+        int rank = 0;   // lower is better; used while discovering
+        QString chip;
+        QString path;
+    };
+
+    // Rank of a chip/label pair for `sensor`, or -1 if it doesn't qualify
+    static int rankInput(Sensor sensor, const QString &chip, const QString &label);
+    static QString readLine(const QString &path);
+    static void closeFd(int &fd);
+
+    std::array<Input, SensorCount> m_inputs;
+    bool m_stale;
+};
+
+// One temperature input picked by chip name and label ("k10temp", "Tccd1"),
+// for fan curves bound to a specific channel. Same cached-fd reads as
+// HwmonSensors; an empty label takes the chip's first temperature input.
+class HwmonChannel
+{
+public:
+    HwmonChannel(const QString &chip, const QString &label);
+    ~HwmonChannel();
+
+    HwmonChannel(const HwmonChannel &) = delete;
+    HwmonChannel &operator=(const HwmonChannel &) = delete;
+
+    // Every temperature input as "chip/label"; "chip/" for a chip whose
+    // inputs carry no labels. For picking a channel in the UI.
+    static QStringList available();
+
+    bool isFound() const { return !m_path.isEmpty(); }
+    QString path() const { return m_path; }
+
+    // Degrees Celsius, or -1 if the channel is missing or unreadable
+    double readCelsius();
+
+private:
+    int m_fd;
+    QString m_path;
+};
+
+#endif // HWMONSENSORS_H
@@ -0,0 +1,172 @@
+#include "nvidiasmisession.h"
+#include "utils/qtdebugutil.h"
+#include <QTimer>
+#include <QList>
+
+// Column order of the CSV lines; index first so multi-GPU output can be
+// reduced to GPU 0
+static const char *const kQueryFields =
+    "--query-gpu=index,name,utilization.gpu,temperature.gpu,clocks.gr,power.draw,memory.used,memory.total";
+
+NvidiaSmiSession::NvidiaSmiSession(QObject *parent)
+    : QObject(parent)
+    , m_program("nvidia-smi")
+    , m_process(nullptr)
+    , m_restartTimer(new QTimer(this))
+    , m_interval(1000)
+    , m_restartDelay(kRestartDelay)
+    , m_available(true)
+    , m_stopping(true)
+{
+    m_latest.vendor = "NVIDIA";
+    m_restartTimer->setSingleShot(true);
+    connect(m_restartTimer, &QTimer::timeout, this, &NvidiaSmiSession::launch);
+}
+
+NvidiaSmiSession::~NvidiaSmiSession()
+{
+    stop();
+}
+
+void NvidiaSmiSession::start(int intervalMs)
+{
+    m_interval = qMax(100, intervalMs);
+    m_stopping = false;
+    m_restartDelay = kRestartDelay;
+    launch();
+}
+
+void NvidiaSmiSession::stop()
+{
+    m_stopping = true;
+    m_restartTimer->stop();
+
+    if (m_process) {
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->waitForFinished(500);
+        delete m_process;
+        m_process = nullptr;
+    }
+    m_pending.clear();
+}
+
+bool NvidiaSmiSession::hasFreshSample() const
+{
+    return m_sampleAge.isValid() && m_sampleAge.elapsed() < 3 * m_interval;
+}
+
+void NvidiaSmiSession::launch()
+{
+    if (m_stopping || !m_available || m_process) {
+        return;
+    }
+
+    m_process = new QProcess(this);
+    m_process->setProcessChannelMode(QProcess::SeparateChannels);
+    m_process->setStandardErrorFile(QProcess::nullDevice());
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &NvidiaSmiSession::onReadyRead);
+    connect(m_process, &QProcess::errorOccurred, this, &NvidiaSmiSession::onErrorOccurred);
+    connect(m_process, qOverload<int, QProcess::ExitStatus>(&QProcess::finished),
+            this, &NvidiaSmiSession::onFinished);
+
+    m_pending.clear();
+    m_process->start(m_program, QStringList()
+        << kQueryFields
+        << "--format=csv,noheader,nounits"
+        << "-lms" << QString::number(m_interval));
+}
+
+void NvidiaSmiSession::onReadyRead()
+{
+    m_pending += m_process->readAllStandardOutput();
+
+    int newline;
+    while ((newline = m_pending.indexOf('\n')) >= 0) {
+        QByteArray line = m_pending.left(newline).trimmed();
+        m_pending.remove(0, newline + 1);
+        if (!line.isEmpty()) {
+            parseLine(line);
+        }
+    }
+
+    // A runaway line without newline would otherwise grow forever
+    if (m_pending.size() > 4096) {
+        m_pending.clear();
+    }
+}
+
+void NvidiaSmiSession::parseLine(const QByteArray &line)
+{
+    QList<QByteArray> values = line.split(',');
+    if (values.size() < 8) {
+        return;
+    }
+
+    bool ok = false;
+    int index = values[0].trimmed().toInt(&ok);
+    if (!ok || index != 0) {
+        return;
+    }
+
+    // Unsupported fields read "[N/A]" or "[Not Supported]"; toInt/toDouble
+    // fail on those and the value stays at -1
+    auto toInt = [](const QByteArray &field) {
+        bool valid = false;
+        int value = field.trimmed().toInt(&valid);
+        return valid ? value : -1;
+    };
+    auto toDouble = [](const QByteArray &field) {
+        bool valid = false;
+        double value = field.trimmed().toDouble(&valid);
+        return valid ? value : -1.0;
+    };
+
+    GPUInfo info;
+    info.vendor = "NVIDIA";
+    info.model = QString::fromUtf8(values[1].trimmed());
+    info.load = toInt(values[2]);
+    info.temperature = toInt(values[3]);
+    info.clockRate = toInt(values[4]);
+    info.power = toDouble(values[5]);
+    info.memoryUsed = toInt(values[6]);
+    info.memoryTotal = toInt(values[7]);
+
+    m_latest = info;
+    m_sampleAge.start();
+    m_restartDelay = kRestartDelay; // healthy again
+    emit sampleReady(info);
+}
+
+void NvidiaSmiSession::onErrorOccurred(QProcess::ProcessError error)
+{
+    if (error != QProcess::FailedToStart) {
+        return; // crashes are handled in onFinished()
+    }
+
+    // No nvidia-smi (or not executable): don't keep trying
+    DEBUG_LOG("nvidia-smi not available, NVIDIA GPU metrics disabled");
+    m_available = false;
+    m_process->deleteLater();
+    m_process = nullptr;
+}
+
+void NvidiaSmiSession::onFinished(int exitCode, QProcess::ExitStatus status)
+{
+    DEBUG_LOG("nvidia-smi exited, code", exitCode, "crashed", status == QProcess::CrashExit);
+
+    m_process->deleteLater();
+    m_process = nullptr;
+    scheduleRestart();
+}
+
+void NvidiaSmiSession::scheduleRestart()
+{
+    if (m_stopping || !m_available) {
+        return;
+    }
+
+    // The driver may be reloading; back off instead of hammering it
+    m_restartTimer->start(m_restartDelay);
+    m_restartDelay = qMin(m_restartDelay * 2, kMaxRestartDelay);
+}
@@ -0,0 +1,73 @@
+#ifndef NVIDIASMISESSION_H
+#define NVIDIASMISESSION_H
+
+#include <QObject>
+#include <QProcess>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include "sensors/sensorservice.h"
+
+class QTimer;
+
+// Long-lived `nvidia-smi --query-gpu=... -lms <interval>` child.
+//
+// Starting nvidia-smi costs tens of milliseconds of driver initialisation,
+// so instead of one launch per sample the tool is started once in looping
+// mode and its CSV lines are parsed as they arrive on the (non-blocking)
+// stdout pipe. latest() is then just a copy. If the binary is missing the
+// session stays idle; if the child dies it is restarted with a backoff.
+//
+// Lives on the sensor thread, like its owner.
+class NvidiaSmiSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kRestartDelay = 5000;       // after the child exits (ms)
+    static constexpr int kMaxRestartDelay = 60000;   // backoff cap (ms)
+
+    explicit NvidiaSmiSession(QObject *parent = nullptr);
+    ~NvidiaSmiSession();
+
+    // Program to run; defaults to "nvidia-smi" from PATH
+    void setProgram(const QString &program) { m_program = program; }
+
+    void start(int intervalMs);
+    void stop();
+
+    // Between start() and stop(), including restart backoffs
+    bool isRunning() const { return !m_stopping; }
+    // False once launching failed because the binary isn't there
+    bool isAvailable() const { return m_available; }
+    // A sample newer than three intervals exists
+    bool hasFreshSample() const;
+    // Most recent reading of GPU 0
+    GPUInfo latest() const { return m_latest; }
+
+signals:
+    void sampleReady(const GPUInfo &info);
+
+private slots:
+    void onReadyRead();
+    void onErrorOccurred(QProcess::ProcessError error);
+    void onFinished(int exitCode, QProcess::ExitStatus status);
+    void launch();
+
+private:
+    void parseLine(const QByteArray &line);
+    void scheduleRestart();
+
+    QString m_program;
+    QProcess *m_process;
+    QTimer *m_restartTimer;
+    QByteArray m_pending;   // partial line carried over between reads
+    int m_interval;
+    int m_restartDelay;
+    bool m_available;
+    bool m_stopping;
+
+    GPUInfo m_latest;
+    QElapsedTimer m_sampleAge;
+};
+
+#endif // NVIDIASMISESSION_H
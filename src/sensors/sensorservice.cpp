@@ -0,0 +1,845 @@
+#include "sensorservice.h"
+#include "sensors/nvidiasmisession.h"
+#include "utils/qtdebugutil.h"
+#include <QTimer>
+#include <QProcess>
+#include <QFile>
+#include <QTextStream>
+#include <QDir>
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QStorageInfo>
+#include <QMutexLocker>
+#include <QDebug>
+#include <algorithm>
+
+SensorService::SensorService(QObject *parent)
+    : QObject(parent)
+    , m_scope(Scope::Everything)
+    , m_temperatureTimer(nullptr)
+    , m_systemTimer(nullptr)
+    , m_storageTimer(nullptr)
+    , m_gpuVendor(GPUUnknown)
+    , m_gpuDetected(false)
+    , m_nvidiaSmi(nullptr)
+    , m_prevCPUIdle(0)
+    , m_prevCPUTotal(0)
+    , m_prevEnergyUJ(0)
+    , m_prevEnergyTimestamp(0)
+    , m_prevRx(0)
+    , m_prevTx(0)
+    , m_smoothedRx(0)
+    , m_smoothedTx(0)
+{
+    qRegisterMetaType<SensorSnapshot>("SensorSnapshot");
+}
+
+SensorService::~SensorService()
+{
+    stop();
+}
+
+void SensorService::start()
+{
+    if (m_systemTimer) {
+        return;
+    }
+
+    m_clock.start();
+
+    // Resolve the temperature inputs once; sampling then only preads them
+    m_hwmon.discover();
+    m_hwmonDiscovered.start();
+
+    m_temperatureTimer = new QTimer(this);
+    connect(m_temperatureTimer, &QTimer::timeout, this, &SensorService::sampleTemperature);
+
+    m_systemTimer = new QTimer(this);
+    connect(m_systemTimer, &QTimer::timeout, this, &SensorService::sampleSystem);
+
+    m_storageTimer = new QTimer(this);
+    connect(m_storageTimer, &QTimer::timeout, this, &SensorService::sampleStorage);
+
+    // First sample right away so consumers never start from an empty snapshot
+    if (m_scope != Scope::Nothing) {
+        sampleTemperature();
+        if (m_scope == Scope::Everything) {
+            sampleStorage();
+        }
+        sampleSystem();
+    }
+    applyScope();
+
+    qDebug() << "Sensor service started";
+}
+
+void SensorService::setScope(Scope scope)
+{
+    if (scope == m_scope) {
+        return;
+    }
+
+    const Scope previous = m_scope;
+    m_scope = scope;
+    if (!m_systemTimer) {
+        return;
+    }
+
+    applyScope();
+
+    // A page that was just shown shouldn't wait a full interval for data
+    if (previous == Scope::Nothing && scope != Scope::Nothing) {
+        sampleTemperature();
+    }
+    if (previous != Scope::Everything && scope == Scope::Everything) {
+        sampleStorage();
+    }
+    if (previous == Scope::Nothing || scope == Scope::Everything) {
+        sampleSystem();
+    }
+    DEBUG_LOG("Sensor service: scope", static_cast<int>(scope));
+}
+
+void SensorService::applyScope()
+{
+    if (m_scope == Scope::Nothing) {
+        m_temperatureTimer->stop();
+        m_systemTimer->stop();
+        if (m_nvidiaSmi) {
+            m_nvidiaSmi->stop();
+        }
+    } else {
+        if (!m_temperatureTimer->isActive()) {
+            m_temperatureTimer->start(kTemperatureInterval);
+        }
+        if (!m_systemTimer->isActive()) {
+            m_systemTimer->start(kSystemInterval);
+        }
+        if (m_nvidiaSmi && !m_nvidiaSmi->isRunning()) {
+            m_nvidiaSmi->start(kSystemInterval);
+        }
+    }
+
+    if (m_scope == Scope::Everything) {
+        if (!m_storageTimer->isActive()) {
+            m_storageTimer->start(kStorageInterval);
+        }
+    } else {
+        m_storageTimer->stop();
+    }
+}
+
+void SensorService::stop()
+{
+    if (!m_systemTimer) {
+        return;
+    }
+
+    m_temperatureTimer->stop();
+    m_systemTimer->stop();
+    m_storageTimer->stop();
+
+    if (m_nvidiaSmi) {
+        m_nvidiaSmi->stop();
+    }
+}
+
+SensorSnapshot SensorService::latestSnapshot() const
+{
+    QMutexLocker locker(&m_snapshotMutex);
+    return m_snapshot;
+}
+
+void SensorService::sampleTemperature()
+{
+    // A chip went away (module reload, GPU unplug); look again, but not
+    // on every tick while it stays gone
+    if (m_hwmon.isStale() && m_hwmonDiscovered.elapsed() >= kHwmonRediscoverInterval) {
+        m_hwmon.discover();
+        m_hwmonDiscovered.start();
+    }
+
+    int load = readCPULoad();
+    int temperature = readCPUTemperature();
+    double nvmeTemp = m_hwmon.readCelsius(HwmonSensors::NVMe);
+    double liquidTemp = m_hwmon.readCelsius(HwmonSensors::Liquid);
+
+    QMutexLocker locker(&m_snapshotMutex);
+    ++m_snapshot.sequence;
+    m_snapshot.timestamp = m_clock.elapsed();
+    if (load >= 0) {
+        m_snapshot.cpuLoad = load;
+    }
+    m_snapshot.cpuTemperature = temperature;
+    m_snapshot.nvmeTemperature = nvmeTemp > 0 ? static_cast<int>(nvmeTemp) : -1;
+    m_snapshot.liquidTemperature = liquidTemp > 0 ? static_cast<int>(liquidTemp) : -1;
+}
+
+const QString &SensorService::sensorsOutput()
+{
+    // Only the fallbacks need lm-sensors; run it at most once per
+    // temperature interval however many of them ask
+    if (!m_sensorsOutputAge.isValid() || m_sensorsOutputAge.elapsed() >= kTemperatureInterval) {
+        m_sensorsOutput = runTool("sensors", QStringList() << "-A");
+        m_sensorsOutputAge.start();
+    }
+    return m_sensorsOutput;
+}
+
+void SensorService::sampleSystem()
+{
+    SensorSnapshot sample = latestSnapshot();
+
+    // The GPU temperature is a fan curve source; the rest is only shown,
+    // and load needs radeontop/intel_gpu_top launched every sample
+    if (m_scope == Scope::Everything) {
+        sample.gpu = readGPU();
+        sample.cpuClock = readCPUClock();
+        readCPUPower(sample);
+        readCPUVoltage(sample);
+        readRAM(sample);
+        readNetwork(sample);
+    } else {
+        GPUInfo gpu;
+        gpu.vendor = sample.gpu.vendor;
+        gpu.model = sample.gpu.model;
+        gpu.temperature = readGPUTemperature();
+        sample.gpu = gpu;
+    }
+
+    {
+        QMutexLocker locker(&m_snapshotMutex);
+        // The temperature sampler may have run in between; keep its values
+        sample.sequence = m_snapshot.sequence + 1;
+        sample.timestamp = m_clock.elapsed();
+        sample.cpuLoad = m_snapshot.cpuLoad;
+        sample.cpuTemperature = m_snapshot.cpuTemperature;
+        sample.nvmeTemperature = m_snapshot.nvmeTemperature;
+        sample.liquidTemperature = m_snapshot.liquidTemperature;
+        sample.storage = m_snapshot.storage;
+        m_snapshot = sample;
+    }
+
+    emit snapshotReady(sample);
+}
+
+void SensorService::sampleStorage()
+{
+    QStringList storage;
+
+    for (const QStorageInfo &volume : QStorageInfo::mountedVolumes()) {
+        if (!volume.isValid() || !volume.isReady() || !volume.device().startsWith("/dev/")) {
+            continue;
+        }
+
+        QString mount = volume.rootPath();
+        if (mount != "/" && !mount.startsWith("/home")) {
+            continue;
+        }
+
+        qint64 total = volume.bytesTotal();
+        qint64 used = total - volume.bytesFree();
+        if (total <= 0) {
+            continue;
+        }
+
+        auto humanSize = [](qint64 bytes) {
+            const char *units[] = { "B", "K", "M", "G", "T", "P" };
+            double value = bytes;
+            int unit = 0;
+            while (value >= 1024.0 && unit < 5) {
+                value /= 1024.0;
+                ++unit;
+            }
+            return QString::number(value, 'f', value < 10.0 && unit > 0 ? 1 : 0) + units[unit];
+        };
+
+        int percent = static_cast<int>((used * 100 + total - 1) / total);
+        storage << mount + " " + humanSize(used) + "/" + humanSize(total) + " " + QString::number(percent) + "%";
+    }
+
+    QMutexLocker locker(&m_snapshotMutex);
+    m_snapshot.storage = storage;
+}
+
+QString SensorService::runTool(const QString &program, const QStringList &arguments, int timeoutMs)
+{
+    QProcess process;
+    process.start(program, arguments);
+    if (!process.waitForStarted(timeoutMs)) {
+        return QString();
+    }
+    if (!process.waitForFinished(timeoutMs)) {
+        process.kill();
+        process.waitForFinished(100);
+        return QString();
+    }
+    if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
+        return QString();
+    }
+    return QString::fromLocal8Bit(process.readAllStandardOutput());
+}
+
+int SensorService::readCPULoad()
+{
+    // CPU Load from /proc/stat (real-time CPU usage)
+    QFile statFile("/proc/stat");
+    if (!statFile.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+
+    QTextStream stream(&statFile);
+    QString line = stream.readLine();
+    if (!line.startsWith("cpu ")) {
+        return -1;
+    }
+
+    QStringList parts = line.split(' ', Qt::SkipEmptyParts);
+    if (parts.size() < 8) {
+        return -1;
+    }
+
+    // Parse CPU times: user, nice, system, idle, iowait, irq, softirq, steal
+    qint64 user = parts[1].toLongLong();
+    qint64 nice = parts[2].toLongLong();
+    qint64 system = parts[3].toLongLong();
+    qint64 idle = parts[4].toLongLong();
+    qint64 iowait = parts[5].toLongLong();
+    qint64 irq = parts[6].toLongLong();
+    qint64 softirq = parts[7].toLongLong();
+    qint64 steal = parts.size() > 8 ? parts[8].toLongLong() : 0;
+
+    qint64 totalIdle = idle + iowait;
+    qint64 total = user + nice + system + totalIdle + irq + softirq + steal;
+
+    int load = -1;
+    if (m_prevCPUTotal > 0) {
+        qint64 totalDiff = total - m_prevCPUTotal;
+        qint64 idleDiff = totalIdle - m_prevCPUIdle;
+        if (totalDiff > 0) {
+            load = static_cast<int>(((totalDiff - idleDiff) * 100) / totalDiff);
+            load = std::max(0, std::min(100, load)); // Clamp between 0-100
+        }
+    }
+
+    m_prevCPUIdle = totalIdle;
+    m_prevCPUTotal = total;
+    return load;
+}
+
+int SensorService::readCPUTemperature()
+{
+    // Resolved hwmon input (Tctl/Tdie/package temperature): one pread
+    double hwmonTemp = m_hwmon.readCelsius(HwmonSensors::CPU);
+    if (hwmonTemp > 0 && hwmonTemp < 200) {
+        return static_cast<int>(hwmonTemp);
+    }
+
+    int maxTemp = 0;
+
+    // No usable hwmon chip: fall back to parsing lm-sensors output
+    const QString &output = sensorsOutput();
+    if (!output.isEmpty()) {
+        static const QRegularExpression tempRegex("Tctl:\\s*\\+?([0-9.]+)°C");
+        QRegularExpressionMatch match = tempRegex.match(output);
+        if (match.hasMatch()) {
+            maxTemp = static_cast<int>(match.captured(1).toDouble());
+        }
+    }
+
+    // Fallback: try thermal zones if sensors didn't work either
+    if (maxTemp == 0) {
+        QDir thermalDir("/sys/class/thermal");
+        QStringList thermalZones = thermalDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const QString &zone : thermalZones) {
+            if (!zone.startsWith("thermal_zone")) {
+                continue;
+            }
+            QFile tempFile("/sys/class/thermal/" + zone + "/temp");
+            if (tempFile.open(QIODevice::ReadOnly)) {
+                int temp = QTextStream(&tempFile).readLine().toInt() / 1000; // Convert millidegrees to degrees
+                if (temp > maxTemp) maxTemp = temp;
+            }
+        }
+    }
+
+    return maxTemp > 0 ? maxTemp : -1;
+}
+
+int SensorService::readCPUClock()
+{
+    // CPU Clock from /proc/cpuinfo
+    QFile cpuFile("/proc/cpuinfo");
+    if (!cpuFile.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+
+    QTextStream stream(&cpuFile);
+    QString line;
+    double maxClock = 0.0;
+    while (stream.readLineInto(&line)) {
+        if (line.startsWith("cpu MHz")) {
+            QStringList parts = line.split(':');
+            if (parts.size() == 2) {
+                double mhz = parts[1].trimmed().toDouble();
+                if (mhz > maxClock) maxClock = mhz;
+            }
+        }
+    }
+
+    return maxClock > 0 ? static_cast<int>(maxClock) : -1;
+}
+
+void SensorService::readCPUPower(SensorSnapshot &snapshot)
+{
+    snapshot.cpuPower = -1.0;
+    snapshot.cpuPowerEstimated = false;
+
+    // Try to get CPU power from RAPL (Running Average Power Limit)
+    static const QStringList raplPaths = {
+        "/sys/class/powercap/intel-rapl/intel-rapl:0/energy_uj",
+        "/sys/class/powercap/intel-rapl/intel-rapl:1/energy_uj",
+        "/sys/class/powercap/intel-rapl/intel-rapl:0:0/energy_uj"
+    };
+
+    for (const QString &path : raplPaths) {
+        QFile raplFile(path);
+        if (!raplFile.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+
+        QString energyStr = QTextStream(&raplFile).readLine();
+        if (energyStr.isEmpty()) {
+            break;
+        }
+
+        qint64 currentEnergyUJ = energyStr.toLongLong();
+        qint64 currentTimestamp = QDateTime::currentMSecsSinceEpoch();
+
+        if (m_prevEnergyTimestamp > 0 && m_prevEnergyUJ > 0) {
+            qint64 timeDiff = currentTimestamp - m_prevEnergyTimestamp; // milliseconds
+            qint64 energyDiff = currentEnergyUJ - m_prevEnergyUJ; // microjoules
+
+            if (timeDiff > 0 && energyDiff >= 0) {
+                // Convert to watts: (microjoules / 1000000) / (milliseconds / 1000)
+                double powerW = (energyDiff / 1000000.0) / (timeDiff / 1000.0);
+                // Clamp to reasonable range (0-500W)
+                if (powerW >= 0 && powerW <= 500) {
+                    snapshot.cpuPower = powerW;
+                }
+            }
+        }
+
+        m_prevEnergyUJ = currentEnergyUJ;
+        m_prevEnergyTimestamp = currentTimestamp;
+        return;
+    }
+
+    // Look for power readings in sensors output
+    const QString &output = sensorsOutput();
+    if (!output.isEmpty()) {
+        static const QRegularExpression powerRegex("P\\w*:\\s*([0-9.]+)\\s*W");
+        QRegularExpressionMatch match = powerRegex.match(output);
+        if (match.hasMatch()) {
+            double powerW = match.captured(1).toDouble();
+            if (powerW > 0 && powerW <= 500) {
+                snapshot.cpuPower = powerW;
+                return;
+            }
+        }
+    }
+
+    // Very rough estimation from the clock - not accurate but better than N/A
+    if (snapshot.cpuClock > 0) {
+        snapshot.cpuPower = (snapshot.cpuClock / 1000.0) * 0.5; // Rough W/GHz ratio
+        snapshot.cpuPowerEstimated = true;
+    }
+}
+
+void SensorService::readCPUVoltage(SensorSnapshot &snapshot)
+{
+    snapshot.cpuVoltage = -1.0;
+    snapshot.cpuVoltageEstimated = false;
+
+    // Try from /sys/class/hwmon (common on modern systems)
+    QDir hwmonDir("/sys/class/hwmon");
+    QStringList hwmonDirs = hwmonDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString &hwmon : hwmonDirs) {
+        QFile nameFile("/sys/class/hwmon/" + hwmon + "/name");
+        if (!nameFile.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        QString name = QTextStream(&nameFile).readLine().trimmed();
+        nameFile.close();
+
+        if (!(name.contains("coretemp") || name.contains("k10temp") || name.contains("zenpower") ||
+              name.contains("asus") || name.contains("acpi"))) {
+            continue;
+        }
+
+        // Look for voltage input files
+        QDir hwmonSubDir("/sys/class/hwmon/" + hwmon);
+        QStringList files = hwmonSubDir.entryList(QDir::Files);
+        for (const QString &file : files) {
+            if (!file.startsWith("in") || !file.endsWith("_input")) {
+                continue;
+            }
+            QFile voltageFile("/sys/class/hwmon/" + hwmon + "/" + file);
+            if (voltageFile.open(QIODevice::ReadOnly)) {
+                QString voltageStr = QTextStream(&voltageFile).readLine();
+                double voltage = voltageStr.toDouble() / 1000.0; // Convert mV to V
+                if (voltage > 0.5 && voltage < 2.0) { // Reasonable CPU voltage range
+                    snapshot.cpuVoltage = voltage;
+                    return;
+                }
+            }
+        }
+    }
+
+    // Look for voltage readings in sensors output
+    const QString &output = sensorsOutput();
+    if (!output.isEmpty()) {
+        static const QRegularExpression voltageRegex("V\\w*:\\s*([0-9.]+)\\s*V");
+        QRegularExpressionMatch match = voltageRegex.match(output);
+        if (match.hasMatch()) {
+            double voltage = match.captured(1).toDouble();
+            if (voltage > 0.5 && voltage < 2.0) {
+                snapshot.cpuVoltage = voltage;
+                return;
+            }
+        }
+    }
+
+    // Try to get voltage from /proc/cpuinfo, then a guess from the CPU model
+    QFile cpuFile("/proc/cpuinfo");
+    if (!cpuFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    static const QRegularExpression cpuinfoVoltageRegex("([0-9.]+)\\s*V");
+    QTextStream stream(&cpuFile);
+    QString line;
+    QString model;
+    while (stream.readLineInto(&line)) {
+        if (model.isEmpty() && line.startsWith("model name")) {
+            model = line.toLower();
+        }
+        if (line.contains("voltage", Qt::CaseInsensitive) || line.contains("vid", Qt::CaseInsensitive)) {
+            QRegularExpressionMatch match = cpuinfoVoltageRegex.match(line);
+            if (match.hasMatch()) {
+                double voltage = match.captured(1).toDouble();
+                if (voltage > 0.5 && voltage < 2.0) {
+                    snapshot.cpuVoltage = voltage;
+                    return;
+                }
+            }
+        }
+    }
+
+    // Very rough voltage estimation based on CPU generation
+    if (model.contains("ryzen") || model.contains("zen")) {
+        snapshot.cpuVoltage = 1.1; // Typical for modern AMD
+        snapshot.cpuVoltageEstimated = true;
+    } else if (model.contains("intel")) {
+        snapshot.cpuVoltage = 1.2; // Typical for modern Intel
+        snapshot.cpuVoltageEstimated = true;
+    }
+}
+
+void SensorService::readRAM(SensorSnapshot &snapshot)
+{
+    snapshot.ramUsedKB = -1;
+    snapshot.ramTotalKB = -1;
+
+    // RAM usage from /proc/meminfo
+    QFile memFile("/proc/meminfo");
+    if (!memFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    static const QRegularExpression whitespace("\\s+");
+    QTextStream stream(&memFile);
+    QString line;
+    qint64 totalMem = 0, availableMem = 0;
+
+    while (stream.readLineInto(&line)) {
+        if (line.startsWith("MemTotal:")) {
+            totalMem = line.split(whitespace)[1].toLongLong();
+        } else if (line.startsWith("MemAvailable:")) {
+            availableMem = line.split(whitespace)[1].toLongLong();
+        }
+    }
+
+    if (totalMem > 0) {
+        // Use MemAvailable for more accurate used memory calculation
+        snapshot.ramUsedKB = totalMem - availableMem;
+        snapshot.ramTotalKB = totalMem;
+    }
+}
+
+void SensorService::readNetwork(SensorSnapshot &snapshot)
+{
+    snapshot.networkAvailable = false;
+    snapshot.networkRxRate = -1;
+    snapshot.networkTxRate = -1;
+
+    // Network stats from /proc/net/dev
+    QFile netFile("/proc/net/dev");
+    if (!netFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    static const QRegularExpression whitespace("\\s+");
+    QTextStream stream(&netFile);
+    QString line;
+    qint64 totalRx = 0, totalTx = 0;
+
+    // Skip header lines
+    stream.readLine();
+    stream.readLine();
+
+    while (stream.readLineInto(&line)) {
+        // Interface name is before the first colon
+        int colonPos = line.indexOf(':');
+        if (colonPos <= 0) {
+            continue;
+        }
+
+        QString interface = line.left(colonPos).trimmed();
+        QStringList parts = line.mid(colonPos + 1).trimmed().split(whitespace);
+        if (parts.size() < 9) {
+            continue;
+        }
+
+        qint64 rx = parts[0].toLongLong();  // First number after colon is RX bytes
+        qint64 tx = parts[8].toLongLong();  // 9th number after colon is TX bytes
+
+        // Skip loopback and virtual interfaces, but include any interface with traffic
+        bool isVirtualInterface = interface.startsWith("lo") ||
+                                  interface.startsWith("docker") ||
+                                  interface.startsWith("veth") ||
+                                  interface.startsWith("br-") ||
+                                  interface.startsWith("virbr") ||
+                                  interface.startsWith("tun") ||
+                                  interface.startsWith("tap") ||
+                                  interface.startsWith("sit") ||
+                                  interface.startsWith("ppp") ||
+                                  interface.isEmpty();
+
+        if (!isVirtualInterface || (rx > 1000 || tx > 1000)) {
+            totalRx += rx;
+            totalTx += tx;
+        }
+    }
+
+    snapshot.networkAvailable = true;
+
+    if (m_networkTimer.isValid()) {
+        qint64 elapsedMs = m_networkTimer.elapsed();
+        if (elapsedMs > 100 && elapsedMs < 10000) {
+            qint64 rxSpeed = ((totalRx - m_prevRx) * 1000) / elapsedMs;
+            qint64 txSpeed = ((totalTx - m_prevTx) * 1000) / elapsedMs;
+
+            // Light exponential moving average with factor 0.7 for new values
+            if (m_smoothedRx == 0) {
+                m_smoothedRx = rxSpeed;
+                m_smoothedTx = txSpeed;
+            } else {
+                m_smoothedRx = (m_smoothedRx * 3 + rxSpeed * 7) / 10;
+                m_smoothedTx = (m_smoothedTx * 3 + txSpeed * 7) / 10;
+            }
+
+            // Handle negative speeds (counter wraparound)
+            snapshot.networkRxRate = std::max<qint64>(0, m_smoothedRx);
+            snapshot.networkTxRate = std::max<qint64>(0, m_smoothedTx);
+        }
+    }
+
+    m_prevRx = totalRx;
+    m_prevTx = totalTx;
+    m_networkTimer.start();
+}
+
+SensorService::GPUVendor SensorService::detectGPUVendor()
+{
+    // Scan lspci for the first VGA compatible controller
+    QString output = runTool("lspci", QStringList() << "-n");
+    QStringList lines = output.split('\n', Qt::SkipEmptyParts);
+
+    static const QRegularExpression pciRegex("(10de|1002|1022|8086):([0-9a-fA-F]+)");
+    for (const QString &line : lines) {
+        if (!line.contains("0300")) {
+            continue;
+        }
+        // Parse line like: "41:00.0 0300: 10de:2684 (rev a1)"
+        QRegularExpressionMatch match = pciRegex.match(line);
+        if (!match.hasMatch()) {
+            continue;
+        }
+
+        QString vendorId = match.captured(1);
+        if (vendorId == "10de") {
+            return GPUNvidia;
+        } else if (vendorId == "1002" || vendorId == "1022") {
+            return GPUAmd;
+        } else if (vendorId == "8086") {
+            return GPUIntel;
+        }
+    }
+
+    return GPUUnknown;
+}
+
+void SensorService::ensureGPUDetected()
+{
+    // The installed GPU doesn't change while we run
+    if (!m_gpuDetected) {
+        m_gpuVendor = detectGPUVendor();
+        m_gpuDetected = true;
+        DEBUG_LOG("Sensor service: GPU vendor", m_gpuVendor);
+
+        if (m_gpuVendor == GPUNvidia) {
+            m_nvidiaSmi = new NvidiaSmiSession(this);
+            m_nvidiaSmi->start(kSystemInterval);
+        }
+    }
+}
+
+GPUInfo SensorService::readGPU()
+{
+    ensureGPUDetected();
+
+    switch (m_gpuVendor) {
+    case GPUNvidia:
+        return readNVIDIAGPU();
+    case GPUAmd:
+        return readAMDGPU();
+    case GPUIntel:
+        return readIntelGPU();
+    default:
+        return readGenericGPU();
+    }
+}
+
+int SensorService::readGPUTemperature()
+{
+    ensureGPUDetected();
+
+    // The proprietary NVIDIA driver has no hwmon node, but the running
+    // nvidia-smi stream already carries the temperature
+    if (m_gpuVendor == GPUNvidia && m_nvidiaSmi && m_nvidiaSmi->hasFreshSample()) {
+        return m_nvidiaSmi->latest().temperature;
+    }
+    return hwmonGPUTemperature();
+}
+
+GPUInfo SensorService::readNVIDIAGPU()
+{
+    GPUInfo info;
+    info.vendor = "NVIDIA";
+
+    // Streamed by the long-lived nvidia-smi child; no launch per sample
+    if (m_nvidiaSmi && m_nvidiaSmi->hasFreshSample()) {
+        return m_nvidiaSmi->latest();
+    }
+
+    // nouveau (open-source NVIDIA driver) only exposes the temperature
+    QString driver = boundDrmDriver("nouveau");
+    if (!driver.isEmpty()) {
+        info.model = "NVIDIA (nouveau)";
+        info.temperature = hwmonGPUTemperature();
+    }
+    return info;
+}
+
+GPUInfo SensorService::readAMDGPU()
+{
+    GPUInfo info;
+    info.vendor = "AMD";
+
+    QString output = runTool("radeontop", QStringList() << "-d" << "1" << "-l" << "1");
+    static const QRegularExpression loadRegex("gpu\\s+(\\d+)%");
+    QRegularExpressionMatch match = loadRegex.match(output);
+    if (match.hasMatch()) {
+        info.load = match.captured(1).toInt();
+    }
+
+    info.temperature = hwmonGPUTemperature();
+
+    QString driver = boundDrmDriver("amdgpu");
+    if (!driver.isEmpty()) {
+        info.model = "AMD (amdgpu)";
+    }
+    return info;
+}
+
+GPUInfo SensorService::readIntelGPU()
+{
+    GPUInfo info;
+    info.vendor = "Intel";
+
+    QString output = runTool("intel_gpu_top", QStringList() << "-s" << "1");
+    static const QRegularExpression loadRegex("GPU\\s+(\\d+)%");
+    QRegularExpressionMatch match = loadRegex.match(output);
+    if (match.hasMatch()) {
+        info.load = match.captured(1).toInt();
+    }
+
+    info.temperature = hwmonGPUTemperature();
+
+    QString driver = boundDrmDriver("i915");
+    if (!driver.isEmpty()) {
+        info.model = "Intel (i915)";
+    }
+    return info;
+}
+
+GPUInfo SensorService::readGenericGPU()
+{
+    GPUInfo info;
+    info.vendor = "Unknown";
+    info.model = "Generic GPU";
+
+    QString driver = boundDrmDriver(QString());
+    if (!driver.isEmpty()) {
+        info.model = "GPU (" + driver + ")";
+    }
+    return info;
+}
+
+int SensorService::hwmonGPUTemperature()
+{
+    double temp = m_hwmon.readCelsius(HwmonSensors::GPU);
+    return temp > 0 ? static_cast<int>(temp) : -1;
+}
+
+QString SensorService::boundDrmDriver(const QString &driver)
+{
+    // Returns the DRM driver bound to the first card that matches `driver`
+    // (any driver if empty), or an empty string
+    QDir drmDir("/sys/class/drm");
+    QStringList cards = drmDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+
+    for (const QString &card : cards) {
+        if (!card.startsWith("card") || card.contains("-")) {
+            continue;
+        }
+        QFile ueventFile("/sys/class/drm/" + card + "/device/uevent");
+        if (!ueventFile.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        QTextStream stream(&ueventFile);
+        QString line;
+        while (stream.readLineInto(&line)) {
+            if (!line.startsWith("DRIVER=")) {
+                continue;
+            }
+            QString bound = line.mid(7);
+            if (driver.isEmpty() || bound == driver) {
+                return bound;
+            }
+        }
+    }
+
+    return QString();
+}
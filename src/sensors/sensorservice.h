@@ -0,0 +1,169 @@
+#ifndef SENSORSERVICE_H
+#define SENSORSERVICE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QMetaType>
+#include <QMutex>
+#include <QElapsedTimer>
+#include "sensors/hwmonsensors.h"
+
+class QTimer;
+class NvidiaSmiSession;
+
+struct GPUInfo {
+    int load = -1;        // GPU utilization percentage
+    int temperature = -1; // GPU temperature in Celsius
+    int clockRate = -1;   // GPU clock rate in MHz
+    double power = -1.0;  // GPU power consumption in watts
+    double voltage = -1.0; // GPU voltage in volts
+    int memoryUsed = -1;  // GPU memory used in MB
+    int memoryTotal = -1; // GPU total memory in MB
+    QString vendor;       // GPU vendor (NVIDIA, AMD, Intel, etc.)
+    QString model;        // GPU model name
+};
+
+// One sample of every system sensor the UI and the fan loop care about.
+// Values that could not be read are negative.
+struct SensorSnapshot
+{
+    quint64 sequence = 0;            // 0 until the first sample
+    qint64 timestamp = 0;            // ms since the service started
+
+    int cpuLoad = -1;                // percent
+    int cpuTemperature = -1;         // °C
+    int cpuClock = -1;               // MHz, fastest core
+    double cpuPower = -1.0;          // W
+    bool cpuPowerEstimated = false;  // derived from the clock, not measured
+    double cpuVoltage = -1.0;        // V
+    bool cpuVoltageEstimated = false; // guessed from the CPU model
+
+    GPUInfo gpu;
+
+    int nvmeTemperature = -1;        // °C, composite
+    int liquidTemperature = -1;      // °C, AIO/loop coolant
+
+    qint64 ramUsedKB = -1;
+    qint64 ramTotalKB = -1;
+
+    bool networkAvailable = false;
+    qint64 networkRxRate = -1;       // bytes/s, smoothed
+    qint64 networkTxRate = -1;
+
+    QStringList storage;             // "<mount> <used>/<size> <percent>"
+};
+
+Q_DECLARE_METATYPE(SensorSnapshot)
+
+// Samples CPU, GPU, memory, network and storage sensors on its own thread
+// (see MainWindow) so no page ever waits on an external tool. Every source
+// is read once per interval no matter how many consumers there are:
+// the pages subscribe to snapshotReady(), the fan loop polls
+// latestSnapshot() at its own pace.
+class SensorService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kTemperatureInterval = 500;  // CPU temperature/load (ms)
+    static constexpr int kSystemInterval = 1000;      // everything else (ms)
+    static constexpr int kStorageInterval = 10000;    // mounted volumes (ms)
+    static constexpr int kHwmonRediscoverInterval = 10000; // after a failed read (ms)
+
+    // Everything the pages show, only the temperatures a fan curve can
+    // follow (no storage, network, RAM, clock, power or GPU load reads), or
+    // nothing while no one needs a reading
+    enum class Scope { Everything, Temperatures, Nothing };
+
+    explicit SensorService(QObject *parent = nullptr);
+    ~SensorService();
+
+    // Before start(), or on the service thread; widening it samples the
+    // newly included sources right away
+    void setScope(Scope scope);
+    Scope scope() const { return m_scope; }
+
+    // Thread-safe copy of the most recent sample
+    SensorSnapshot latestSnapshot() const;
+
+public slots:
+    // Must run on the service thread; creates the timers and takes a first sample
+    void start();
+    void stop();
+
+signals:
+    // Emitted after every full system sample
+    void snapshotReady(const SensorSnapshot &snapshot);
+
+private slots:
+    void sampleTemperature();
+    void sampleSystem();
+    void sampleStorage();
+
+private:
+    enum GPUVendor { GPUUnknown, GPUNvidia, GPUAmd, GPUIntel };
+
+    // Runs a tool on this thread and returns its stdout, or an empty string
+    static QString runTool(const QString &program, const QStringList &arguments, int timeoutMs = 1000);
+
+    // `sensors -A` output, refreshed at most once per temperature interval
+    const QString &sensorsOutput();
+
+    // Starts and stops the timers (and nvidia-smi) to match m_scope
+    void applyScope();
+
+    int readCPULoad();
+    int readCPUTemperature();
+    int readCPUClock();
+    void readCPUPower(SensorSnapshot &snapshot);
+    void readCPUVoltage(SensorSnapshot &snapshot);
+    void readRAM(SensorSnapshot &snapshot);
+    void readNetwork(SensorSnapshot &snapshot);
+
+    GPUVendor detectGPUVendor();
+    void ensureGPUDetected();
+    GPUInfo readGPU();
+    int readGPUTemperature();
+    GPUInfo readNVIDIAGPU();
+    GPUInfo readAMDGPU();
+    GPUInfo readIntelGPU();
+    GPUInfo readGenericGPU();
+    int hwmonGPUTemperature();
+    static QString boundDrmDriver(const QString &driver);
+
+    Scope m_scope;
+    QTimer *m_temperatureTimer;
+    QTimer *m_systemTimer;
+    QTimer *m_storageTimer;
+    QElapsedTimer m_clock;
+
+    // Cached hwmon temperature inputs
+    HwmonSensors m_hwmon;
+    QElapsedTimer m_hwmonDiscovered;
+
+    // Last `sensors -A` output, only used when hwmon/RAPL have no answer
+    QString m_sensorsOutput;
+    QElapsedTimer m_sensorsOutputAge;
+
+    // GPU vendor from lspci, detected once
+    GPUVendor m_gpuVendor;
+    bool m_gpuDetected;
+    NvidiaSmiSession *m_nvidiaSmi; // only on NVIDIA systems
+
+    // Deltas between samples
+    qint64 m_prevCPUIdle;
+    qint64 m_prevCPUTotal;
+    qint64 m_prevEnergyUJ;
+    qint64 m_prevEnergyTimestamp;
+    qint64 m_prevRx;
+    qint64 m_prevTx;
+    qint64 m_smoothedRx;
+    qint64 m_smoothedTx;
+    QElapsedTimer m_networkTimer;
+
+    mutable QMutex m_snapshotMutex;
+    SensorSnapshot m_snapshot;
+};
+
+#endif // SENSORSERVICE_H
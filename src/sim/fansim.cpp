@@ -0,0 +1,251 @@
+// fansim - offline fan control simulator
+//
+// Runs FanControlLoop, the same per-tick code FanControlEngine runs on the
+// live system, against a thermal model or a recorded temperature trace, and
+// reports how the controller behaved. No hub, kernel driver or GUI needed.
+//
+//   fansim --scenario step --strategy pid
+//   fansim --trace load.csv --trace-kind power --series out.csv
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "control/fancontrolloop.h"
+#include "control/sensorring.h"
+#include "sim/loadtrace.h"
+#include "sim/thermalmodel.h"
+
+// Sensor refresh of the live engine (FanControlEngine::kTemperatureInterval)
+static constexpr double kSensorInterval = 0.5;
+// Band the temperature has to stay in to count as settled (°C)
+static constexpr double kSettleBand = 1.0;
+// Unmeasured run-in before t = 0 (s)
+static constexpr double kWarmup = 30.0;
+
+struct Step
+{
+    double time;
+    double temperature;
+    double filtered;
+    int rpm;
+    double fanRPM;
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("fansim");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Offline fan control simulator for LL-Connect 3");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "scenario", "Synthetic load: idle, step, ramp or burst.", "name", "step" },
+        { "trace", "CSV trace (seconds,value) instead of a synthetic load.", "file" },
+        { "trace-kind", "What the trace holds: power (W) or temperature (°C).", "kind", "power" },
+        { "duration", "Simulated seconds (defaults to the trace length or 120).", "s" },
+        { "tick", "Control tick in ms.", "ms", "50" },
+        { "strategy", "heuristic, pid or mpc.", "name", "heuristic" },
+        { "profile", "Built-in curve: Quiet, Standard, High Speed, Full Speed.", "name", "Quiet" },
+        { "interpolation", "Curve interpolation: linear, cubic or step.", "mode", "linear" },
+        { "ambient", "Ambient temperature in °C.", "c", "25" },
+        { "hysteresis", "Smallest duty drop that is written (percent).", "percent", "2" },
+        { "dwell", "Seconds after a write before a duty drop is written.", "s", "2" },
+        { "series", "Write the per-tick time series to this CSV file.", "file" },
+    });
+    parser.process(app);
+
+    QTextStream err(stderr);
+
+    // Load
+    LoadTrace trace;
+    double duration = parser.value("duration").toDouble();
+    if (parser.isSet("trace")) {
+        LoadTrace::Kind kind = parser.value("trace-kind") == "temperature" ? LoadTrace::Kind::Temperature
+                                                                          : LoadTrace::Kind::Power;
+        QString error;
+        trace = LoadTrace::fromCsv(parser.value("trace"), kind, &error);
+        if (trace.isEmpty()) {
+            err << "fansim: " << error << Qt::endl;
+            return 1;
+        }
+        if (duration <= 0.0) {
+            duration = trace.duration();
+        }
+    } else {
+        if (duration <= 0.0) {
+            duration = 120.0;
+        }
+        trace = LoadTrace::synthetic(parser.value("scenario"), duration);
+        if (trace.isEmpty()) {
+            err << "fansim: unknown scenario " << parser.value("scenario") << Qt::endl;
+            return 1;
+        }
+    }
+
+    const double dt = std::max(1, parser.value("tick").toInt()) / 1000.0;
+    const int ticks = std::max(1, int(std::ceil(duration / dt)));
+
+    // Controller: every port on the same curve and strategy
+    FanControlLoop loop;
+    FanCurve curve(FanCurve::defaultPointsForProfile(parser.value("profile")),
+                   FanCurve::interpolationFromName(parser.value("interpolation")));
+    FanControlStrategy::Kind strategy = FanControlStrategy::kindFromName(parser.value("strategy"));
+    for (int port = 1; port <= FanControlLoop::kPortCount; ++port) {
+        loop.setCurve(port, curve);
+        loop.setStrategy(port, strategy);
+    }
+    DutyOutputStage::Parameters output;
+    output.hysteresis = parser.value("hysteresis").toInt();
+    output.minDwell = parser.value("dwell").toDouble();
+    loop.setOutputParameters(output);
+    SensorRing history(256);
+
+    // Plant: let it settle on the initial load with the fans on the curve
+    ThermalModel::Parameters parameters;
+    parameters.ambient = parser.value("ambient").toDouble();
+    ThermalModel model(parameters);
+    if (trace.kind() == LoadTrace::Kind::Power) {
+        for (int i = 0; i < 100; ++i) {
+            for (int port = 1; port <= ThermalModel::kPortCount; ++port) {
+                model.setCommandedRPM(port, curve.rpmAt(model.temperature()));
+            }
+            model.step(trace.valueAt(0.0), 10.0);
+        }
+    }
+
+    QVector<Step> steps;
+    steps.reserve(ticks);
+    int writes = 0;
+    quint64 sentBefore = 0;
+    quint64 suppressedBefore = 0;
+    int sensorTemperature = 0;
+    double peakDBA = 0.0;
+    qint64 totalNs = 0;
+    qint64 maxNs = 0;
+
+    // Negative time is warm-up so the loop's filter and outputs start settled;
+    // it runs on the initial load and isn't measured
+    const int warmupTicks = int(std::ceil(kWarmup / dt));
+    double nextSensorRead = -warmupTicks * dt;
+    for (int i = -warmupTicks; i < ticks; ++i) {
+        const double t = i * dt;
+        const bool measured = i >= 0;
+        if (i == 0) {
+            sentBefore = loop.output(1).sent();
+            suppressedBefore = loop.output(1).suppressed();
+        }
+
+        // The loop only ever sees whole degrees, refreshed like the live sensor
+        double trueTemperature = (trace.kind() == LoadTrace::Kind::Temperature) ? trace.valueAt(t) : model.temperature();
+        if (t >= nextSensorRead) {
+            sensorTemperature = int(std::lround(trueTemperature));
+            nextSensorRead += kSensorInterval;
+        }
+
+        SensorValues values;
+        values[SensorValues::Cpu] = sensorTemperature;
+
+        auto begin = std::chrono::steady_clock::now();
+        bool changed = loop.step(values, dt, history);
+        qint64 ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+        if (changed) {
+            loop.commitOutputs(); // the model never fails a write
+        }
+        if (measured) {
+            totalNs += ns;
+            maxNs = std::max(maxNs, ns);
+            if (changed) {
+                ++writes;
+            }
+        }
+
+        // The hub runs the fan at duty * 21 RPM
+        for (int port = 1; port <= ThermalModel::kPortCount; ++port) {
+            model.setCommandedRPM(port, loop.duty(port) * 21.0);
+        }
+        if (trace.kind() == LoadTrace::Kind::Power) {
+            model.step(trace.valueAt(t), dt);
+        } else {
+            model.step(0.0, dt); // only the fan inertia matters here
+        }
+
+        for (int port = 1; measured && port <= ThermalModel::kPortCount; ++port) {
+            peakDBA = std::max(peakDBA, FanControlStrategy::expectedDBA(int(std::lround(model.fanRPM(port)))));
+        }
+
+        SensorSample sample;
+        sample.timestamp = qint64(std::llround((i + warmupTicks) * dt * 1000.0));
+        sample.temperature = sensorTemperature;
+        sample.filteredTemperature = static_cast<float>(loop.filteredTemperature());
+        for (int port = 1; port <= FanControlLoop::kPortCount; ++port) {
+            sample.rpm[port - 1] = static_cast<qint16>(loop.rpm(port));
+            sample.duty[port - 1] = static_cast<quint8>(loop.duty(port));
+            sample.portTemperature[port - 1] = static_cast<float>(loop.portTemperature(port));
+        }
+        sample.connectedMask = 0x0f;
+        history.push(sample);
+
+        if (measured) {
+            steps.append({ t, trueTemperature, loop.filteredTemperature(), loop.rpm(1), model.fanRPM(1) });
+        }
+    }
+
+    // Settling is measured from the last change in the load
+    const double from = trace.lastChange();
+    const Step &last = steps.last();
+    double maxTemperature = last.temperature;
+    int maxRPM = last.rpm;
+    double settledAt = -1.0;
+    for (int i = steps.size() - 1; i >= 0 && steps[i].time >= from; --i) {
+        maxTemperature = std::max(maxTemperature, steps[i].temperature);
+        maxRPM = std::max(maxRPM, steps[i].rpm);
+        if (settledAt < 0.0 && std::abs(steps[i].temperature - last.temperature) > kSettleBand) {
+            settledAt = (i + 1 < steps.size()) ? steps[i + 1].time : last.time;
+        }
+    }
+    if (settledAt < 0.0) {
+        settledAt = from; // never left the band
+    }
+    const bool settled = settledAt < last.time;
+
+    QTextStream out(stdout);
+    out << "strategy:          " << FanControlStrategy::kindName(strategy) << "\n";
+    out << "profile:           " << parser.value("profile") << "\n";
+    out << "ticks:             " << ticks << " x " << dt * 1000.0 << " ms\n";
+    out << "final temperature: " << QString::number(last.temperature, 'f', 2) << " °C\n";
+    out << "final rpm:         " << last.rpm << "\n";
+    if (settled) {
+        out << "settle time:       " << QString::number(settledAt - from, 'f', 2) << " s (±" << kSettleBand << " °C)\n";
+    } else {
+        out << "settle time:       not settled\n";
+    }
+    out << "overshoot:         " << QString::number(maxTemperature - last.temperature, 'f', 2) << " °C, "
+        << (maxRPM - last.rpm) << " RPM\n";
+    out << "peak dBA:          " << QString::number(peakDBA, 'f', 1) << "\n";
+    out << "writes:            " << writes << " (port 1: " << loop.output(1).sent() - sentBefore << " sent, "
+        << loop.output(1).suppressed() - suppressedBefore << " suppressed)\n";
+    out << "cpu per tick:      " << QString::number(totalNs / double(ticks), 'f', 0) << " ns mean, "
+        << maxNs << " ns max\n";
+    out.flush();
+
+    if (parser.isSet("series")) {
+        QFile file(parser.value("series"));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            err << "fansim: cannot write " << file.fileName() << Qt::endl;
+            return 1;
+        }
+        QTextStream series(&file);
+        series << "seconds,temperature,filtered,rpm,fan_rpm\n";
+        for (const Step &step : steps) {
+            series << step.time << ',' << step.temperature << ',' << step.filtered << ','
+                   << step.rpm << ',' << step.fanRPM << '\n';
+        }
+    }
+
+    return 0;
+}
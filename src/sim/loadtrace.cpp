@@ -0,0 +1,111 @@
+#include "loadtrace.h"
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+
+// Heat loads of the synthetic scenarios (W)
+static constexpr double kIdlePower = 30.0;
+static constexpr double kLoadPower = 150.0;
+
+LoadTrace::LoadTrace(Kind kind, const QVector<QPointF> &points)
+    : m_kind(kind)
+    , m_points(points)
+{
+    std::stable_sort(m_points.begin(), m_points.end(), [](const QPointF &a, const QPointF &b) {
+        return a.x() < b.x();
+    });
+}
+
+LoadTrace LoadTrace::synthetic(const QString &name, double duration)
+{
+    QVector<QPointF> points;
+
+    if (name == "idle") {
+        points << QPointF(0, kIdlePower) << QPointF(duration, kIdlePower);
+    } else if (name == "step") {
+        // Idle, then full load for the rest of the run
+        points << QPointF(0, kIdlePower) << QPointF(10, kLoadPower) << QPointF(duration, kLoadPower);
+    } else if (name == "ramp") {
+        // Load climbs over a minute in 1 s steps
+        for (int s = 0; s <= 60; ++s) {
+            points << QPointF(10 + s, kIdlePower + (kLoadPower - kIdlePower) * s / 60.0);
+        }
+        points.prepend(QPointF(0, kIdlePower));
+        points << QPointF(duration, kLoadPower);
+    } else if (name == "burst") {
+        // 5 s of full load every 20 s, back to idle for the last third
+        const double end = duration * 2.0 / 3.0;
+        for (double t = 0; t < end; t += 20.0) {
+            points << QPointF(t, kIdlePower) << QPointF(t + 15.0, kLoadPower) << QPointF(t + 20.0, kIdlePower);
+        }
+        points << QPointF(duration, kIdlePower);
+    }
+
+    return LoadTrace(Kind::Power, points);
+}
+
+LoadTrace LoadTrace::fromCsv(const QString &path, Kind kind, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (error) *error = QString("cannot open %1: %2").arg(path, file.errorString());
+        return LoadTrace();
+    }
+
+    QVector<QPointF> points;
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        QStringList fields = line.split(',');
+        bool timeOk = false;
+        bool valueOk = false;
+        double seconds = fields.value(0).trimmed().toDouble(&timeOk);
+        double value = fields.value(1).trimmed().toDouble(&valueOk);
+        if (!timeOk || !valueOk) {
+            if (points.isEmpty()) {
+                continue; // header
+            }
+            if (error) *error = QString("%1:%2: expected \"seconds,value\"").arg(path).arg(lineNumber);
+            return LoadTrace();
+        }
+        points << QPointF(seconds, value);
+    }
+
+    if (points.isEmpty()) {
+        if (error) *error = QString("%1: no samples").arg(path);
+        return LoadTrace();
+    }
+    return LoadTrace(kind, points);
+}
+
+double LoadTrace::valueAt(double seconds) const
+{
+    if (m_points.isEmpty()) {
+        return 0.0;
+    }
+
+    // Last point at or before the given time
+    auto it = std::upper_bound(m_points.begin(), m_points.end(), seconds, [](double t, const QPointF &p) {
+        return t < p.x();
+    });
+    if (it == m_points.begin()) {
+        return m_points.first().y();
+    }
+    return (it - 1)->y();
+}
+
+double LoadTrace::lastChange() const
+{
+    for (int i = m_points.size() - 1; i > 0; --i) {
+        if (m_points[i].y() != m_points[i - 1].y()) {
+            return m_points[i].x();
+        }
+    }
+    return 0.0;
+}
@@ -0,0 +1,43 @@
+#ifndef LOADTRACE_H
+#define LOADTRACE_H
+
+#include <QString>
+#include <QVector>
+#include <QPointF>
+
+// Time series that drives the simulator: either a heat load in watts that
+// goes through the thermal model (closed loop, the fans matter), or a
+// recorded temperature that is replayed as-is (open loop, only the
+// controller's response is measured). Values hold until the next point.
+class LoadTrace
+{
+public:
+    enum class Kind {
+        Power,       // W into the thermal model
+        Temperature  // °C fed straight to the controller
+    };
+
+    LoadTrace() = default;
+    LoadTrace(Kind kind, const QVector<QPointF> &points);
+
+    // "idle", "step", "ramp" or "burst"; an empty trace for unknown names
+    static LoadTrace synthetic(const QString &name, double duration);
+
+    // "seconds,value" per line; '#' comments and a non-numeric header are skipped
+    static LoadTrace fromCsv(const QString &path, Kind kind, QString *error = nullptr);
+
+    bool isEmpty() const { return m_points.isEmpty(); }
+    Kind kind() const { return m_kind; }
+    double duration() const { return m_points.isEmpty() ? 0.0 : m_points.last().x(); }
+
+    double valueAt(double seconds) const;
+
+    // When the value last changed; the settling metrics are measured from here
+    double lastChange() const;
+
+private:
+    Kind m_kind = Kind::Power;
+    QVector<QPointF> m_points;
+};
+
+#endif // LOADTRACE_H
@@ -0,0 +1,58 @@
+#include "thermalmodel.h"
+#include <algorithm>
+#include <cmath>
+
+ThermalModel::ThermalModel()
+    : ThermalModel(Parameters())
+{
+}
+
+ThermalModel::ThermalModel(const Parameters &parameters)
+    : m_parameters(parameters)
+    , m_temperature(parameters.ambient)
+{
+    m_commandedRPM.fill(0.0);
+    m_fanRPM.fill(0.0);
+}
+
+void ThermalModel::setCommandedRPM(int port, double rpm)
+{
+    if (port < 1 || port > kPortCount) {
+        return;
+    }
+    m_commandedRPM[port - 1] = std::max(0.0, rpm);
+}
+
+void ThermalModel::step(double power, double dt)
+{
+    if (dt <= 0.0) {
+        return;
+    }
+
+    // Exact first-order lag per fan, stable for any dt
+    const double lag = (m_parameters.fanTimeConstant > 0.0)
+                     ? 1.0 - std::exp(-dt / m_parameters.fanTimeConstant)
+                     : 1.0;
+    for (int i = 0; i < kPortCount; ++i) {
+        m_fanRPM[i] += lag * (m_commandedRPM[i] - m_fanRPM[i]);
+    }
+
+    // Integrate the heat balance in small sub-steps so large dt stays stable
+    const double conductance = m_parameters.baseConductance + m_parameters.fanConductance * averageRPM() / 1000.0;
+    const double maxStep = 0.5 * m_parameters.heatCapacity / std::max(conductance, 1e-6);
+    const int subSteps = std::max(1, int(std::ceil(dt / maxStep)));
+    const double h = dt / subSteps;
+    for (int k = 0; k < subSteps; ++k) {
+        const double flow = power - conductance * (m_temperature - m_parameters.ambient);
+        m_temperature += flow * h / m_parameters.heatCapacity;
+    }
+}
+
+double ThermalModel::averageRPM() const
+{
+    double total = 0.0;
+    for (double rpm : m_fanRPM) {
+        total += rpm;
+    }
+    return total / kPortCount;
+}
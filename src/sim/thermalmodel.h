@@ -0,0 +1,48 @@
+#ifndef THERMALMODEL_H
+#define THERMALMODEL_H
+
+#include <array>
+
+// Lumped thermal model of a CPU cooled by the four hub fans, for the
+// offline simulator. One heat capacity, heated by the load and cooled
+// through a conductance that grows with the fans' actual RPM:
+//
+//     C dT/dt = P - (G0 + G1 * rpm / 1000) * (T - ambient)
+//
+// The fans don't jump to what they are told: each follows its commanded
+// RPM with a first-order lag (spin-up/spin-down inertia).
+class ThermalModel
+{
+public:
+    static constexpr int kPortCount = 4;
+
+    struct Parameters {
+        double ambient = 25.0;          // °C
+        double heatCapacity = 60.0;     // J/K
+        double baseConductance = 0.6;   // W/K with the fans stopped
+        double fanConductance = 1.0;    // W/K per 1000 RPM (average over the fans)
+        double fanTimeConstant = 1.5;   // s for a fan to cover 63% of a change
+    };
+
+    ThermalModel();
+    explicit ThermalModel(const Parameters &parameters);
+
+    // Ports are 1-4
+    void setCommandedRPM(int port, double rpm);
+    double fanRPM(int port) const { return m_fanRPM[port - 1]; }
+
+    // Advance by dt seconds with the given heat load
+    void step(double power, double dt);
+
+    double temperature() const { return m_temperature; }
+
+private:
+    double averageRPM() const;
+
+    Parameters m_parameters;
+    double m_temperature;
+    std::array<double, kPortCount> m_commandedRPM;
+    std::array<double, kPortCount> m_fanRPM;
+};
+
+#endif // THERMALMODEL_H
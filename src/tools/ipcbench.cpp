@@ -0,0 +1,357 @@
+// ipcbench - loopback check and latency benchmark of the llconnectd protocol
+//
+// Runs a DaemonServer on its own thread, on a private socket and telemetry
+// page, and talks to it the way DaemonClient does. Every message type is
+// round-tripped and compared field by field first; then the latencies the
+// GUI depends on are measured:
+//
+//   ping      socket round trip (Ping -> Pong)
+//   curve     client write -> curveChanged() on the server thread
+//   sample    publishSample() -> Sample frame read by the client
+//   page      publishSample() -> sample visible in the telemetry page
+//
+// Exits non-zero if any round trip comes back different.
+//
+//   ipcbench
+//   ipcbench --iterations 10000
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QLocalSocket>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+#include <unistd.h>
+#include "daemon/daemonprotocol.h"
+#include "daemon/daemonserver.h"
+#include "daemon/telemetrypage.h"
+
+using DaemonProtocol::MessageType;
+using Clock = std::chrono::steady_clock;
+
+static constexpr int kTimeout = 2000;   // ms for any single reply
+
+static double microseconds(Clock::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// What the server handed out through its signals, on the server thread
+struct Inbox
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    int curves = 0;
+    int port = 0;
+    FanCurve curve;
+    int lightings = 0;
+    LightingState lighting;
+    Clock::time_point received;
+
+    template <typename Predicate>
+    bool wait(Predicate predicate)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return changed.wait_for(lock, std::chrono::milliseconds(kTimeout), predicate);
+    }
+};
+
+class Client
+{
+public:
+    bool connect(const QString &path)
+    {
+        m_socket.connectToServer(path);
+        return m_socket.waitForConnected(kTimeout);
+    }
+
+    void send(const QByteArray &frame)
+    {
+        m_socket.write(frame);
+        m_socket.flush();
+    }
+
+    // Skips other messages until one of `type` arrives
+    bool receive(MessageType type, QByteArray *payload)
+    {
+        MessageType received;
+        for (;;) {
+            while (m_reader.next(&received, payload)) {
+                if (received == type) {
+                    return true;
+                }
+            }
+            if (m_reader.hasError() || !m_socket.waitForReadyRead(kTimeout)) {
+                return false;
+            }
+            m_reader.append(m_socket.readAll());
+        }
+    }
+
+private:
+    QLocalSocket m_socket;
+    DaemonProtocol::FrameReader m_reader;
+};
+
+struct Summary
+{
+    const char *name;
+    std::vector<double> values;   // us
+};
+
+static void print(Summary &summary)
+{
+    std::vector<double> &v = summary.values;
+    if (v.empty()) {
+        return;
+    }
+    std::sort(v.begin(), v.end());
+    auto percentile = [&v](double p) { return v[std::min(v.size() - 1, size_t(p * v.size()))]; };
+    printf("%-8s n=%-6zu p50 %8.1f us   p90 %8.1f us   p99 %8.1f us   max %8.1f us\n",
+           summary.name, v.size(), percentile(0.50), percentile(0.90), percentile(0.99), v.back());
+}
+
+static bool sameSample(const SensorSample &a, const SensorSample &b)
+{
+    if (a.timestamp != b.timestamp || a.temperature != b.temperature || a.filteredTemperature != b.filteredTemperature
+        || a.connectedMask != b.connectedMask || a.simulatedTemperature != b.simulatedTemperature) {
+        return false;
+    }
+    for (int i = 0; i < 4; ++i) {
+        if (a.rpm[i] != b.rpm[i] || a.duty[i] != b.duty[i] || a.portTemperature[i] != b.portTemperature[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static SensorSample makeSample(qint64 timestamp)
+{
+    SensorSample sample;
+    sample.timestamp = timestamp;
+    sample.temperature = 41.5f + (timestamp % 7);
+    sample.filteredTemperature = 40.25f;
+    sample.connectedMask = 0x0b;
+    for (int i = 0; i < 4; ++i) {
+        sample.rpm[i] = qint16(800 + 100 * i + timestamp % 50);
+        sample.duty[i] = quint8(20 + 10 * i);
+        sample.portTemperature[i] = 38.0f + i;
+    }
+    return sample;
+}
+
+static void publish(DaemonServer *server, const SensorSample &sample)
+{
+    QMetaObject::invokeMethod(server, [server, sample]() { server->publishSample(sample); });
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ipcbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Loopback check and latency benchmark of the llconnectd protocol");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "iterations", "Round trips per measurement.", "n", "2000" },
+    });
+    parser.process(app);
+    const int iterations = qMax(1, parser.value("iterations").toInt());
+
+    const QString socketPath = QDir::temp().filePath(QString("ipcbench-%1.sock").arg(::getpid()));
+    const QString telemetryName = QString("/ipcbench-%1").arg(::getpid());
+
+    // The server side, as in llconnectd but on its own thread
+    QThread serverThread;
+    DaemonServer *server = new DaemonServer();
+    server->moveToThread(&serverThread);
+    QObject::connect(&serverThread, &QThread::finished, server, &QObject::deleteLater);
+
+    Inbox inbox;
+    QObject::connect(server, &DaemonServer::curveChanged, server, [&inbox](int port, const FanCurve &curve) {
+        std::lock_guard<std::mutex> lock(inbox.mutex);
+        inbox.received = Clock::now();
+        inbox.port = port;
+        inbox.curve = curve;
+        ++inbox.curves;
+        inbox.changed.notify_all();
+    });
+    QObject::connect(server, &DaemonServer::lightingChanged, server, [&inbox](const LightingState &state) {
+        std::lock_guard<std::mutex> lock(inbox.mutex);
+        inbox.received = Clock::now();
+        inbox.lighting = state;
+        ++inbox.lightings;
+        inbox.changed.notify_all();
+    });
+    serverThread.start();
+
+    bool listening = false;
+    QMetaObject::invokeMethod(server, [&]() { listening = server->listen(socketPath, telemetryName); },
+                              Qt::BlockingQueuedConnection);
+    if (!listening) {
+        fprintf(stderr, "ipcbench: %s\n", qPrintable(server->errorString()));
+        serverThread.quit();
+        serverThread.wait();
+        return 1;
+    }
+
+    int failures = 0;
+    auto fail = [&failures](const char *what) {
+        fprintf(stderr, "FAIL: %s\n", what);
+        ++failures;
+    };
+
+    Client client;
+    QByteArray payload;
+    DaemonProtocol::Hello hello;
+    TelemetryPage page;
+    if (!client.connect(socketPath)) {
+        fail("connect");
+    } else if (!client.receive(MessageType::Hello, &payload) || !DaemonProtocol::decode(payload, &hello)) {
+        fail("hello");
+    } else {
+        if (hello.version != DaemonProtocol::kVersion || hello.sampleSize != sizeof(SensorSample)
+            || QString::fromLocal8Bit(hello.telemetryName) != telemetryName) {
+            fail("hello contents");
+        }
+        client.send(DaemonProtocol::encode(MessageType::Hello, DaemonProtocol::hello()));
+        if (!page.open(telemetryName)) {
+            fail("telemetry page open");
+        }
+    }
+
+    // Curve
+    const FanCurve curve({ QPointF(20, 500), QPointF(45.5, 1100), QPointF(80, 2000) }, FanCurve::Interpolation::Step);
+    if (failures == 0) {
+        client.send(DaemonProtocol::encode(MessageType::Curve, DaemonProtocol::curveMessage(3, curve)));
+        if (!inbox.wait([&inbox]() { return inbox.curves == 1; })) {
+            fail("curve not received");
+        } else if (inbox.port != 3 || inbox.curve.points() != curve.points()
+                   || inbox.curve.interpolation() != curve.interpolation()) {
+            fail("curve contents");
+        }
+    }
+
+    // Lighting
+    if (failures == 0) {
+        LightingState state;
+        state.effect = "Tunnel";
+        state.speed = 30;
+        state.brightness = 75;
+        state.directionLeft = true;
+        state.selectedPort = 2;
+        state.portEnabled[1] = false;
+        state.colors[2][0] = QColor(255, 10, 20);
+        state.colors[2][3] = QColor(0, 0, 255);
+        client.send(DaemonProtocol::encode(MessageType::Lighting, DaemonProtocol::lightingMessage(state)));
+
+        if (!inbox.wait([&inbox]() { return inbox.lightings == 1; })) {
+            fail("lighting not received");
+        } else {
+            const LightingState &got = inbox.lighting;
+            bool same = got.effect == state.effect && got.speed == state.speed && got.brightness == state.brightness
+                        && got.directionLeft == state.directionLeft && got.selectedPort == state.selectedPort;
+            for (int port = 0; port < 4; ++port) {
+                same &= got.portEnabled[port] == state.portEnabled[port];
+                for (int i = 0; i < 4; ++i) {
+                    same &= got.colors[port][i] == state.colors[port][i];
+                }
+            }
+            if (!same) {
+                fail("lighting contents");
+            }
+        }
+    }
+
+    // Samples, over the socket and through the page
+    qint64 timestamp = 1;
+    if (failures == 0) {
+        client.send(DaemonProtocol::encode(MessageType::Publish, DaemonProtocol::Publish{ 1 }));
+        const SensorSample sent = makeSample(timestamp);
+        publish(server, sent);
+
+        SensorSample received;
+        if (!client.receive(MessageType::Sample, &payload) || !DaemonProtocol::decode(payload, &received)) {
+            fail("sample not received");
+        } else if (!sameSample(sent, received)) {
+            fail("sample contents");
+        }
+
+        SensorSample shared;
+        if (!page.latest(shared) || !sameSample(sent, shared)) {
+            fail("telemetry page contents");
+        }
+    }
+
+    if (failures > 0) {
+        serverThread.quit();
+        serverThread.wait();
+        return 1;
+    }
+    printf("round trips ok (protocol %d, %zu byte samples)\n", DaemonProtocol::kVersion, sizeof(SensorSample));
+
+    Summary ping = { "ping", {} };
+    Summary curves = { "curve", {} };
+    Summary samples = { "sample", {} };
+    Summary pages = { "page", {} };
+
+    for (int i = 0; i < iterations && failures == 0; ++i) {
+        const Clock::time_point start = Clock::now();
+        client.send(DaemonProtocol::encode(MessageType::Ping, DaemonProtocol::Ping{ quint64(i), 0 }));
+        DaemonProtocol::Ping pong;
+        if (!client.receive(MessageType::Pong, &payload) || !DaemonProtocol::decode(payload, &pong) || pong.id != quint64(i)) {
+            fail("pong");
+            break;
+        }
+        ping.values.push_back(microseconds(Clock::now() - start));
+    }
+
+    for (int i = 0; i < iterations && failures == 0; ++i) {
+        const Clock::time_point start = Clock::now();
+        client.send(DaemonProtocol::encode(MessageType::Curve, DaemonProtocol::curveMessage(1 + i % 4, curve)));
+        if (!inbox.wait([&inbox, i]() { return inbox.curves == i + 2; })) {
+            fail("curve");
+            break;
+        }
+        std::lock_guard<std::mutex> lock(inbox.mutex);
+        curves.values.push_back(microseconds(inbox.received - start));
+    }
+
+    for (int i = 0; i < iterations && failures == 0; ++i) {
+        const quint64 head = page.head();
+        const Clock::time_point start = Clock::now();
+        publish(server, makeSample(++timestamp));
+
+        // Both see the same publish: the page first, then the socket
+        while (page.head() == head && Clock::now() - start < std::chrono::milliseconds(kTimeout)) {
+        }
+        if (page.head() == head) {
+            fail("page");
+            break;
+        }
+        pages.values.push_back(microseconds(Clock::now() - start));
+
+        SensorSample received;
+        if (!client.receive(MessageType::Sample, &payload) || !DaemonProtocol::decode(payload, &received)
+            || received.timestamp != timestamp) {
+            fail("sample");
+            break;
+        }
+        samples.values.push_back(microseconds(Clock::now() - start));
+    }
+
+    print(ping);
+    print(curves);
+    print(samples);
+    print(pages);
+
+    serverThread.quit();
+    serverThread.wait();
+    return failures > 0 ? 1 : 0;
+}
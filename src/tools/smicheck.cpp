@@ -0,0 +1,236 @@
+// smicheck - runs NvidiaSmiSession against fake nvidia-smi scripts
+//
+// Needs no NVIDIA hardware: each scenario writes a small shell script that
+// behaves like one way nvidia-smi can behave, points the session at it
+// with setProgram() and checks what comes out:
+//
+//   stream    CSV parsing: split lines, other GPUs, [N/A] fields, -lms
+//   stop      stop() takes the child down with it
+//   restart   a child that exits after a sample is relaunched after
+//             kRestartDelay
+//   backoff   a child that keeps dying without output is relaunched with
+//             a doubling delay
+//   missing   a missing binary leaves the session idle
+//
+// Exits non-zero if any check fails. The restart and backoff scenarios
+// wait out the real delays (about 20 s); --quick skips them.
+//
+//   smicheck
+//   smicheck --quick
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QVector>
+#include <cerrno>
+#include <cstdio>
+#include <functional>
+#include <signal.h>
+#include "sensors/nvidiasmisession.h"
+
+static int g_failures = 0;
+
+static void check(bool condition, const char *what)
+{
+    if (!condition) {
+        fprintf(stderr, "FAIL: %s\n", what);
+        ++g_failures;
+    }
+}
+
+// Runs the event loop until predicate() holds or timeoutMs passed
+static bool waitFor(const std::function<bool()> &predicate, int timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!predicate()) {
+        if (timer.elapsed() >= timeoutMs) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
+        QThread::msleep(5);
+    }
+    return true;
+}
+
+// Every launch appends "<ms since start> <pid> <arguments>" to a log
+class FakeSmi
+{
+public:
+    FakeSmi(const QTemporaryDir &dir, const QString &name, const QByteArray &body)
+        : m_program(dir.filePath(name))
+        , m_log(dir.filePath(name + ".log"))
+    {
+        QFile script(m_program);
+        if (script.open(QIODevice::WriteOnly)) {
+            script.write("#!/bin/sh\n");
+            script.write("echo \"$(date +%s%3N) $$ $*\" >> '" + m_log.toLocal8Bit() + "'\n");
+            script.write(body);
+            script.close();
+            script.setPermissions(script.permissions() | QFileDevice::ExeOwner);
+        }
+    }
+
+    QString program() const { return m_program; }
+
+    QVector<QList<QByteArray>> launches() const
+    {
+        QVector<QList<QByteArray>> result;
+        QFile log(m_log);
+        if (log.open(QIODevice::ReadOnly)) {
+            for (const QByteArray &line : log.readAll().split('\n')) {
+                if (!line.isEmpty()) {
+                    result.append(line.split(' '));
+                }
+            }
+        }
+        return result;
+    }
+
+private:
+    QString m_program;
+    QString m_log;
+};
+
+static void checkStreamAndStop(const QTemporaryDir &dir)
+{
+    // A full line, a second GPU, then a line split across two writes with
+    // unsupported fields; then it keeps running like the real tool
+    FakeSmi smi(dir, "stream", R"(
+printf '0, NVIDIA GeForce RTX 4070, 37, 52, 2520, 41.25, 1024, 12282\n'
+printf '1, Second GPU, 99, 99, 99, 99.00, 99, 99\n'
+printf '0, NVIDIA GeFo'
+sleep 0.2
+printf 'rce RTX 4070, [N/A], 53, [Not Supported], 40.00, 1100, 12282\n'
+exec sleep 1000
+)");
+
+    NvidiaSmiSession session;
+    QVector<GPUInfo> samples;
+    QObject::connect(&session, &NvidiaSmiSession::sampleReady, [&samples](const GPUInfo &info) {
+        samples.append(info);
+    });
+    session.setProgram(smi.program());
+    session.start(200);
+
+    check(waitFor([&samples]() { return samples.size() >= 2; }, 3000), "stream: two samples");
+    waitFor([]() { return false; }, 300);
+    check(samples.size() == 2, "stream: GPU 1 ignored");
+
+    if (samples.size() >= 2) {
+        const GPUInfo &first = samples[0];
+        check(first.model == "NVIDIA GeForce RTX 4070", "stream: model");
+        check(first.load == 37 && first.temperature == 52 && first.clockRate == 2520, "stream: load/temperature/clock");
+        check(first.power == 41.25 && first.memoryUsed == 1024 && first.memoryTotal == 12282, "stream: power/memory");
+
+        const GPUInfo &second = samples[1];
+        check(second.model == "NVIDIA GeForce RTX 4070", "stream: split line");
+        check(second.load == -1 && second.clockRate == -1, "stream: [N/A] fields read as -1");
+        check(second.temperature == 53 && second.memoryUsed == 1100, "stream: fields after [N/A]");
+        check(session.latest().temperature == 53, "stream: latest()");
+    }
+    check(session.hasFreshSample(), "stream: fresh sample");
+
+    const QVector<QList<QByteArray>> launches = smi.launches();
+    check(launches.size() == 1, "stream: launched once");
+    if (launches.size() == 1) {
+        const QList<QByteArray> &launch = launches[0];
+        const int lms = launch.indexOf("-lms");
+        check(lms > 0 && lms + 1 < launch.size() && launch[lms + 1] == "200", "stream: -lms interval");
+        check(launch.contains("--format=csv,noheader,nounits"), "stream: CSV format");
+
+        const pid_t pid = launch.value(1).toInt();
+        session.stop();
+        check(!session.isRunning(), "stop: not running");
+        check(pid > 0 && ::kill(pid, 0) == -1 && errno == ESRCH, "stop: child gone");
+    }
+}
+
+static void checkRestart(const QTemporaryDir &dir)
+{
+    FakeSmi smi(dir, "restart", R"(
+printf '0, NVIDIA GeForce RTX 4070, 10, 40, 1500, 20.00, 512, 12282\n'
+exit 1
+)");
+
+    NvidiaSmiSession session;
+    session.setProgram(smi.program());
+    session.start(200);
+
+    const int delay = NvidiaSmiSession::kRestartDelay;
+    check(waitFor([&smi]() { return smi.launches().size() >= 2; }, delay + 2000), "restart: relaunched");
+    const QVector<QList<QByteArray>> launches = smi.launches();
+    if (launches.size() >= 2) {
+        const qint64 gap = launches[1][0].toLongLong() - launches[0][0].toLongLong();
+        check(gap >= delay - 250 && gap < delay + 1500, "restart: after kRestartDelay");
+    }
+    check(session.isRunning() && session.isAvailable(), "restart: session still running");
+    session.stop();
+}
+
+static void checkBackoff(const QTemporaryDir &dir)
+{
+    FakeSmi smi(dir, "backoff", "exit 1\n");
+
+    NvidiaSmiSession session;
+    session.setProgram(smi.program());
+    session.start(200);
+
+    const int delay = NvidiaSmiSession::kRestartDelay;
+    check(waitFor([&smi]() { return smi.launches().size() >= 3; }, 3 * delay + 3000), "backoff: three launches");
+    const QVector<QList<QByteArray>> launches = smi.launches();
+    if (launches.size() >= 3) {
+        const qint64 first = launches[1][0].toLongLong() - launches[0][0].toLongLong();
+        const qint64 second = launches[2][0].toLongLong() - launches[1][0].toLongLong();
+        check(first >= delay - 250 && first < delay + 1500, "backoff: first delay");
+        check(second >= 2 * delay - 250 && second < 2 * delay + 1500, "backoff: delay doubles");
+    }
+    session.stop();
+}
+
+static void checkMissing(const QTemporaryDir &dir)
+{
+    NvidiaSmiSession session;
+    session.setProgram(dir.filePath("missing-nvidia-smi"));
+    session.start(200);
+
+    check(waitFor([&session]() { return !session.isAvailable(); }, 3000), "missing: marked unavailable");
+    check(!session.hasFreshSample(), "missing: no sample");
+    session.stop();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("smicheck");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs NvidiaSmiSession against fake nvidia-smi scripts");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "quick", "Skip the restart and backoff checks, which wait out the real delays." },
+    });
+    parser.process(app);
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        fprintf(stderr, "smicheck: no temporary directory\n");
+        return 1;
+    }
+
+    checkStreamAndStop(dir);
+    checkMissing(dir);
+    if (!parser.isSet("quick")) {
+        checkRestart(dir);
+        checkBackoff(dir);
+    }
+
+    if (g_failures > 0) {
+        return 1;
+    }
+    printf("nvidia-smi session ok%s\n", parser.isSet("quick") ? " (quick)" : "");
+    return 0;
+}
@@ -0,0 +1,295 @@
+// tracedump - converts an LLCONNECT_TRACE recording to JSON
+//
+// The app writes the trace in its binary form (see utils/trace.h); this
+// turns it into a JSON event list for scripts, or into the Chrome trace
+// format for a timeline in chrome://tracing or ui.perfetto.dev.
+//
+//   LLCONNECT_TRACE=/tmp/ll.trace LLConnect3
+//   tracedump /tmp/ll.trace --format chrome --output ll.json
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "utils/trace.h"
+
+struct Thread
+{
+    quint32 id;
+    QString name;
+    quint64 events;
+    quint64 dropped;
+};
+
+struct Record
+{
+    Trace::Event event;
+    quint32 thread;
+};
+
+// HIDCommandKind, in declaration order
+static const char *const kCommandKinds[] = { "frame", "commit", "stream", "delay" };
+
+static const char *const kSensorNames[] = { "cpu", "gpu", "nvme", "liquid" };
+static constexpr int kFirstChannel = 4;   // SensorValues::FirstChannel
+
+static bool readTrace(const QString &path, QVector<Thread> &threads, QVector<Record> &records,
+                      quint64 &startTime, QString &error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return false;
+    }
+
+    auto read = [&file](void *data, qint64 size) {
+        return file.read(static_cast<char *>(data), size) == size;
+    };
+
+    Trace::FileHeader header;
+    if (!read(&header, sizeof(header)) || std::memcmp(header.magic, Trace::kMagic, sizeof(header.magic)) != 0) {
+        error = "not a trace file";
+        return false;
+    }
+    if (header.version != Trace::kVersion || header.eventSize != sizeof(Trace::Event)) {
+        error = QString("unsupported trace version %1").arg(header.version);
+        return false;
+    }
+    startTime = header.startTime;
+
+    for (quint32 t = 0; t < header.threadCount; ++t) {
+        Trace::ThreadHeader thread;
+        if (!read(&thread, sizeof(thread))) {
+            error = "truncated thread header";
+            return false;
+        }
+        threads.append({ thread.thread,
+                         QString::fromUtf8(thread.name, int(strnlen(thread.name, sizeof(thread.name)))),
+                         thread.eventCount, thread.dropped });
+
+        for (quint64 i = 0; i < thread.eventCount; ++i) {
+            Record record;
+            record.thread = thread.thread;
+            if (!read(&record.event, sizeof(record.event))) {
+                error = "truncated event list";
+                return false;
+            }
+            records.append(record);
+        }
+    }
+
+    std::stable_sort(records.begin(), records.end(), [](const Record &a, const Record &b) {
+        return a.event.time < b.event.time;
+    });
+    return true;
+}
+
+static QString number(double value)
+{
+    return std::isnan(value) ? QString("null") : QString::number(value, 'g', 8);
+}
+
+static QString flag(bool value)
+{
+    return value ? "true" : "false";
+}
+
+// {"t": seconds, "thread": id, "type": ..., fields...} per event
+static void writeJson(QTextStream &out, const QVector<Thread> &threads, const QVector<Record> &records,
+                      quint64 startTime)
+{
+    out << "{\n  \"version\": " << Trace::kVersion << ",\n  \"threads\": [\n";
+    for (int i = 0; i < threads.size(); ++i) {
+        const Thread &thread = threads[i];
+        out << "    {\"id\": " << thread.id << ", \"name\": \"" << thread.name << "\", \"events\": "
+            << thread.events << ", \"dropped\": " << thread.dropped << "}"
+            << (i + 1 < threads.size() ? ",\n" : "\n");
+    }
+    out << "  ],\n  \"events\": [\n";
+
+    for (int i = 0; i < records.size(); ++i) {
+        const Trace::Event &e = records[i].event;
+        out << "    {\"t\": " << number((e.time - startTime) / 1e9) << ", \"thread\": " << records[i].thread;
+
+        switch (Trace::EventType(e.type)) {
+        case Trace::EventType::HidWrite: {
+            const quint32 kind = (e.arg >> 8) & 0xff;
+            out << ", \"type\": \"hid_write\", \"channel\": " << e.channel
+                << ", \"opcode\": " << (e.arg & 0xff)
+                << ", \"kind\": \"" << (kind < 4 ? kCommandKinds[kind] : "unknown") << "\""
+                << ", \"bytes\": " << (e.arg >> 16)
+                << ", \"latency_us\": " << number(e.values[0])
+                << ", \"write_us\": " << number(e.values[1])
+                << ", \"report\": " << int(e.values[2])
+                << ", \"ok\": " << flag(!(e.flags & Trace::FlagFailed));
+            break;
+        }
+        case Trace::EventType::ControlTick:
+            out << ", \"type\": \"control_tick\", \"port\": " << e.channel
+                << ", \"tf\": " << number(e.values[0])
+                << ", \"rate\": " << number(e.values[1])
+                << ", \"target\": " << number(e.values[2])
+                << ", \"rpm\": " << number(e.values[3])
+                << ", \"duty\": " << e.arg
+                << ", \"requested\": " << flag(e.flags & Trace::FlagRequested)
+                << ", \"written\": " << flag(e.flags & Trace::FlagWritten);
+            break;
+        case Trace::EventType::SensorSample:
+            out << ", \"type\": \"sensor_sample\"";
+            if (e.channel < kFirstChannel) {
+                for (int s = 0; s < 4; ++s) {
+                    out << ", \"" << kSensorNames[s] << "\": " << number(e.values[s]);
+                }
+                out << ", \"simulated\": " << flag(e.flags & Trace::FlagSimulated);
+            } else {
+                out << ", \"hwmon\": " << (e.channel - kFirstChannel) << ", \"value\": " << number(e.values[0]);
+            }
+            break;
+        default:
+            out << ", \"type\": " << e.type;
+            break;
+        }
+        out << "}" << (i + 1 < records.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+// Trace Event Format: HID writes as duration slices on their thread, the
+// control loop and sensors as counter tracks, duty writes as instants
+static void writeChrome(QTextStream &out, const QVector<Thread> &threads, const QVector<Record> &records,
+                        quint64 startTime)
+{
+    bool first = true;
+    auto begin = [&out, &first](const QString &name, const char *phase, double ts, quint32 thread) {
+        out << (first ? "\n" : ",\n") << "  {\"name\": \"" << name << "\", \"ph\": \"" << phase
+            << "\", \"ts\": " << QString::number(ts, 'f', 3) << ", \"pid\": 1, \"tid\": " << thread;
+        first = false;
+    };
+
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    begin("process_name", "M", 0, 0);
+    out << ", \"args\": {\"name\": \"LL-Connect 3\"}}";
+    for (const Thread &thread : threads) {
+        begin("thread_name", "M", 0, thread.id);
+        out << ", \"args\": {\"name\": \"" << (thread.name.isEmpty() ? QString("thread %1").arg(thread.id) : thread.name)
+            << "\"}}";
+    }
+
+    for (const Record &record : records) {
+        const Trace::Event &e = record.event;
+        const double ts = (e.time - startTime) / 1e3;
+
+        switch (Trace::EventType(e.type)) {
+        case Trace::EventType::HidWrite: {
+            const quint32 kind = (e.arg >> 8) & 0xff;
+            const double duration = e.values[1];
+            begin(QString("%1 ch%2").arg(kind < 4 ? kCommandKinds[kind] : "hid").arg(e.channel), "X",
+                  ts - duration, record.thread);
+            out << ", \"dur\": " << number(duration) << ", \"cat\": \"hid\", \"args\": {"
+                << "\"opcode\": \"0x" << QString::number(e.arg & 0xff, 16).rightJustified(2, '0') << "\""
+                << ", \"bytes\": " << (e.arg >> 16)
+                << ", \"latency_us\": " << number(e.values[0])
+                << ", \"report\": " << int(e.values[2])
+                << ", \"ok\": " << flag(!(e.flags & Trace::FlagFailed)) << "}}";
+            break;
+        }
+        case Trace::EventType::ControlTick:
+            begin(QString("port %1 temperature").arg(e.channel), "C", ts, record.thread);
+            out << ", \"args\": {\"Tf\": " << number(e.values[0]) << ", \"dT/dt\": " << number(e.values[1]) << "}}";
+            begin(QString("port %1 rpm").arg(e.channel), "C", ts, record.thread);
+            out << ", \"args\": {\"target\": " << number(e.values[2]) << ", \"gated\": " << number(e.values[3]) << "}}";
+            if (e.flags & Trace::FlagWritten) {
+                begin(QString("duty port %1").arg(e.channel), "i", ts, record.thread);
+                out << ", \"s\": \"t\", \"cat\": \"control\", \"args\": {\"duty\": " << e.arg << "}}";
+            }
+            break;
+        case Trace::EventType::SensorSample:
+            if (e.channel < kFirstChannel) {
+                // Counters can't hold null; leave missing sensors out
+                begin("sensors", "C", ts, record.thread);
+                out << ", \"args\": {";
+                bool any = false;
+                for (int s = 0; s < 4; ++s) {
+                    if (!std::isnan(e.values[s])) {
+                        out << (any ? ", " : "") << "\"" << kSensorNames[s] << "\": " << number(e.values[s]);
+                        any = true;
+                    }
+                }
+                out << "}}";
+            } else if (!std::isnan(e.values[0])) {
+                begin(QString("hwmon %1").arg(e.channel - kFirstChannel), "C", ts, record.thread);
+                out << ", \"args\": {\"value\": " << number(e.values[0]) << "}}";
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    out << "\n]}\n";
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("tracedump");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Converts an LL-Connect 3 trace (LLCONNECT_TRACE) to JSON");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "format", "json (event list) or chrome (chrome://tracing, Perfetto).", "format", "json" },
+        { "output", "Write here instead of standard output.", "file" },
+    });
+    parser.addPositionalArgument("trace", "Trace file written by LL-Connect 3.");
+    parser.process(app);
+
+    QTextStream err(stderr);
+    const QStringList arguments = parser.positionalArguments();
+    const QString format = parser.value("format");
+    if (arguments.size() != 1 || (format != "json" && format != "chrome")) {
+        parser.showHelp(1);
+    }
+
+    QVector<Thread> threads;
+    QVector<Record> records;
+    quint64 startTime = 0;
+    QString error;
+    if (!readTrace(arguments.first(), threads, records, startTime, error)) {
+        err << "tracedump: " << arguments.first() << ": " << error << Qt::endl;
+        return 1;
+    }
+
+    QFile output;
+    if (parser.isSet("output")) {
+        output.setFileName(parser.value("output"));
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            err << "tracedump: " << output.fileName() << ": " << output.errorString() << Qt::endl;
+            return 1;
+        }
+    } else {
+        output.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+
+    QTextStream out(&output);
+    if (format == "chrome") {
+        writeChrome(out, threads, records, startTime);
+    } else {
+        writeJson(out, threads, records, startTime);
+    }
+    out.flush();
+
+    quint64 dropped = 0;
+    for (const Thread &thread : threads) {
+        dropped += thread.dropped;
+    }
+    err << records.size() << " events from " << threads.size() << " threads";
+    if (dropped > 0) {
+        err << " (" << dropped << " overwritten before the trace was saved)";
+    }
+    err << Qt::endl;
+    return 0;
+}
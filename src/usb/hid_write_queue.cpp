@@ -0,0 +1,244 @@
+/*---------------------------------------------------------*\
+|| hid_write_queue.cpp                                     |
+||                                                         |
+||   Asynchronous, coalescing write queue for hidraw      |
+||                                                         |
+||   This file is part of the L-Connect project           |
+||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "hid_write_queue.h"
+#include "../utils/trace.h"
+#include <algorithm>
+#include <unistd.h>
+#include <fcntl.h>
+
+// HID Device Implementation
+bool HIDDevice::Open(const std::string& devicePath) {
+    Close();
+    path = devicePath;
+
+    fd = open(devicePath.c_str(), O_RDWR);
+    if (fd < 0) {
+        return false;
+    }
+
+    isOpen = true;
+    return true;
+}
+
+void HIDDevice::Close() {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    isOpen = false;
+}
+
+bool HIDDevice::Write(const uint8_t* data, size_t length) {
+    if (!isOpen || fd < 0) {
+        return false;
+    }
+
+    ssize_t result = write(fd, data, length);
+    return result == static_cast<ssize_t>(length);
+}
+
+// HID Write Queue Implementation
+HIDWriteQueue::HIDWriteQueue()
+    : m_stopping(false)
+    , m_running(false)
+    , m_busy(false)
+    , m_coalesced(0)
+{
+}
+
+HIDWriteQueue::~HIDWriteQueue() {
+    Close();
+}
+
+bool HIDWriteQueue::Open(const std::string& devicePath) {
+    Close();
+
+    if (!m_device.Open(devicePath)) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = false;
+        m_running = true;
+        m_lastWrite = std::chrono::steady_clock::time_point{};
+    }
+    m_thread = std::thread(&HIDWriteQueue::Run, this);
+    return true;
+}
+
+void HIDWriteQueue::Close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_stopping = true;
+    }
+    m_workCv.notify_all();
+    m_spaceCv.notify_all();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = false;
+    m_device.Close();
+}
+
+bool HIDWriteQueue::IsOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running && !m_stopping;
+}
+
+std::future<bool> HIDWriteQueue::Submit(HIDCommand command) {
+    std::promise<bool> promise;
+    std::future<bool> future = promise.get_future();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_running || m_stopping) {
+        promise.set_value(false);
+        return future;
+    }
+
+    Entry entry;
+    entry.command = std::move(command);
+    entry.waiters.push_back(std::move(promise));
+    entry.queued = std::chrono::steady_clock::now();
+
+    // Collapse a superseded command for the same channel
+    if (entry.command.kind != HIDCommandKind::Delay) {
+        auto it = std::find_if(m_pending.begin(), m_pending.end(), [&](const Entry& e) {
+            return e.command.kind == entry.command.kind && e.command.channel == entry.command.channel;
+        });
+        if (it != m_pending.end()) {
+            for (std::promise<bool>& waiter : it->waiters) {
+                entry.waiters.push_back(std::move(waiter));
+            }
+            entry.queued = it->queued;
+            m_pending.erase(it);
+            ++m_coalesced;
+        }
+    }
+
+    m_spaceCv.wait(lock, [this] { return m_pending.size() < kMaxPending || m_stopping; });
+    if (m_stopping) {
+        for (std::promise<bool>& waiter : entry.waiters) {
+            waiter.set_value(false);
+        }
+        return future;
+    }
+
+    m_pending.push_back(std::move(entry));
+    lock.unlock();
+    m_workCv.notify_one();
+    return future;
+}
+
+void HIDWriteQueue::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idleCv.wait(lock, [this] { return (m_pending.empty() && !m_busy) || !m_running; });
+}
+
+void HIDWriteQueue::SetErrorHandler(ErrorHandler handler) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_errorHandler = std::move(handler);
+}
+
+size_t HIDWriteQueue::PendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending.size();
+}
+
+uint64_t HIDWriteQueue::CoalescedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_coalesced;
+}
+
+void HIDWriteQueue::Run() {
+    Trace::setThreadName("hid-io");
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (;;) {
+        m_workCv.wait(lock, [this] { return !m_pending.empty() || m_stopping; });
+        if (m_pending.empty()) {
+            break; // stopping and fully drained
+        }
+
+        // Pacing is enforced here instead of sleeping in the caller. The front
+        // entry may be replaced while we wait, so re-evaluate after waking.
+        auto due = m_lastWrite + m_pending.front().command.gap;
+        if (std::chrono::steady_clock::now() < due) {
+            m_workCv.wait_until(lock, due);
+            continue;
+        }
+
+        Entry entry = std::move(m_pending.front());
+        m_pending.pop_front();
+        m_busy = true;
+        lock.unlock();
+        m_spaceCv.notify_one();
+
+        bool result = WriteEntry(entry);
+        for (std::promise<bool>& waiter : entry.waiters) {
+            waiter.set_value(result);
+        }
+
+        lock.lock();
+        if (!result && m_errorHandler) {
+            ErrorHandler handler = m_errorHandler;
+            lock.unlock();
+            handler(entry.command);
+            lock.lock();
+        }
+        m_busy = false;
+        if (m_pending.empty()) {
+            m_idleCv.notify_all();
+        }
+    }
+
+    m_idleCv.notify_all();
+}
+
+bool HIDWriteQueue::WriteEntry(const Entry& entry) {
+    if (entry.command.kind == HIDCommandKind::Delay) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lastWrite = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    bool result = true;
+    for (size_t i = 0; i < entry.command.reports.size(); ++i) {
+        if (i > 0) {
+            std::this_thread::sleep_for(kWritePacing);
+        }
+        const std::vector<uint8_t>& report = entry.command.reports[i];
+        const auto start = std::chrono::steady_clock::now();
+        bool written = m_device.Write(report.data(), report.size());
+        result &= written;
+
+        if (Trace::isEnabled()) {
+            using Micros = std::chrono::duration<float, std::micro>;
+            const uint32_t opcode = report.size() > 1 ? report[1] : 0;
+            TRACE_EVENT(Trace::EventType::HidWrite, entry.command.channel,
+                        written ? 0 : Trace::FlagFailed,
+                        opcode | uint32_t(entry.command.kind) << 8 | uint32_t(report.size()) << 16,
+                        Micros(start - entry.queued).count(),
+                        Micros(std::chrono::steady_clock::now() - start).count(),
+                        float(i));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lastWrite = std::chrono::steady_clock::now();
+    return result;
+}
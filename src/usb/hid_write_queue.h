@@ -0,0 +1,124 @@
+/*---------------------------------------------------------*\
+|| hid_write_queue.h                                       |
+||                                                         |
+||   Asynchronous, coalescing write queue for hidraw      |
+||   Owns the device fd and a dedicated I/O thread         |
+||                                                         |
+||   This file is part of the L-Connect project           |
+||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Simplified HID interface without external dependencies
+struct HIDDevice {
+    int fd;
+    std::string path;
+    bool isOpen;
+
+    HIDDevice() : fd(-1), isOpen(false) {}
+    ~HIDDevice() { Close(); }
+
+    bool Open(const std::string& devicePath);
+    void Close();
+    bool Write(const uint8_t* data, size_t length);
+    bool IsOpen() const { return isOpen; }
+};
+
+// What a queued command does. Frame and Commit commands are coalesced per
+// channel; Delay only holds off the next write and is never merged.
+enum class HIDCommandKind : uint8_t {
+    Frame,   // StartAction + ColorData for one channel
+    Commit,  // CommitAction (effect/speed/direction/brightness) for one channel
+    Stream,  // ColorData alone, for one channel in direct mode
+    Delay,   // No reports, just a gap before the next write
+};
+
+struct HIDCommand {
+    HIDCommandKind kind = HIDCommandKind::Frame;
+    uint8_t channel = 0;
+    // Minimum time since the previous write before this command may go out
+    std::chrono::milliseconds gap{5};
+    // Reports written back to back (paced) when the command runs
+    std::vector<std::vector<uint8_t>> reports;
+};
+
+// Single-writer queue in front of a hidraw node.
+//
+// Only the I/O thread touches the fd once the queue is open, so callers on
+// the GUI thread never block on write() or on the inter-report pacing the
+// hub needs. A new Frame/Commit for a channel that still has one pending
+// replaces it: the stale command is dropped, the new one goes to the back
+// of the queue (so a Commit always follows the Frame it belongs to) and all
+// waiters of the dropped command receive the result of its replacement.
+class HIDWriteQueue {
+public:
+    static constexpr size_t kMaxPending = 64;
+    static constexpr std::chrono::milliseconds kWritePacing{5};
+
+    HIDWriteQueue();
+    ~HIDWriteQueue();
+
+    HIDWriteQueue(const HIDWriteQueue&) = delete;
+    HIDWriteQueue& operator=(const HIDWriteQueue&) = delete;
+
+    // Opens the device and starts the I/O thread
+    bool Open(const std::string& devicePath);
+    // Drains pending commands, stops the I/O thread and closes the device
+    void Close();
+    bool IsOpen() const;
+
+    // Queues a command. Blocks only if kMaxPending distinct commands are
+    // already waiting; the future resolves once the reports were written.
+    std::future<bool> Submit(HIDCommand command);
+
+    // Waits until every command queued so far has been written
+    void Flush();
+
+    // Called on the I/O thread for every command whose reports could not
+    // all be written, so fire-and-forget callers still hear about it
+    using ErrorHandler = std::function<void(const HIDCommand& command)>;
+    void SetErrorHandler(ErrorHandler handler);
+
+    // Statistics
+    size_t PendingCount() const;
+    uint64_t CoalescedCount() const;
+
+private:
+    struct Entry {
+        HIDCommand command;
+        std::vector<std::promise<bool>> waiters;
+        // Submit time of the oldest command this entry stands for
+        std::chrono::steady_clock::time_point queued;
+    };
+
+    void Run();
+    bool WriteEntry(const Entry& entry);
+
+    HIDDevice m_device;
+    std::thread m_thread;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workCv;   // I/O thread waits for work / deadlines
+    std::condition_variable m_spaceCv;  // producers wait for space
+    std::condition_variable m_idleCv;   // Flush() waits for an empty queue
+    std::deque<Entry> m_pending;
+    ErrorHandler m_errorHandler;
+    bool m_stopping;
+    bool m_running;
+    bool m_busy;
+    uint64_t m_coalesced;
+
+    std::chrono::steady_clock::time_point m_lastWrite;
+};
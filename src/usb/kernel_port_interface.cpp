@@ -0,0 +1,364 @@
+/*---------------------------------------------------------*\
+|| kernel_port_interface.cpp                               |
+||                                                         |
+||   Cached accessor for the SL Infinity kernel driver's  |
+||   /proc/Lian_li_SL_INFINITY interface                   |
+||                                                         |
+||   This file is part of the L-Connect project           |
+||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "kernel_port_interface.h"
+#include "../utils/debugutil.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static const char* const kProcRoot = "/proc/Lian_li_SL_INFINITY";
+
+KernelPortInterface& KernelPortInterface::Instance()
+{
+    static KernelPortInterface instance;
+    return instance;
+}
+
+KernelPortInterface::KernelPortInterface()
+    : m_loggingFd(-1)
+    , m_fanSpeedsFd(-1)
+    , m_hwmonScanned(false)
+    , m_batchUnsupported(false)
+{
+    for (auto& portFds : m_fds) {
+        portFds.fill(-1);
+    }
+    m_pwmFds.fill(-1);
+    m_lastSpeeds.fill(-1);
+}
+
+KernelPortInterface::~KernelPortInterface()
+{
+    Close();
+}
+
+std::string KernelPortInterface::NodePath(int port, Node node)
+{
+    static const char* const names[NODE_PORT_COUNT] = { "fan_speed", "fan_connected", "fan_config" };
+    return std::string(kProcRoot) + "/Port_" + std::to_string(port) + "/" + names[node];
+}
+
+std::string KernelPortInterface::FindHwmonDir()
+{
+    const std::string root = "/sys/class/hwmon";
+    std::string found;
+
+    DIR* dir = opendir(root.c_str());
+    if (!dir) {
+        return found;
+    }
+
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        std::string path = root + "/" + entry->d_name;
+        int fd = open((path + "/name").c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        char name[32] = {};
+        ssize_t len = read(fd, name, sizeof(name) - 1);
+        close(fd);
+        if (len <= 0) {
+            continue;
+        }
+        std::string chip(name, len);
+        while (!chip.empty() && (chip.back() == '\n' || chip.back() == ' ')) {
+            chip.pop_back();
+        }
+        if (chip == kHwmonName) {
+            found = path;
+            break;
+        }
+    }
+    closedir(dir);
+    return found;
+}
+
+void KernelPortInterface::ResetHwmon()
+{
+    for (int& fd : m_pwmFds) {
+        CloseFd(fd);
+    }
+    m_hwmonDir.clear();
+    m_hwmonScanned = false;
+}
+
+std::string KernelPortInterface::HwmonPath()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_hwmonScanned) {
+        m_hwmonDir = FindHwmonDir();
+        m_hwmonScanned = true;
+    }
+    return m_hwmonDir;
+}
+
+bool KernelPortInterface::IsAvailable()
+{
+    if (!HwmonPath().empty()) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return NodeFd(m_fds[0][NODE_FAN_SPEED], NodePath(1, NODE_FAN_SPEED), true) >= 0;
+}
+
+bool KernelPortInterface::SetFanSpeed(int port, int percent)
+{
+    if (!ValidPort(port) || percent < 0 || percent > 100) {
+        return false;
+    }
+
+    std::string hwmon = HwmonPath();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!hwmon.empty()) {
+        // pwmN is 0-255; the driver scales it back to the hub's 0-100%
+        int pwm = (percent * 255 + 50) / 100;
+        if (WriteNode(m_pwmFds[port - 1], hwmon + "/pwm" + std::to_string(port), std::to_string(pwm))) {
+            m_lastSpeeds[port - 1] = percent;
+            return true;
+        }
+
+        // EBUSY: pwmN_enable is 0 (full speed), a setting the proc node
+        // would silently undo. Only a vanished chip means rescanning
+        int err = errno;
+        if (err == EBUSY) {
+            DEBUG_PRINTF_CATEGORY("FanSpeeds", "Port %d is at full speed (pwm%d_enable=0), not written\n", port, port);
+            return false;
+        }
+        if (err == ENOENT || err == ENODEV || err == ENXIO || err == EBADF || err == EIO) {
+            ResetHwmon();
+        }
+    }
+
+    bool ok = WriteNode(m_fds[port - 1][NODE_FAN_SPEED], NodePath(port, NODE_FAN_SPEED), std::to_string(percent));
+    m_lastSpeeds[port - 1] = ok ? percent : -1;
+    return ok;
+}
+
+bool KernelPortInterface::SetFanSpeeds(const std::array<int, kPortCount>& percents)
+{
+    for (int percent : percents) {
+        if (percent < 0 || percent > 100) {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_batchUnsupported) {
+        std::string text;
+        for (int i = 0; i < kPortCount; ++i) {
+            text += (i ? " " : "") + std::to_string(percents[i]);
+        }
+
+        if (WriteNode(m_fanSpeedsFd, std::string(kProcRoot) + "/fan_speeds", text)) {
+            m_lastSpeeds = percents;
+            return true;
+        }
+
+        // Only a missing node or one that rejects the format means the
+        // driver predates fan_speeds; EIO and friends (hub replugging,
+        // module reload) are retried on the next call
+        int err = errno;
+        if ((err != ENOENT && err != EINVAL) || access(kProcRoot, F_OK) != 0) {
+            return false;
+        }
+        m_batchUnsupported = true;
+        DEBUG_PRINTF_CATEGORY("FanSpeeds", "fan_speeds not supported by the loaded driver, using per-port writes\n");
+    }
+
+    bool ok = true;
+    for (int i = 0; i < kPortCount; ++i) {
+        if (m_lastSpeeds[i] == percents[i]) {
+            continue;
+        }
+        if (WriteNode(m_fds[i][NODE_FAN_SPEED], NodePath(i + 1, NODE_FAN_SPEED), std::to_string(percents[i]))) {
+            m_lastSpeeds[i] = percents[i];
+        } else {
+            m_lastSpeeds[i] = -1;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int KernelPortInterface::GetFanSpeed(int port)
+{
+    if (!ValidPort(port)) {
+        return -1;
+    }
+
+    std::string hwmon = HwmonPath();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    int value = -1;
+    if (!hwmon.empty()) {
+        if (ReadNode(m_pwmFds[port - 1], hwmon + "/pwm" + std::to_string(port), true, value)) {
+            return (value * 100 + 127) / 255;
+        }
+        ResetHwmon();
+    }
+
+    if (!ReadNode(m_fds[port - 1][NODE_FAN_SPEED], NodePath(port, NODE_FAN_SPEED), true, value)) {
+        return -1;
+    }
+    return value;
+}
+
+bool KernelPortInterface::IsFanConnected(int port)
+{
+    if (!ValidPort(port)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CachedFlag& cached = m_connected[port - 1];
+    auto now = std::chrono::steady_clock::now();
+    if (cached.valid && now - cached.stamp < kConnectedCacheTTL) {
+        return cached.value;
+    }
+
+    int value = 0;
+    if (!ReadNode(m_fds[port - 1][NODE_FAN_CONNECTED], NodePath(port, NODE_FAN_CONNECTED), false, value)) {
+        // If we can't read the status, assume not connected (and don't cache it)
+        cached.valid = false;
+        return false;
+    }
+
+    cached.valid = true;
+    cached.value = (value != 0);
+    cached.stamp = now;
+    return cached.value;
+}
+
+bool KernelPortInterface::SetFanConfig(int port, bool connected)
+{
+    if (!ValidPort(port)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_connected[port - 1].valid = false;
+    return WriteNode(m_fds[port - 1][NODE_FAN_CONFIG], NodePath(port, NODE_FAN_CONFIG), connected ? "1" : "0");
+}
+
+bool KernelPortInterface::SetLoggingEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return WriteNode(m_loggingFd, std::string(kProcRoot) + "/logging_enabled", enabled ? "1" : "0");
+}
+
+void KernelPortInterface::InvalidateCache()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (CachedFlag& cached : m_connected) {
+        cached.valid = false;
+    }
+}
+
+void KernelPortInterface::Close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& portFds : m_fds) {
+        for (int& fd : portFds) {
+            CloseFd(fd);
+        }
+    }
+    CloseFd(m_loggingFd);
+    CloseFd(m_fanSpeedsFd);
+    ResetHwmon();
+    m_batchUnsupported = false;
+    m_lastSpeeds.fill(-1);
+    for (CachedFlag& cached : m_connected) {
+        cached.valid = false;
+    }
+}
+
+int KernelPortInterface::NodeFd(int& fd, const std::string& path, bool writable)
+{
+    if (fd < 0) {
+        fd = open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+    }
+    return fd;
+}
+
+void KernelPortInterface::CloseFd(int& fd)
+{
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+bool KernelPortInterface::WriteNode(int& fd, const std::string& path, const std::string& text)
+{
+    const ssize_t len = static_cast<ssize_t>(text.size());
+
+    // Second attempt runs on a freshly opened fd: after a module reload the
+    // old proc entry is gone and every access on it fails with EIO
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (NodeFd(fd, path, true) < 0) {
+            int err = errno;
+            DEBUG_PRINTF_CATEGORY("FanSpeeds", "Failed to open %s\n", path.c_str());
+            errno = err;
+            return false;
+        }
+
+        ssize_t written = pwrite(fd, text.data(), text.size(), 0);
+        if (written == len) {
+            return true;
+        }
+
+        // Short writes count as a rejected value
+        int err = written >= 0 ? EINVAL : errno;
+        CloseFd(fd);
+        DEBUG_PRINTF_CATEGORY("FanSpeeds", "Write to %s failed (errno %d), reopening\n", path.c_str(), err);
+        errno = err;
+        if (err == EINVAL || err == EBUSY) {
+            // The driver rejected the value; reopening won't help
+            return false;
+        }
+    }
+    return false;
+}
+
+bool KernelPortInterface::ReadNode(int& fd, const std::string& path, bool writable, int& value)
+{
+    char buf[16];
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (NodeFd(fd, path, writable) < 0) {
+            return false;
+        }
+
+        ssize_t len = pread(fd, buf, sizeof(buf) - 1, 0);
+        if (len > 0) {
+            buf[len] = '\0';
+            char* end = nullptr;
+            long parsed = std::strtol(buf, &end, 10);
+            if (end == buf) {
+                return false;
+            }
+            value = static_cast<int>(parsed);
+            return true;
+        }
+
+        CloseFd(fd);
+    }
+    return false;
+}
@@ -0,0 +1,113 @@
+/*---------------------------------------------------------*\
+|| kernel_port_interface.h                                 |
+||                                                         |
+||   Cached accessor for the SL Infinity kernel driver's  |
+||   /proc/Lian_li_SL_INFINITY interface                   |
+||                                                         |
+||   This file is part of the L-Connect project           |
+||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Single process-wide entry point to the kernel driver's procfs nodes.
+//
+// Every node is opened once and then accessed with pread()/pwrite() at
+// offset 0, so a control tick costs one syscall per value instead of an
+// open/write/close triple. fan_connected only changes when fan_config is
+// written, so it is served from a short-lived cache that is invalidated by
+// SetFanConfig(). When the module is reloaded the old fds start failing;
+// the node is then reopened and the operation retried once.
+//
+// Drivers that register the "sl_infinity" hwmon chip are preferred for
+// single-port speed access (pwmN, one plain value per file); the proc tree
+// is still used for fan_connected/fan_config and the batched fan_speeds.
+//
+// Ports are numbered 1-4 like the /proc/.../Port_N directories.
+class KernelPortInterface
+{
+public:
+    static constexpr int kPortCount = 4;
+    static constexpr std::chrono::milliseconds kConnectedCacheTTL{1000};
+
+    static KernelPortInterface& Instance();
+
+    KernelPortInterface(const KernelPortInterface&) = delete;
+    KernelPortInterface& operator=(const KernelPortInterface&) = delete;
+
+    static constexpr const char* kHwmonName = "sl_infinity";
+
+    // True if the driver's proc tree or hwmon chip is present
+    bool IsAvailable();
+    // /sys/class/hwmon/hwmonN of the hub, or empty if not registered
+    std::string HwmonPath();
+
+    // Fan duty in percent (0-100); false without touching the port if its
+    // hwmon pwmN_enable is 0 (full speed)
+    bool SetFanSpeed(int port, int percent);
+    int GetFanSpeed(int port); // -1 on failure
+
+    // All four duties in one write through the hub-level fan_speeds node;
+    // the driver skips ports whose duty did not change. Drivers without
+    // that node get per-port writes for the ports that changed.
+    bool SetFanSpeeds(const std::array<int, kPortCount>& percents);
+
+    // User-configured fan presence
+    bool IsFanConnected(int port);
+    bool SetFanConfig(int port, bool connected);
+
+    bool SetLoggingEnabled(bool enabled);
+
+    // Drops cached values; the next read goes to the driver
+    void InvalidateCache();
+    // Closes every fd (they are reopened lazily)
+    void Close();
+
+private:
+    enum Node {
+        NODE_FAN_SPEED = 0,
+        NODE_FAN_CONNECTED,
+        NODE_FAN_CONFIG,
+        NODE_PORT_COUNT,
+    };
+
+    struct CachedFlag {
+        bool valid = false;
+        bool value = false;
+        std::chrono::steady_clock::time_point stamp;
+    };
+
+    KernelPortInterface();
+    ~KernelPortInterface();
+
+    static std::string NodePath(int port, Node node);
+    static std::string FindHwmonDir();
+    // Drops the hwmon location so the next access rescans (module reload)
+    void ResetHwmon();
+    static bool ValidPort(int port) { return port >= 1 && port <= kPortCount; }
+
+    // All helpers expect m_mutex to be held
+    // (writable nodes are opened O_RDWR so one fd serves reads and writes)
+    int  NodeFd(int& fd, const std::string& path, bool writable);
+    // On failure errno says why (EINVAL: value rejected)
+    bool WriteNode(int& fd, const std::string& path, const std::string& text);
+    bool ReadNode(int& fd, const std::string& path, bool writable, int& value);
+    void CloseFd(int& fd);
+
+    std::mutex m_mutex;
+    std::array<std::array<int, NODE_PORT_COUNT>, kPortCount> m_fds;
+    int m_loggingFd;
+    int m_fanSpeedsFd;
+    std::string m_hwmonDir;
+    bool m_hwmonScanned;
+    std::array<int, kPortCount> m_pwmFds;
+    bool m_batchUnsupported; // fan_speeds missing (older module), until Close()
+    std::array<int, kPortCount> m_lastSpeeds; // for the per-port fallback
+    std::array<CachedFlag, kPortCount> m_connected;
+};
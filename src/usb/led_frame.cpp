@@ -0,0 +1,128 @@
+/*---------------------------------------------------------*\
+|| led_frame.cpp                                           |
+||                                                         |
+||   LED buffer layout for one SL Infinity channel        |
+||                                                         |
+||   This file is part of the L-Connect project           |
+||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "led_frame.h"
+#include <algorithm>
+#include <cstring>
+
+float LedFrame::LimiterScale(const SLInfinityColor& color) {
+    int sum = color.r + color.b + color.g;
+    return sum > kLimit ? static_cast<float>(kLimit) / sum : 1.0f;
+}
+
+SLInfinityColor LedFrame::Scaled(const SLInfinityColor& color, float brightness) {
+    // Scale from the original color (like OpenRGB), truncating
+    float scale = brightness * LimiterScale(color);
+    SLInfinityColor out;
+    out.r = static_cast<uint8_t>(color.r * scale);
+    out.b = static_cast<uint8_t>(color.b * scale);
+    out.g = static_cast<uint8_t>(color.g * scale);
+    return out;
+}
+
+void LedFrame::Clear() {
+    memset(m_data, 0x00, sizeof(m_data));
+}
+
+void LedFrame::SetLed(int index, const SLInfinityColor& color) {
+    if (index < 0 || index >= kLedCount) {
+        return;
+    }
+    uint8_t* led = m_data + index * 3;
+    led[0] = color.r;
+    led[1] = color.b;  // RBG format!
+    led[2] = color.g;
+}
+
+SLInfinityColor LedFrame::Led(int index) const {
+    if (index < 0 || index >= kLedCount) {
+        return SLInfinityColor();
+    }
+    const uint8_t* led = m_data + index * 3;
+    return SLInfinityColor(led[0], led[2], led[1]);
+}
+
+void LedFrame::Fill(int first, int count, const SLInfinityColor& color) {
+    first = std::max(first, 0);
+    count = std::min(count, kLedCount - first);
+    if (count <= 0) {
+        return;
+    }
+
+    // One LED, then keep doubling the filled run
+    uint8_t* run = m_data + first * 3;
+    const size_t total = static_cast<size_t>(count) * 3;
+    run[0] = color.r;
+    run[1] = color.b;
+    run[2] = color.g;
+    size_t filled = 3;
+    while (filled < total) {
+        size_t chunk = std::min(filled, total - filled);
+        memcpy(run + filled, run, chunk);
+        filled += chunk;
+    }
+}
+
+void LedFrame::FillStrided(int first, int stride, int count, const SLInfinityColor& color) {
+    if (stride <= 0) {
+        return;
+    }
+    for (int i = 0, led = first; i < count && led < kLedCount; ++i, led += stride) {
+        SetLed(led, color);
+    }
+}
+
+void LedFrame::Build(const SLInfinityColor* colors, size_t count, float brightness, bool interleavedPattern) {
+    Clear();
+
+    // OpenRGB interleave: color j at (i * 12) + (j * 3) for i = 0-5
+    constexpr int kStride = 12;
+    constexpr int kRepeats = 6;
+
+    if (count == 0) {
+        return;
+    }
+
+    if (count == 1) {
+        Fill(0, kActiveLeds, Scaled(colors[0], brightness));
+    } else if (count == 2) {
+        // Colors 2 and 3 of the OpenRGB pattern are black. Color 2 is widened
+        // to LEDs 2-4 of every group so Meteor's trail is visible.
+        FillStrided(0, kStride, kRepeats, Scaled(colors[0], brightness));
+        SLInfinityColor second = Scaled(colors[1], brightness);
+        for (int offset = 2; offset <= 4; ++offset) {
+            FillStrided(offset, kStride, kRepeats, second);
+        }
+    } else if (count == 4 && interleavedPattern) {
+        // Tunnel
+        for (int j = 0; j < 4; ++j) {
+            FillStrided(j * 3, kStride, kRepeats, Scaled(colors[j], brightness));
+        }
+    } else if (count == 4) {
+        // Static: every fan solid in its own color
+        for (int fan = 0; fan < kFanCount; ++fan) {
+            Fill(fan * kLedsPerFan, kLedsPerFan, Scaled(colors[fan], 1.0f));
+        }
+    } else if (count == 3) {
+        // ColorCycle: LEDs 0-20, 21-42, 43-63
+        Fill(0, 21, Scaled(colors[0], 1.0f));
+        Fill(21, 22, Scaled(colors[1], 1.0f));
+        Fill(43, 21, Scaled(colors[2], 1.0f));
+    } else {
+        // 5+ colors: scale each once, then cycle them over the LEDs
+        SLInfinityColor scaled[kActiveLeds];
+        size_t distinct = std::min(count, static_cast<size_t>(kActiveLeds));
+        for (size_t i = 0; i < distinct; ++i) {
+            scaled[i] = Scaled(colors[i], 1.0f);
+        }
+        for (int i = 0; i < kActiveLeds; ++i) {
+            SetLed(i, scaled[i % count]);
+        }
+    }
+}
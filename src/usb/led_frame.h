@@ -0,0 +1,77 @@
+/*---------------------------------------------------------*\
+|| led_frame.h                                             |
+||                                                         |
+||   LED buffer layout for one SL Infinity channel        |
+||                                                         |
+||   This file is part of the L-Connect project           |
+||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// SL Infinity Color Structure (RBG format)
+struct SLInfinityColor {
+    uint8_t r;
+    uint8_t b;  // Blue comes before Green!
+    uint8_t g;
+    
+    SLInfinityColor() : r(0), b(0), g(0) {}
+    SLInfinityColor(uint8_t red, uint8_t green, uint8_t blue) : r(red), b(blue), g(green) {}
+    
+    static SLInfinityColor fromRGB(uint8_t red, uint8_t green, uint8_t blue) {
+        return SLInfinityColor(red, green, blue);
+    }
+};
+
+// The 80 x 3 byte RBG payload of one channel's ColorData report.
+//
+// Colors are scaled once per color (brightness times the 460 limiter that
+// protects the LEDs, like OpenRGB), never per LED. Runs of one color are
+// written as one LED and then doubled with memcpy, so a solid fill is a
+// handful of vectorised copies. The frame lives inline (no heap) and Build()
+// rewrites all of it, so one frame can be reused for every call.
+//
+// Nothing here touches the device; it only depends on this header.
+class LedFrame {
+public:
+    static constexpr int kLedCount = 80;   // OpenRGB sends (num_fans + 1) * 16
+    static constexpr int kFanCount = 4;
+    static constexpr int kLedsPerFan = 16;
+    static constexpr int kActiveLeds = kFanCount * kLedsPerFan;
+    static constexpr int kSize = kLedCount * 3;
+    static constexpr int kLimit = 460;     // max r + g + b per LED
+
+    LedFrame() { Clear(); }
+
+    // Lays out colors the way SetChannelColors always has:
+    //   0 colors   black
+    //   1 color    all 64 LEDs, brightness applied
+    //   2 colors   interleaved every 12 LEDs (Tide, Runway, Meteor)
+    //   3 colors   three bands (ColorCycle)
+    //   4 colors   interleaved (Tunnel) or solid per fan (Static)
+    //   5+ colors  cycled LED by LED
+    // Only the 1, 2 and interleaved 4 color layouts apply brightness; the
+    // others only the limiter.
+    void Build(const SLInfinityColor* colors, size_t count, float brightness, bool interleavedPattern);
+
+    void Clear();
+    // count LEDs from first, one color
+    void Fill(int first, int count, const SLInfinityColor& color);
+    // count LEDs first, first + stride, ...
+    void FillStrided(int first, int stride, int count, const SLInfinityColor& color);
+    void SetLed(int index, const SLInfinityColor& color);
+    SLInfinityColor Led(int index) const;
+
+    const uint8_t* Data() const { return m_data; }
+
+    // Factor that keeps r + g + b within kLimit
+    static float LimiterScale(const SLInfinityColor& color);
+    // Color as sent: each channel times brightness * LimiterScale(color)
+    static SLInfinityColor Scaled(const SLInfinityColor& color, float brightness);
+
+private:
+    alignas(16) uint8_t m_data[kSize];
+};
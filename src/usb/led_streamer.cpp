@@ -0,0 +1,195 @@
+/*---------------------------------------------------------*\
+|| led_streamer.cpp                                        |
+||                                                         |
+||   Host-driven LED streaming ("direct mode") at a fixed  |
+||   frame rate                                            |
+||                                                         |
+||   This file is part of the L-Connect project           |
+||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "led_streamer.h"
+#include "../utils/debugutil.h"
+#include <algorithm>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+
+LedStreamer::LedStreamer(SendFunction send)
+    : m_send(std::move(send))
+    , m_running(false)
+    , m_stopping(false)
+    , m_period(std::chrono::nanoseconds(1000000000 / 30))
+    , m_mask(0)
+{
+    m_versions.fill(0);
+}
+
+LedStreamer::~LedStreamer() {
+    Stop();
+}
+
+void LedStreamer::Start(int fps, uint8_t channelMask) {
+    Stop();
+
+    fps = std::clamp(fps, kMinFps, kMaxFps);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = false;
+        m_period = std::chrono::nanoseconds(1000000000 / fps);
+        m_mask = channelMask;
+    }
+
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread(&LedStreamer::Run, this);
+    DEBUG_PRINTF("LedStreamer: streaming channel mask 0x%02X at %d FPS\n", channelMask, fps);
+}
+
+void LedStreamer::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_stopCv.notify_all();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_running.store(false, std::memory_order_release);
+}
+
+void LedStreamer::SetFrame(uint8_t channel, const LedFrame& frame) {
+    if (channel >= kChannelCount) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frames[channel] = frame;
+    ++m_versions[channel];
+}
+
+void LedStreamer::SetRenderer(RenderFunction render) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_render = std::move(render);
+}
+
+LedStreamer::Stats LedStreamer::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void LedStreamer::ResetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = Stats();
+}
+
+void LedStreamer::Run() {
+    // Best effort: frame timing matters more than anything else on this thread
+    sched_param param{};
+    param.sched_priority = kRealtimePriority;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+        DEBUG_PRINTF("LedStreamer: SCHED_FIFO not permitted, using the default scheduler\n");
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    // Versions already on the device; 0 never matches a set frame
+    std::array<uint64_t, kChannelCount> sent;
+    sent.fill(0);
+
+    std::array<LedFrame, kChannelCount> frames;
+    std::array<std::future<bool>, kChannelCount> writes;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start;
+
+    while (!m_stopping) {
+        // Software effect: draw this period's frames without the lock held
+        if (m_render) {
+            RenderFunction render = m_render;
+            const uint8_t mask = m_mask;
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            lock.unlock();
+            for (int channel = 0; channel < kChannelCount; ++channel) {
+                if (mask & (1 << channel)) {
+                    render(static_cast<uint8_t>(channel), seconds, frames[channel]);
+                }
+            }
+            lock.lock();
+            for (int channel = 0; channel < kChannelCount; ++channel) {
+                if ((mask & (1 << channel)) && (m_versions[channel] == 0 ||
+                    memcmp(frames[channel].Data(), m_frames[channel].Data(), LedFrame::kSize) != 0)) {
+                    m_frames[channel] = frames[channel];
+                    ++m_versions[channel];
+                }
+            }
+        }
+
+        deadline += m_period;
+
+        // Take the changed frames under the lock, send them without it
+        uint8_t changed = 0;
+        for (int channel = 0; channel < kChannelCount; ++channel) {
+            if (!(m_mask & (1 << channel))) {
+                continue;
+            }
+            if (m_versions[channel] != sent[channel]) {
+                frames[channel] = m_frames[channel];
+                sent[channel] = m_versions[channel];
+                changed |= 1 << channel;
+            } else {
+                ++m_stats.channelsSkipped;
+            }
+        }
+
+        if (changed) {
+            lock.unlock();
+
+            for (int channel = 0; channel < kChannelCount; ++channel) {
+                if (changed & (1 << channel)) {
+                    writes[channel] = m_send(static_cast<uint8_t>(channel), frames[channel]);
+                }
+            }
+
+            // Deadline tracking: everything should be on the device by the
+            // time the next frame is due
+            uint64_t written = 0;
+            uint64_t failed = 0;
+            bool late = false;
+            for (int channel = 0; channel < kChannelCount; ++channel) {
+                if (!(changed & (1 << channel))) {
+                    continue;
+                }
+                if (writes[channel].wait_until(deadline) != std::future_status::ready) {
+                    late = true;
+                }
+                if (writes[channel].get()) {
+                    ++written;
+                } else {
+                    ++failed;
+                }
+            }
+
+            lock.lock();
+            ++m_stats.frames;
+            m_stats.channelsSent += written;
+            m_stats.failed += failed;
+
+            // Skip the periods that went by instead of sending them late
+            Clock::time_point now = Clock::now();
+            if (late || now > deadline) {
+                auto lateness = std::chrono::duration_cast<std::chrono::microseconds>(now - deadline);
+                m_stats.worstLateness = std::max(m_stats.worstLateness, lateness);
+                uint64_t missed = 1 + (now - deadline) / m_period;
+                m_stats.dropped += missed;
+                deadline += m_period * missed;
+            }
+        }
+
+        m_stopCv.wait_until(lock, deadline, [this] { return m_stopping; });
+    }
+
+    DEBUG_PRINTF("LedStreamer: stopped after %llu frames, %llu dropped\n",
+                 static_cast<unsigned long long>(m_stats.frames), static_cast<unsigned long long>(m_stats.dropped));
+}
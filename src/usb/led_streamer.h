@@ -0,0 +1,99 @@
+/*---------------------------------------------------------*\
+|| led_streamer.h                                          |
+||                                                         |
+||   Host-driven LED streaming ("direct mode") at a fixed  |
+||   frame rate                                            |
+||                                                         |
+||   This file is part of the L-Connect project           |
+||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include "led_frame.h"
+
+// Pushes the latest LedFrame of every active channel to the hub once per
+// frame period, from its own thread.
+//
+// Producers (any thread) only hand over frames with SetFrame(); the newest
+// one per channel wins. Each period the streamer sends one ColorData report
+// for every active channel whose frame changed since it was last sent, then
+// waits for those writes until the next deadline. Writes that miss it count
+// as a dropped frame, and periods that went by meanwhile are skipped rather
+// than sent late, so a slow hub lowers the frame rate instead of building
+// up latency.
+//
+// The hub paces reports ~5 ms apart, so the achievable rate is roughly
+// 1000 / (5 * changed channels) FPS; the stats show how close it gets.
+// The thread asks for SCHED_FIFO and keeps the default policy if that is
+// not permitted.
+class LedStreamer {
+public:
+    static constexpr int kChannelCount = 8;
+    static constexpr int kMinFps = 1;
+    static constexpr int kMaxFps = 60;
+    static constexpr int kRealtimePriority = 10;
+
+    // Sends one channel's ColorData; resolves once it reached the device
+    using SendFunction = std::function<std::future<bool>(uint8_t channel, const LedFrame& frame)>;
+    // Draws a channel's frame for the time since Start(), on the streaming thread
+    using RenderFunction = std::function<void(uint8_t channel, double seconds, LedFrame& frame)>;
+
+    struct Stats {
+        uint64_t frames = 0;          // periods that sent something
+        uint64_t channelsSent = 0;    // ColorData reports written
+        uint64_t channelsSkipped = 0; // active channels left alone, unchanged
+        uint64_t dropped = 0;         // periods missed because writes ran late
+        uint64_t failed = 0;          // reports the device rejected
+        std::chrono::microseconds worstLateness{0};
+    };
+
+    explicit LedStreamer(SendFunction send);
+    ~LedStreamer();
+
+    LedStreamer(const LedStreamer&) = delete;
+    LedStreamer& operator=(const LedStreamer&) = delete;
+
+    // Streams channels in channelMask (bit n = channel n) at fps; restarts
+    // if already running. Frames set before Start() are sent first.
+    void Start(int fps, uint8_t channelMask);
+    void Stop();
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // Latest frame for a channel; cheap, never waits for the device
+    void SetFrame(uint8_t channel, const LedFrame& frame);
+    // With a renderer every active channel is drawn at the start of each
+    // period instead (frames that come out the same still count as
+    // unchanged); an empty function goes back to SetFrame()
+    void SetRenderer(RenderFunction render);
+
+    Stats GetStats() const;
+    void ResetStats();
+
+private:
+    void Run();
+
+    SendFunction m_send;
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+
+    // Guarded by m_mutex
+    mutable std::mutex m_mutex;
+    std::condition_variable m_stopCv;
+    bool m_stopping;
+    std::chrono::nanoseconds m_period;
+    uint8_t m_mask;
+    std::array<LedFrame, kChannelCount> m_frames;
+    std::array<uint64_t, kChannelCount> m_versions; // bumped by SetFrame()
+    RenderFunction m_render;
+    Stats m_stats;
+};
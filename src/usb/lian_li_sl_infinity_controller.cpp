@@ -9,12 +9,12 @@
 \*---------------------------------------------------------*/
 
 #include "lian_li_sl_infinity_controller.h"
+#include "kernel_port_interface.h"
 #include "../utils/debugutil.h"
 #include <iostream>
 #include <cstring>
 #include <chrono>
 #include <thread>
-#include <fstream>
 
 using namespace std::chrono_literals;
 
@@ -385,17 +385,11 @@ bool LianLiSLInfinityController::SetChannelSpeed(uint8_t channel, uint8_t speed)
     }
 
     // Use kernel driver for fan control (more reliable than direct HID)
-    std::string procPath = "/proc/Lian_li_SL_INFINITY/Port_" + std::to_string(channel + 1) + "/fan_speed";
-    
-    std::ofstream file(procPath);
-    if (file.is_open()) {
-        file << (int)speed;
-        file.close();
-        
+    if (KernelPortInterface::Instance().SetFanSpeed(channel + 1, speed)) {
         DEBUG_PRINTF_CATEGORY("FanSpeeds", "Successfully set Port %d to %d%% via kernel driver\n", (channel + 1), (int)speed);
         return true;
     } else {
-        DEBUG_PRINTF_CATEGORY("FanSpeeds", "Failed to open %s for writing\n", procPath.c_str());
+        DEBUG_PRINTF_CATEGORY("FanSpeeds", "Failed to write Port %d fan_speed\n", (channel + 1));
         return false;
     }
 }
@@ -461,14 +455,8 @@ bool LianLiSLInfinityController::GetChannelSpeed(uint8_t channel, uint8_t& speed
     }
 
     // Read speed from kernel driver's /proc interface
-    std::string procPath = "/proc/Lian_li_SL_INFINITY/Port_" + std::to_string(channel + 1) + "/fan_speed";
-    
-    std::ifstream file(procPath);
-    if (file.is_open()) {
-        int speedValue;
-        file >> speedValue;
-        file.close();
-        
+    int speedValue = KernelPortInterface::Instance().GetFanSpeed(channel + 1);
+    if (speedValue != -1) {
         if (speedValue >= 0 && speedValue <= 100) {
             speed = static_cast<uint8_t>(speedValue);
             DEBUG_PRINTF_CATEGORY("FanSpeeds", "Read Port %d speed: %d%% from kernel driver\n", (channel + 1), (int)speed);
@@ -478,7 +466,7 @@ bool LianLiSLInfinityController::GetChannelSpeed(uint8_t channel, uint8_t& speed
             return false;
         }
     } else {
-        std::cout << "Failed to open " << procPath << " for reading" << std::endl;
+        std::cout << "Failed to read Port " << (channel + 1) << " fan_speed" << std::endl;
         return false;
     }
 }
@@ -486,6 +474,5 @@ bool LianLiSLInfinityController::GetChannelSpeed(uint8_t channel, uint8_t& speed
 bool LianLiSLInfinityController::IsKernelDriverAvailable() const
 {
     // Check if the kernel driver's /proc directory exists
-    std::ifstream file("/proc/Lian_li_SL_INFINITY/Port_1/fan_speed");
-    return file.good();
+    return KernelPortInterface::Instance().IsAvailable();
 }
@@ -10,38 +10,15 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <future>
+#include <memory>
 #include <string>
 #include <vector>
-
-// Simplified HID interface without external dependencies
-struct HIDDevice {
-    int fd;
-    std::string path;
-    bool isOpen;
-    
-    HIDDevice() : fd(-1), isOpen(false) {}
-    ~HIDDevice() { Close(); }
-    
-    bool Open(const std::string& devicePath);
-    void Close();
-    bool Write(const uint8_t* data, size_t length);
-    bool IsOpen() const { return isOpen; }
-};
-
-// SL Infinity Color Structure (RBG format)
-struct SLInfinityColor {
-    uint8_t r;
-    uint8_t b;  // Blue comes before Green!
-    uint8_t g;
-    
-    SLInfinityColor() : r(0), b(0), g(0) {}
-    SLInfinityColor(uint8_t red, uint8_t green, uint8_t blue) : r(red), b(blue), g(green) {}
-    
-    static SLInfinityColor fromRGB(uint8_t red, uint8_t green, uint8_t blue) {
-        return SLInfinityColor(red, green, blue);
-    }
-};
+#include "hid_write_queue.h"
+#include "led_frame.h"
+#include "led_streamer.h"
 
 // SL Infinity HID Controller
 class SLInfinityHIDController {
@@ -60,25 +37,59 @@ public:
     std::string GetSerialNumber() const;
     
     // LED control
+    // All writes go through the I/O thread of m_queue. The bool variants are
+    // fire-and-forget: true only means the command was queued (false: not
+    // connected or bad arguments), a failed write is reported later through
+    // SetWriteErrorHandler(). The Async variants resolve once the reports
+    // were actually written to the hub.
     // patternType: true = interleaved (for Tunnel), false = solid per fan (for Static)
     bool SetChannelColors(uint8_t channel, const std::vector<SLInfinityColor>& colors, float brightness = 1.0f, bool interleavedPattern = false);
+    std::future<bool> SetChannelColorsAsync(uint8_t channel, const std::vector<SLInfinityColor>& colors, float brightness = 1.0f, bool interleavedPattern = false);
     bool SetChannelMode(uint8_t channel, uint8_t mode);
     bool TurnOffChannel(uint8_t channel);
     bool TurnOffAllChannels();
     
-    // Public methods for testing
-    bool SendCommitAction(uint8_t channel, uint8_t effect, uint8_t speed, uint8_t direction, uint8_t brightness);
+    // settle: extra time the hub gets to process the preceding color data
+    bool SendCommitAction(uint8_t channel, uint8_t effect, uint8_t speed, uint8_t direction, uint8_t brightness,
+                          std::chrono::milliseconds settle = std::chrono::milliseconds(0));
+    std::future<bool> SendCommitActionAsync(uint8_t channel, uint8_t effect, uint8_t speed, uint8_t direction, uint8_t brightness,
+                                            std::chrono::milliseconds settle = std::chrono::milliseconds(0));
+    
+    // Direct mode: the host animates the LEDs itself. Every channel in
+    // channelMask is switched to static once, then only its ColorData is
+    // streamed at fps (see LedStreamer). Any preset write above (colors,
+    // commit, mode, off) ends direct mode first, so the streamer never
+    // overwrites a preset.
+    bool StartDirectMode(int fps, uint8_t channelMask);
+    void StopDirectMode();
+    bool IsDirectMode() const;
+    // Latest frame for a streamed channel; never blocks on the device
+    void SetDirectFrame(uint8_t channel, const LedFrame& frame);
+    // Or have every streamed channel drawn each frame (software effects)
+    void SetDirectRenderer(LedStreamer::RenderFunction render);
+    LedStreamer::Stats GetDirectStats() const;
+
+    // Called on the I/O thread when a queued write fails
+    void SetWriteErrorHandler(HIDWriteQueue::ErrorHandler handler);
+
+    // Holds off the next queued write without blocking the caller
+    void QueueDelay(std::chrono::milliseconds delay);
+    // Blocks until every queued write has reached the device
+    void Flush();
 
 private:
-    HIDDevice m_device;
+    HIDWriteQueue m_queue;
+    std::unique_ptr<LedStreamer> m_streamer;
     std::string m_deviceName;
     std::string m_firmwareVersion;
     std::string m_serialNumber;
     
     // Internal methods
     bool FindDevice();
-    bool SendStartAction(uint8_t channel, uint8_t numFans);
-    bool SendColorData(uint8_t channel, uint8_t numLeds, const uint8_t* ledData);
-    void ApplyColorLimiter(SLInfinityColor& color) const;
-    float CalculateBrightnessLimit(const SLInfinityColor& color) const;
+    LedStreamer& Streamer();
+    // Queues a commit without leaving direct mode
+    std::future<bool> SubmitCommit(uint8_t channel, uint8_t effect, uint8_t speed, uint8_t direction, uint8_t brightness,
+                                   std::chrono::milliseconds settle);
+    std::vector<uint8_t> BuildStartAction(uint8_t channel, uint8_t numFans) const;
+    std::vector<uint8_t> BuildColorData(uint8_t channel, uint8_t numLeds, const uint8_t* ledData) const;
 };
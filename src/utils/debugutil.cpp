@@ -12,21 +12,33 @@
 
 namespace DebugUtil {
 
-bool isDebugEnabled() {
+std::atomic<uint32_t> g_flags{FlagUnloaded};
+
+uint32_t loadSettings() {
     QSettings settings("LianLi", "LConnect3");
-    return settings.value("Debug/Enabled", false).toBool();
+    uint32_t value = 0;
+    if (settings.value("Debug/Enabled", false).toBool()) value |= FlagEnabled;
+    if (settings.value("Debug/FanSpeeds", false).toBool()) value |= FlagFanSpeeds;
+    if (settings.value("Debug/FanLights", false).toBool()) value |= FlagFanLights;
+    g_flags.store(value, std::memory_order_relaxed);
+    return value;
 }
 
-bool isDebugCategoryEnabled(const char* category) {
-    QSettings settings("LianLi", "LConnect3");
-    // First check if debug mode is enabled
-    if (!settings.value("Debug/Enabled", false).toBool()) {
-        return false;
+static void setFlag(uint32_t flag, bool enabled) {
+    flags(); // make sure the other flags are loaded first
+    if (enabled) {
+        g_flags.fetch_or(flag, std::memory_order_relaxed);
+    } else {
+        g_flags.fetch_and(~flag, std::memory_order_relaxed);
     }
-    // Then check if the specific category is enabled
-    QString categoryKey = QString("Debug/%1").arg(category);
-    return settings.value(categoryKey, false).toBool();
 }
 
-} // namespace DebugUtil
+void setDebugEnabled(bool enabled) {
+    setFlag(FlagEnabled, enabled);
+}
 
+void setCategoryEnabled(uint32_t flag, bool enabled) {
+    setFlag(flag, enabled);
+}
+
+} // namespace DebugUtil
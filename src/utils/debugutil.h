@@ -2,7 +2,7 @@
 ||| debugutil.h                                             |
 |||                                                         |
 |||   Debug utility for conditional logging                |
-|||   Checks QSettings to determine if debug mode is on    |
+|||   Flags come from QSettings, cached in one atomic      |
 |||                                                         |
 |||   This file is part of the LL-Connect 3 project        |
 |||   SPDX-License-Identifier: GPL-2.0-or-later            |
@@ -10,41 +10,83 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <cstdio>
-#include <cstdarg>
 
 namespace DebugUtil {
 
-// Check if debug mode is enabled (implemented in debugutil.cpp)
-bool isDebugEnabled();
+// One bit per flag in Debug/ of the settings
+enum Flag : uint32_t {
+    FlagEnabled   = 1u << 0,   // Debug/Enabled, the master switch
+    FlagFanSpeeds = 1u << 1,   // Debug/FanSpeeds
+    FlagFanLights = 1u << 2,   // Debug/FanLights
+    FlagUnloaded  = 1u << 31,  // settings not read yet
+};
 
-// Check if a specific debug category is enabled
-bool isDebugCategoryEnabled(const char* category);
+// Category name -> flag, at compile time for the logging macros; 0 if unknown
+constexpr bool sameName(const char* a, const char* b) {
+    return *a == *b && (*a == '\0' || sameName(a + 1, b + 1));
+}
 
-// Debug printf (only prints if debug mode is enabled)
-template<typename... Args>
-inline void debugPrintf(const char* format, Args... args) {
-    if (isDebugEnabled()) {
-        if constexpr (sizeof...(args) > 0) {
-            std::printf(format, args...);
-        } else {
-            std::fputs(format, stdout);
-        }
-    }
+constexpr uint32_t categoryFlag(const char* category) {
+    return sameName(category, "FanSpeeds") ? static_cast<uint32_t>(FlagFanSpeeds)
+         : sameName(category, "FanLights") ? static_cast<uint32_t>(FlagFanLights)
+         : 0u;
+}
+
+extern std::atomic<uint32_t> g_flags;
+
+// Reads the flags from QSettings (implemented in debugutil.cpp); done on
+// first use, again only when SettingsPage reports a change
+uint32_t loadSettings();
+void setDebugEnabled(bool enabled);
+void setCategoryEnabled(uint32_t flag, bool enabled);
+
+inline uint32_t flags() {
+    uint32_t value = g_flags.load(std::memory_order_relaxed);
+    return (value & FlagUnloaded) ? loadSettings() : value;
 }
 
-// Category-specific debug printf (for printf-style format strings)
-inline void debugPrintfCategory(const char* category, const char* format, ...) {
-    if (isDebugCategoryEnabled(category)) {
-        va_list args;
-        va_start(args, format);
-        vprintf(format, args);
-        va_end(args);
+// Check if debug mode is enabled
+inline bool isDebugEnabled() {
+    return flags() & FlagEnabled;
+}
+
+// Check if a specific debug category is enabled (the master switch too)
+inline bool isCategoryEnabled(uint32_t flag) {
+    uint32_t value = flags();
+    return (value & FlagEnabled) && (value & flag);
+}
+
+inline bool isDebugCategoryEnabled(const char* category) {
+    return isCategoryEnabled(categoryFlag(category));
+}
+
+// Unconditional printf; the macros check the flags first
+template<typename... Args>
+inline void printfAlways(const char* format, Args... args) {
+    if constexpr (sizeof...(args) > 0) {
+        std::printf(format, args...);
+    } else {
+        std::fputs(format, stdout);
     }
 }
 
 } // namespace DebugUtil
 
-// Convenience macros
-#define DEBUG_PRINTF(...) DebugUtil::debugPrintf(__VA_ARGS__)
-#define DEBUG_PRINTF_CATEGORY(category, ...) DebugUtil::debugPrintfCategory(category, __VA_ARGS__)
+// Convenience macros. Arguments are only evaluated when the flag is set; a
+// disabled flag costs one relaxed load. Building with LLCONNECT_NO_DEBUG_LOG
+// compiles them out entirely.
+#ifdef LLCONNECT_NO_DEBUG_LOG
+#define DEBUG_PRINTF(...) do {} while (0)
+#define DEBUG_PRINTF_CATEGORY(category, ...) do {} while (0)
+#else
+#define DEBUG_PRINTF(...) \
+    do { if (DebugUtil::isDebugEnabled()) DebugUtil::printfAlways(__VA_ARGS__); } while (0)
+#define DEBUG_PRINTF_CATEGORY(category, ...) \
+    do { \
+        static_assert(DebugUtil::categoryFlag(category) != 0, "unknown debug category"); \
+        if (DebugUtil::isCategoryEnabled(DebugUtil::categoryFlag(category))) DebugUtil::printfAlways(__VA_ARGS__); \
+    } while (0)
+#endif
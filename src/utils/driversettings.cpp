@@ -0,0 +1,41 @@
+/*---------------------------------------------------------*\
+||| driversettings.cpp                                      |
+|||                                                         |
+|||   Saved kernel driver options implementation           |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "driversettings.h"
+#include "usb/kernel_port_interface.h"
+#include <QSettings>
+#include <QDebug>
+
+namespace DriverSettings {
+
+bool fanPortEnabled(int port)
+{
+    QSettings settings("LianLi", "LConnect3");
+    return settings.value(QString("FanConfig/Port%1").arg(port), true).toBool();
+}
+
+bool kernelLoggingEnabled()
+{
+    QSettings settings("LianLi", "LConnect3");
+    return settings.value("Debug/Enabled", false).toBool() && settings.value("Debug/KernelLogs", false).toBool();
+}
+
+void applySaved()
+{
+    KernelPortInterface &driver = KernelPortInterface::Instance();
+    for (int port = 1; port <= KernelPortInterface::kPortCount; ++port) {
+        if (!driver.SetFanConfig(port, fanPortEnabled(port))) {
+            qDebug() << "Fan port configuration not applied: kernel driver not available";
+            return;
+        }
+    }
+    driver.SetLoggingEnabled(kernelLoggingEnabled());
+}
+
+} // namespace DriverSettings
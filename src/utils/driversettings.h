@@ -0,0 +1,22 @@
+/*---------------------------------------------------------*\
+||| driversettings.h                                        |
+|||                                                         |
+|||   Saved kernel driver options, applied at startup      |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+namespace DriverSettings {
+
+// Which fan ports are in use (FanConfig/PortN) and the driver's own
+// logging (Debug/KernelLogs, only with Debug/Enabled). The driver forgets
+// both when it is reloaded, so MainWindow and llconnectd push the saved
+// values once at startup; SettingsPage only edits them.
+bool fanPortEnabled(int port);
+bool kernelLoggingEnabled();
+void applySaved();
+
+} // namespace DriverSettings
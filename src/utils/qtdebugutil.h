@@ -14,7 +14,7 @@
 
 namespace DebugUtil {
 
-// Debug qDebug (only prints if debug mode is enabled)
+// Writes all arguments to one qDebug() line; the macros check the flags first
 // Helper to expand arguments
 inline void debugLog_impl(QDebug dbg) {
     // Base case: do nothing
@@ -27,27 +27,25 @@ inline void debugLog_impl(QDebug dbg, T&& value, Args&&... args) {
 }
 
 template<typename... Args>
-inline void debugLog(Args&&... args) {
-    if (isDebugEnabled()) {
-        QDebug dbg = qDebug();
-        debugLog_impl(dbg, std::forward<Args>(args)...);
-    }
-}
-
-// Category-specific debug logging
-template<typename... Args>
-inline void debugLogCategory(const char* category, Args&&... args) {
-    if (isDebugCategoryEnabled(category)) {
-        QDebug dbg = qDebug();
-        debugLog_impl(dbg, std::forward<Args>(args)...);
-    }
+inline void debugLogAlways(Args&&... args) {
+    QDebug dbg = qDebug();
+    debugLog_impl(dbg, std::forward<Args>(args)...);
 }
 
 } // namespace DebugUtil
 
+#ifdef LLCONNECT_NO_DEBUG_LOG
+#define DEBUG_LOG(...) do {} while (0)
+#define DEBUG_LOG_CATEGORY(category, ...) do {} while (0)
+#else
 // Convenience macro for Qt code
-#define DEBUG_LOG(...) DebugUtil::debugLog(__VA_ARGS__)
+#define DEBUG_LOG(...) \
+    do { if (DebugUtil::isDebugEnabled()) DebugUtil::debugLogAlways(__VA_ARGS__); } while (0)
 
 // Convenience macro for category-specific debug logging
-#define DEBUG_LOG_CATEGORY(category, ...) DebugUtil::debugLogCategory(category, __VA_ARGS__)
-
+#define DEBUG_LOG_CATEGORY(category, ...) \
+    do { \
+        static_assert(DebugUtil::categoryFlag(category) != 0, "unknown debug category"); \
+        if (DebugUtil::isCategoryEnabled(DebugUtil::categoryFlag(category))) DebugUtil::debugLogAlways(__VA_ARGS__); \
+    } while (0)
+#endif
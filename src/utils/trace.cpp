@@ -0,0 +1,181 @@
+/*---------------------------------------------------------*\
+||| trace.cpp                                               |
+|||                                                         |
+|||   Binary event trace implementation                    |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trace {
+
+std::atomic<bool> g_enabled{false};
+
+namespace {
+
+constexpr int kWords = sizeof(Event) / sizeof(uint64_t);
+
+// One thread's events. Only the owning thread writes; save() reads from
+// any thread. Slots are kept in relaxed atomic words like SensorRing.
+// Before touching a slot the writer publishes the event it is about to
+// write in `claimed` and issues a release fence; a reader that copied a
+// word of that write and then fences with acquire is guaranteed to see the
+// claim, so every slot the writer has reached since is dropped as torn.
+struct ThreadBuffer {
+    static constexpr uint64_t kCapacity = 1 << 14;   // 512 KiB per thread
+
+    std::atomic<uint64_t> head{0};                    // events ever recorded
+    std::atomic<uint64_t> claimed{0};                 // events begun, head + 1 while writing
+    std::atomic<uint64_t> slots[kCapacity][kWords];
+    uint32_t thread = 0;
+    char name[sizeof(ThreadHeader::name)] = {};
+};
+
+std::mutex g_mutex;                                   // the buffer list, names
+std::vector<std::unique_ptr<ThreadBuffer>> g_buffers;
+std::atomic<uint64_t> g_startTime{0};
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+thread_local char t_name[sizeof(ThreadHeader::name)] = {};
+
+// Buffers outlive their threads so a trace still holds the events of a
+// thread that has already exited
+ThreadBuffer* threadBuffer() {
+    if (!t_buffer) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(g_mutex);
+        buffer->thread = static_cast<uint32_t>(g_buffers.size());
+        std::memcpy(buffer->name, t_name, sizeof(buffer->name));
+        t_buffer = buffer.get();
+        g_buffers.push_back(std::move(buffer));
+    }
+    return t_buffer;
+}
+
+// Copies the events still in the ring, oldest first
+uint64_t snapshot(const ThreadBuffer& buffer, std::vector<Event>& events) {
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    const uint64_t first = head > ThreadBuffer::kCapacity ? head - ThreadBuffer::kCapacity : 0;
+
+    std::vector<uint64_t> words((head - first) * kWords);
+    for (uint64_t i = first; i < head; ++i) {
+        const auto& slot = buffer.slots[i % ThreadBuffer::kCapacity];
+        for (int w = 0; w < kWords; ++w) {
+            words[(i - first) * kWords + w] = slot[w].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Every slot the writer has claimed since, including one it is in the
+    // middle of, may have been overwritten under us
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimed = buffer.claimed.load(std::memory_order_relaxed);
+    const uint64_t valid = claimed > ThreadBuffer::kCapacity ? claimed - ThreadBuffer::kCapacity : 0;
+    const uint64_t keep = std::max(first, valid);
+
+    events.resize(head > keep ? head - keep : 0);
+    if (!events.empty()) {
+        std::memcpy(events.data(), words.data() + (keep - first) * kWords, events.size() * sizeof(Event));
+    }
+    return keep;
+}
+
+} // namespace
+
+void start() {
+    uint64_t unset = 0;
+    g_startTime.compare_exchange_strong(unset, now());
+    g_enabled.store(true, std::memory_order_relaxed);
+}
+
+void stop() {
+    g_enabled.store(false, std::memory_order_relaxed);
+}
+
+void setThreadName(const char* name) {
+    std::strncpy(t_name, name, sizeof(t_name) - 1);
+    if (t_buffer) {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        std::memcpy(t_buffer->name, t_name, sizeof(t_name));
+    }
+}
+
+void record(EventType type, uint8_t channel, uint8_t flags, uint32_t arg,
+            float v0, float v1, float v2, float v3) {
+    Event event;
+    event.time = now();
+    event.type = static_cast<uint16_t>(type);
+    event.channel = channel;
+    event.flags = flags;
+    event.arg = arg;
+    event.values[0] = v0;
+    event.values[1] = v1;
+    event.values[2] = v2;
+    event.values[3] = v3;
+
+    uint64_t words[kWords];
+    std::memcpy(words, &event, sizeof(event));
+
+    ThreadBuffer* buffer = threadBuffer();
+    const uint64_t index = buffer->head.load(std::memory_order_relaxed);
+    auto& slot = buffer->slots[index % ThreadBuffer::kCapacity];
+
+    // Claim the slot before overwriting it, see ThreadBuffer
+    buffer->claimed.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int w = 0; w < kWords; ++w) {
+        slot[w].store(words[w], std::memory_order_relaxed);
+    }
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+bool save(const std::string& path, std::string* error) {
+    auto fail = [&](const char* what) {
+        if (error) *error = std::string(what) + " " + path + ": " + std::strerror(errno);
+        return false;
+    };
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return fail("cannot create");
+    }
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.eventSize = sizeof(Event);
+    header.startTime = g_startTime.load(std::memory_order_relaxed);
+    header.threadCount = static_cast<uint32_t>(g_buffers.size());
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+    std::vector<Event> events;
+    for (const auto& buffer : g_buffers) {
+        if (!ok) break;
+        const uint64_t first = snapshot(*buffer, events);
+
+        ThreadHeader thread{};
+        thread.thread = buffer->thread;
+        std::memcpy(thread.name, buffer->name, sizeof(thread.name));
+        thread.eventCount = events.size();
+        thread.dropped = first;
+        ok = std::fwrite(&thread, sizeof(thread), 1, file) == 1
+          && std::fwrite(events.data(), sizeof(Event), events.size(), file) == events.size();
+    }
+
+    if (std::fclose(file) != 0 || !ok) {
+        return fail("cannot write");
+    }
+    return true;
+}
+
+} // namespace Trace
@@ -0,0 +1,118 @@
+/*---------------------------------------------------------*\
+||| trace.h                                                 |
+|||                                                         |
+|||   Binary event trace for HID and control-loop timing   |
+|||   Fixed-size events in per-thread lock-free rings      |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Off unless LLCONNECT_TRACE=<file> is set when the app starts; the trace is
+// written to that file on exit and turned into JSON or a Chrome trace
+// (chrome://tracing, Perfetto) with tracedump.
+//
+// Recording formats nothing: an event is 32 bytes copied into the calling
+// thread's ring, which overwrites its oldest events when full. A disabled
+// trace costs one relaxed load per TRACE_EVENT.
+namespace Trace {
+
+enum class EventType : uint16_t {
+    // One hidraw report written by the HID I/O thread.
+    //   channel  HID channel
+    //   arg      opcode (report byte 1) | command kind << 8 | report bytes << 16
+    //   flags    FlagFailed
+    //   values   queue latency (µs, submit to write start), write time (µs),
+    //            index of the report within its command
+    HidWrite = 1,
+
+    // One port in one FanControlLoop step.
+    //   channel  port 1-4
+    //   arg      duty of the port's output stage (percent)
+    //   flags    FlagRequested: the strategy moved the target
+    //            FlagWritten: the output stage let the duty through
+    //   values   Tf (°C), dT/dt (°C/s), strategy target RPM, gated RPM
+    ControlTick = 2,
+
+    // One sensor refresh of the fan control engine.
+    //   channel  0: values = cpu, gpu, nvme, liquid (°C, NaN if missing)
+    //            4 + i: hwmon channel i of the port expressions in values[0]
+    //   flags    FlagSimulated: no CPU sensor, the value is simulated
+    SensorSample = 3,
+};
+
+enum : uint8_t {
+    FlagFailed    = 1 << 0,
+    FlagRequested = 1 << 0,
+    FlagWritten   = 1 << 1,
+    FlagSimulated = 1 << 0,
+};
+
+struct Event {
+    uint64_t time;       // ns on the steady clock, when recorded
+    uint16_t type;       // EventType
+    uint8_t channel;
+    uint8_t flags;
+    uint32_t arg;
+    float values[4];
+};
+static_assert(sizeof(Event) == 32, "trace events are 32 bytes on disk");
+
+// File layout (host byte order):
+//   FileHeader, then per recording thread a ThreadHeader followed by its
+//   events, oldest first
+struct FileHeader {
+    char magic[8];           // "LLTRACE"
+    uint32_t version;        // kVersion
+    uint32_t eventSize;      // sizeof(Event)
+    uint64_t startTime;      // steady clock ns when tracing started
+    uint32_t threadCount;
+    uint32_t reserved;
+};
+
+struct ThreadHeader {
+    uint32_t thread;         // 0-based, in order of the first event
+    char name[20];           // see setThreadName()
+    uint64_t eventCount;
+    uint64_t dropped;        // overwritten before the trace was saved
+};
+
+constexpr char kMagic[8] = "LLTRACE";
+constexpr uint32_t kVersion = 1;
+
+extern std::atomic<bool> g_enabled;
+
+inline bool isEnabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+inline uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void start();
+void stop();
+
+// Writes what every thread has recorded so far; tracing may continue
+bool save(const std::string& path, std::string* error = nullptr);
+
+// Names the calling thread's events ("hid-io", "fan-control", ...)
+void setThreadName(const char* name);
+
+// Appends an event to the calling thread's ring. Use TRACE_EVENT, which
+// skips the call (and its arguments) while tracing is off.
+void record(EventType type, uint8_t channel, uint8_t flags, uint32_t arg,
+            float v0 = 0.0f, float v1 = 0.0f, float v2 = 0.0f, float v3 = 0.0f);
+
+} // namespace Trace
+
+#define TRACE_EVENT(...) \
+    do { if (Trace::isEnabled()) Trace::record(__VA_ARGS__); } while (0)
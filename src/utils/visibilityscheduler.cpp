@@ -0,0 +1,115 @@
+/*---------------------------------------------------------*\
+||| visibilityscheduler.cpp                                 |
+|||                                                         |
+|||   Widget and window visibility tracking                |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "visibilityscheduler.h"
+#include <QCoreApplication>
+#include <QEvent>
+#include <QWidget>
+#include <algorithm>
+
+VisibilityScheduler *VisibilityScheduler::instance()
+{
+    static VisibilityScheduler *scheduler = new VisibilityScheduler(QCoreApplication::instance());
+    return scheduler;
+}
+
+VisibilityScheduler::VisibilityScheduler(QObject *parent)
+    : QObject(parent)
+    , m_refreshing(false)
+    , m_refreshAgain(false)
+{
+}
+
+bool VisibilityScheduler::isOnScreen(const QWidget *widget)
+{
+    return widget && widget->isVisible() && !widget->window()->isMinimized();
+}
+
+void VisibilityScheduler::watch(QWidget *widget, QObject *context, std::function<void(bool)> onChange)
+{
+    if (!widget || !context || !onChange) {
+        return;
+    }
+
+    // The widget itself for page switches; its window (once it has its
+    // final one, see eventFilter) for minimize and hide-to-tray
+    filter(widget);
+    filter(widget->window());
+
+    const bool onScreen = isOnScreen(widget);
+    m_watches.append({ widget, context, onChange, onScreen });
+    onChange(onScreen);
+}
+
+void VisibilityScheduler::filter(QObject *object)
+{
+    for (const QPointer<QObject> &filtered : std::as_const(m_filtered)) {
+        if (filtered == object) {
+            return;
+        }
+    }
+    object->installEventFilter(this);
+    m_filtered.append(object);
+}
+
+bool VisibilityScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::Show:
+        // A page is created before it is put into the main window
+        if (QWidget *widget = qobject_cast<QWidget *>(watched)) {
+            filter(widget->window());
+        }
+        refresh();
+        break;
+    case QEvent::Hide:
+    case QEvent::WindowStateChange:
+        refresh();
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void VisibilityScheduler::refresh()
+{
+    // A callback that shows or hides a widget lands here again; go round
+    // once more instead of recursing
+    if (m_refreshing) {
+        m_refreshAgain = true;
+        return;
+    }
+    m_refreshing = true;
+
+    m_filtered.removeAll(nullptr);
+    m_watches.erase(std::remove_if(m_watches.begin(), m_watches.end(), [](const Watch &watch) {
+        return !watch.widget || !watch.context;
+    }), m_watches.end());
+
+    do {
+        m_refreshAgain = false;
+
+        // Callbacks may add watches; index rather than iterate
+        for (int i = 0; i < m_watches.size(); ++i) {
+            if (!m_watches[i].widget || !m_watches[i].context) {
+                continue;
+            }
+            const bool onScreen = isOnScreen(m_watches[i].widget);
+            if (onScreen == m_watches[i].onScreen) {
+                continue;
+            }
+            m_watches[i].onScreen = onScreen;
+            std::function<void(bool)> onChange = m_watches[i].onChange;
+            onChange(onScreen);
+        }
+    } while (m_refreshAgain);
+
+    m_refreshing = false;
+}
@@ -0,0 +1,61 @@
+/*---------------------------------------------------------*\
+||| visibilityscheduler.h                                   |
+|||                                                         |
+|||   Runs UI-only timers and sampling while on screen     |
+|||   Tracks widget and window visibility in one place     |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <functional>
+
+class QWidget;
+
+// Knows which of the registered widgets the user can actually see: shown,
+// on the current page, in a window that is neither hidden nor minimized.
+// Whatever only feeds the UI (page animations, the System Info sensors)
+// registers here and is told when that changes, instead of every widget
+// watching its own show/hide and window state. Fan control does not go
+// through here; it runs regardless.
+//
+// GUI thread only.
+class VisibilityScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    static VisibilityScheduler *instance();
+
+    // Calls onChange(onScreen) right away and then whenever the widget
+    // appears or disappears; stops once widget or context is destroyed
+    void watch(QWidget *widget, QObject *context, std::function<void(bool)> onChange);
+
+    static bool isOnScreen(const QWidget *widget);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    struct Watch {
+        QPointer<QWidget> widget;
+        QPointer<QObject> context;
+        std::function<void(bool)> onChange;
+        bool onScreen;
+    };
+
+    explicit VisibilityScheduler(QObject *parent = nullptr);
+
+    void filter(QObject *object);
+    void refresh();
+
+    QVector<Watch> m_watches;
+    QVector<QPointer<QObject>> m_filtered;
+    bool m_refreshing;
+    bool m_refreshAgain;
+};
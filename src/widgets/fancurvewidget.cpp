@@ -1,4 +1,5 @@
 #include "fancurvewidget.h"
+#include "control/sensorring.h"
 #include <QPainter>
 #include <QPainterPath>
 #include <QMouseEvent>
@@ -11,6 +12,8 @@ FanCurveWidget::FanCurveWidget(QWidget *parent)
     , m_profile("Quiet")
     , m_currentTemperature(25)
     , m_currentRPM(420)
+    , m_ring(nullptr)
+    , m_ringPort(1)
     , m_marginLeft(50)
     , m_marginRight(20)
     , m_marginTop(20)
@@ -20,6 +23,7 @@ FanCurveWidget::FanCurveWidget(QWidget *parent)
     , m_rpmMin(0)
     , m_rpmMax(2100)
     , m_displayRpmMax(2100)
+    , m_interpolation(FanCurve::Interpolation::Linear)
     , m_dragging(false)
     , m_draggedPoint(-1)
     , m_graphEnabled(true)
@@ -61,6 +65,13 @@ void FanCurveWidget::setCurrentRPM(int rpm)
     update();
 }
 
+void FanCurveWidget::setSensorRing(const SensorRing *ring, int port)
+{
+    m_ring = ring;
+    m_ringPort = qBound(1, port, 4);
+    update();
+}
+
 void FanCurveWidget::setGraphEnabled(bool enabled)
 {
     m_graphEnabled = enabled;
@@ -70,9 +81,22 @@ void FanCurveWidget::setGraphEnabled(bool enabled)
 void FanCurveWidget::setCustomCurve(const QVector<QPointF> &points)
 {
     m_curvePoints = points;
+    compileCurve();
     update();
 }
 
+void FanCurveWidget::setInterpolation(FanCurve::Interpolation interpolation)
+{
+    m_interpolation = interpolation;
+    compileCurve();
+    update();
+}
+
+void FanCurveWidget::compileCurve()
+{
+    m_curve = FanCurve(m_curvePoints, m_interpolation);
+}
+
 void FanCurveWidget::setupCurveData()
 {
     m_curvePoints.clear();
@@ -123,12 +147,21 @@ void FanCurveWidget::setupCurveData()
         m_curvePoints << QPointF(90, 2100);
         m_curvePoints << QPointF(100, 2100);
     }
+    
+    compileCurve();
 }
 
 void FanCurveWidget::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event)
     
+    // Newest control loop step for the port on display
+    SensorSample sample;
+    if (m_ring && m_ring->latest(sample)) {
+        m_currentTemperature = qRound(sample.portTemperature[m_ringPort - 1]);
+        m_currentRPM = sample.rpm[m_ringPort - 1];
+    }
+    
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
     
@@ -155,6 +188,9 @@ void FanCurveWidget::paintEvent(QPaintEvent *event)
     // Draw data points
     drawDataPoints(painter);
     
+    // Draw where the port has been recently
+    drawHistory(painter);
+    
     // Draw current temperature line
     drawCurrentLine(painter);
     
@@ -254,12 +290,25 @@ void FanCurveWidget::drawCurve(QPainter &painter)
     
     // Draw curve line
     QPainterPath path;
-    QPointF firstPoint = dataToPixel(m_curvePoints[0]);
-    path.moveTo(firstPoint);
-    
-    for (int i = 1; i < m_curvePoints.size(); ++i) {
-        QPointF point = dataToPixel(m_curvePoints[i]);
-        path.lineTo(point);
+    if (m_interpolation == FanCurve::Interpolation::Linear) {
+        QPointF firstPoint = dataToPixel(m_curvePoints[0]);
+        path.moveTo(firstPoint);
+        
+        for (int i = 1; i < m_curvePoints.size(); ++i) {
+            QPointF point = dataToPixel(m_curvePoints[i]);
+            path.lineTo(point);
+        }
+    } else {
+        // Trace the compiled table so the line is exactly what the fans follow
+        for (int i = 0; i < FanCurve::kTableSize; ++i) {
+            double temp = FanCurve::kMinTemperature + double(i) / FanCurve::kStepsPerDegree;
+            QPointF point = dataToPixel(QPointF(temp, m_curve.rpmAt(temp)));
+            if (i == 0) {
+                path.moveTo(point);
+            } else {
+                path.lineTo(point);
+            }
+        }
     }
     
     painter.drawPath(path);
@@ -296,6 +345,28 @@ QColor FanCurveWidget::getTemperatureColor(int temperature)
     }
 }
 
+void FanCurveWidget::drawHistory(QPainter &painter)
+{
+    if (!m_ring) {
+        return;
+    }
+    
+    // Temperature the port followed against the RPM it was given; where
+    // this leaves the curve the loop was slewing or holding
+    const int index = m_ringPort - 1;
+    QPolygonF trail;
+    m_ring->forEachInWindow(kHistoryWindow, [&](const SensorSample &sample) {
+        trail.append(dataToPixel(QPointF(sample.portTemperature[index], sample.rpm[index])));
+    });
+    if (trail.size() < 2) {
+        return;
+    }
+    
+    painter.setPen(QPen(QColor(255, 165, 0, 110), 2));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawPolyline(trail);
+}
+
 void FanCurveWidget::drawCurrentLine(QPainter &painter)
 {
     QRect graphRect = rect().adjusted(m_marginLeft, m_marginTop, -m_marginRight, -m_marginBottom);
@@ -311,7 +382,7 @@ void FanCurveWidget::drawCurrentLine(QPainter &painter)
     painter.drawLine(x, graphRect.top(), x, graphRect.bottom());
     
     // Calculate the RPM that should be on the curve at this temperature
-    int curveRPM = calculateRPMForTemperature(m_currentTemperature);
+    int curveRPM = m_curve.rpmAt(m_currentTemperature);
     
     // Draw a larger circle at the intersection with the curve (temperature ball)
     QPointF curvePoint = QPointF(x, graphRect.bottom() - (curveRPM - m_rpmMin) / (m_rpmMax - m_rpmMin) * graphRect.height());
@@ -382,6 +453,7 @@ void FanCurveWidget::mouseMoveEvent(QMouseEvent *event)
         dataPoint.setY(qMax(minRPM, qMin((double)m_rpmMax, dataPoint.y())));
         
         m_curvePoints[m_draggedPoint] = dataPoint;
+        compileCurve();
         update();
     }
 }
@@ -396,33 +468,3 @@ void FanCurveWidget::mouseReleaseEvent(QMouseEvent *event)
     m_dragging = false;
     m_draggedPoint = -1;
 }
-
-int FanCurveWidget::calculateRPMForTemperature(int temperature)
-{
-    // Calculate RPM based on the current curve profile
-    if (m_curvePoints.size() < 2) {
-        return 0;
-    }
-    
-    // Find the two points that bracket the temperature
-    for (int i = 0; i < m_curvePoints.size() - 1; ++i) {
-        double temp1 = m_curvePoints[i].x();
-        double rpm1 = m_curvePoints[i].y();
-        double temp2 = m_curvePoints[i + 1].x();
-        double rpm2 = m_curvePoints[i + 1].y();
-        
-        if (temperature >= temp1 && temperature <= temp2) {
-            // Linear interpolation between the two points
-            double ratio = (temperature - temp1) / (temp2 - temp1);
-            double rpm = rpm1 + ratio * (rpm2 - rpm1);
-            return static_cast<int>(rpm);
-        }
-    }
-    
-    // If temperature is outside the curve range, use the closest point
-    if (temperature <= m_curvePoints.first().x()) {
-        return static_cast<int>(m_curvePoints.first().y());
-    } else {
-        return static_cast<int>(m_curvePoints.last().y());
-    }
-}
@@ -6,21 +6,33 @@
 #include <QMouseEvent>
 #include <QVector>
 #include <QPointF>
+#include "control/fancurve.h"
+
+class SensorRing;
 
 class FanCurveWidget : public QWidget
 {
     Q_OBJECT
 
 public:
+    // How much of the control loop's history is drawn behind the current point (ms)
+    static constexpr qint64 kHistoryWindow = 30000;
+
     explicit FanCurveWidget(QWidget *parent = nullptr);
     
     void setProfile(const QString &profile);
     void setCurrentTemperature(int temperature);
     void setCurrentRPM(int rpm);
+    // Takes the current point and its recent history of `port` straight
+    // from the control loop's ring on every paint; nullptr goes back to
+    // setCurrentTemperature()/setCurrentRPM()
+    void setSensorRing(const SensorRing *ring, int port);
     void setGraphEnabled(bool enabled);
     void setCustomCurve(const QVector<QPointF> &points);
+    void setInterpolation(FanCurve::Interpolation interpolation);
     void setFanSize(int maxRPM); // Set max RPM based on fan size (2100 for 120mm, 1600 for 140mm)
     QVector<QPointF> getCurvePoints() const { return m_curvePoints; }
+    const FanCurve &curve() const { return m_curve; }
 
 signals:
     void curvePointsChanged(const QVector<QPointF> &points);
@@ -37,15 +49,18 @@ private:
     void drawAxes(QPainter &painter);
     void drawCurve(QPainter &painter);
     void drawDataPoints(QPainter &painter);
+    void drawHistory(QPainter &painter);
     void drawCurrentLine(QPainter &painter);
     QColor getTemperatureColor(int temperature);
     QPointF dataToPixel(const QPointF &dataPoint);
     QPointF pixelToData(const QPointF &pixelPoint);
-    int calculateRPMForTemperature(int temperature);
+    void compileCurve();
     
     QString m_profile;
     int m_currentTemperature;
     int m_currentRPM;
+    const SensorRing *m_ring;
+    int m_ringPort;
     
     // Graph dimensions and margins
     int m_marginLeft;
@@ -58,8 +73,10 @@ private:
     double m_rpmMin, m_rpmMax;
     double m_displayRpmMax; // Max RPM to display on labels (1600 for 140mm, 2100 for 120mm)
     
-    // Curve data points (temperature, rpm)
+    // Curve data points (temperature, rpm) and the table compiled from them
     QVector<QPointF> m_curvePoints;
+    FanCurve::Interpolation m_interpolation;
+    FanCurve m_curve;
     
     // Interactive editing
     bool m_dragging;
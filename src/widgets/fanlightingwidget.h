@@ -6,6 +6,8 @@
 #include <QPainter>
 #include <QColor>
 #include <QString>
+#include <QElapsedTimer>
+#include "lighting/lightingeffect.h"
 
 class FanLightingWidget : public QWidget
 {
@@ -30,23 +32,9 @@ private slots:
 
 private:
     void drawFan(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawRainbowEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawRainbowMorphEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawStaticColorEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawBreathingEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawMeteorEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawRunwayEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawGrooveEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawMixingEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawNeonEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawStackEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawStaggeredEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawTideEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawTunnelEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawVoiceEffect(QPainter &painter, const QRect &rect, int fanIndex);
+    void updateEffectParameters();
     
-    QColor getRainbowColor(int position, int totalPositions) const;
-    QColor applyBrightness(const QColor &color, int brightnessPercent) const;
+    static SLInfinityColor toLedColor(const QColor &color);
     
     QString m_effect;
     int m_speed;
@@ -56,9 +44,11 @@ private:
     QColor m_portColors[4]; // Colors for each port
     bool m_portEnabled[4];  // Which ports have fans connected
     
+    // Same effect code that drives the fans in direct mode
+    LightingEffect m_lightingEffect;
+    
     QTimer *m_animationTimer;
-    int m_animationFrame;
-    double m_timeOffset;
+    QElapsedTimer m_clock;
 };
 
 #endif // FANLIGHTINGWIDGET_H